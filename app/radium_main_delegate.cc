@@ -8,6 +8,7 @@
 #include "base/features.h"
 #include "base/i18n/rtl.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/path_service.h"
 #include "base/process/memory.h"
@@ -16,6 +17,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/thread_pool/thread_pool_instance.h"
 #include "base/threading/hang_watcher.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/crash/core/common/crash_key.h"
 #include "components/memory_system/initializer.h"
@@ -56,7 +58,10 @@
 #endif
 
 #if BUILDFLAG(IS_LINUX)
+#include "base/files/file.h"
 #include "base/nix/scoped_xdg_activation_token_injector.h"
+#include "base/posix/global_descriptors.h"
+#include "radium/common/radium_descriptors_linux.h"
 #include "ui/linux/display_server_utils.h"
 #endif
 
@@ -341,6 +346,36 @@ void OnResourceExhausted() {
 }
 #endif
 
+#if BUILDFLAG(IS_LINUX)
+// Adds the paks the browser opened for this process to the ResourceBundle, see
+// shared_resource_paks_linux.h. Returns false if there are none, e.g. in the
+// zygote, which opens them itself.
+bool AddSharedResourcePaks() {
+  auto* global_descriptors = base::GlobalDescriptors::GetInstance();
+  if (global_descriptors->MaybeGet(kRadiumResourcesPakDescriptor) == -1) {
+    return false;
+  }
+  static constexpr struct {
+    int descriptor;
+    ui::ResourceScaleFactor scale_factor;
+  } kSharedPaks[] = {
+      {kRadium100PercentPakDescriptor, ui::k100Percent},
+      {kRadium200PercentPakDescriptor, ui::k200Percent},
+      {kRadiumResourcesPakDescriptor, ui::kScaleFactorNone},
+  };
+  for (const auto& pak : kSharedPaks) {
+    // The browser only shares the paks it loaded itself.
+    const int pak_fd = global_descriptors->MaybeGet(pak.descriptor);
+    if (pak_fd != -1) {
+      ui::ResourceBundle::GetSharedInstance().AddDataPackFromFileRegion(
+          base::File(pak_fd), global_descriptors->GetRegion(pak.descriptor),
+          pak.scale_factor);
+    }
+  }
+  return true;
+}
+#endif  // BUILDFLAG(IS_LINUX)
+
 bool IsCanaryDev() {
   const auto channel = radium::GetChannel();
   return channel == version_info::Channel::CANARY ||
@@ -506,40 +541,53 @@ void RadiumMainDelegate::PreSandboxStartup() {
     base::i18n::SetICUDefaultLocale(locale);
     const std::string loaded_locale = locale;
 #else
+    const base::ElapsedTimer resource_bundle_timer;
     const std::string loaded_locale =
         ui::ResourceBundle::InitSharedInstanceWithLocale(
             locale, nullptr, ui::ResourceBundle::DO_NOT_LOAD_COMMON_RESOURCES);
 
-    auto GetResourcesPakFilePath = [](const std::string& pak_name) {
-      base::FilePath path;
-      if (base::PathService::Get(base::DIR_ASSETS, &path)) {
-        return path.AppendASCII(pak_name.c_str());
-      }
-      // Return just the name of the pak file.
+#if BUILDFLAG(IS_LINUX)
+    const bool added_shared_paks = AddSharedResourcePaks();
+#else
+    const bool added_shared_paks = false;
+#endif
+    if (!added_shared_paks) {
+      auto GetResourcesPakFilePath = [](const std::string& pak_name) {
+        base::FilePath path;
+        if (base::PathService::Get(base::DIR_ASSETS, &path)) {
+          return path.AppendASCII(pak_name.c_str());
+        }
+        // Return just the name of the pak file.
 #if BUILDFLAG(IS_WIN)
-      return base::FilePath(base::ASCIIToWide(pak_name));
+        return base::FilePath(base::ASCIIToWide(pak_name));
 #else
-      return base::FilePath(pak_name.c_str());
+        return base::FilePath(pak_name.c_str());
 #endif  // BUILDFLAG(IS_WIN)
-    };
+      };
+
+      // Always load the 1x data pack first as the 2x data pack contains both
+      // 1x and 2x images. The 1x data pack only has 1x images, thus passes in
+      // an accurate scale factor to gfx::ImageSkia::AddRepresentation.
+      if (ui::IsScaleFactorSupported(ui::k100Percent)) {
+        ui::ResourceBundle::GetSharedInstance().AddDataPackFromPath(
+            GetResourcesPakFilePath("radium_100_percent.pak"),
+            ui::k100Percent);
+      }
 
-    // Always load the 1x data pack first as the 2x data pack contains both 1x
-    // and 2x images. The 1x data pack only has 1x images, thus passes in an
-    // accurate scale factor to gfx::ImageSkia::AddRepresentation.
-    if (ui::IsScaleFactorSupported(ui::k100Percent)) {
-      ui::ResourceBundle::GetSharedInstance().AddDataPackFromPath(
-          GetResourcesPakFilePath("radium_100_percent.pak"), ui::k100Percent);
-    }
+      if (ui::IsScaleFactorSupported(ui::k200Percent)) {
+        ui::ResourceBundle::GetSharedInstance().AddOptionalDataPackFromPath(
+            GetResourcesPakFilePath("radium_200_percent.pak"),
+            ui::k200Percent);
+      }
 
-    if (ui::IsScaleFactorSupported(ui::k200Percent)) {
-      ui::ResourceBundle::GetSharedInstance().AddOptionalDataPackFromPath(
-          GetResourcesPakFilePath("radium_200_percent.pak"), ui::k200Percent);
+      base::FilePath resources_pack_path;
+      base::PathService::Get(radium::FILE_RESOURCES_PACK, &resources_pack_path);
+      ui::ResourceBundle::GetSharedInstance().AddDataPackFromPath(
+          resources_pack_path, ui::kScaleFactorNone);
     }
-
-    base::FilePath resources_pack_path;
-    base::PathService::Get(radium::FILE_RESOURCES_PACK, &resources_pack_path);
-    ui::ResourceBundle::GetSharedInstance().AddDataPackFromPath(
-        resources_pack_path, ui::kScaleFactorNone);
+    base::UmaHistogramMicrosecondsTimes(
+        "Radium.ChildProcess.ResourceBundleInitTime",
+        resource_bundle_timer.Elapsed());
 #endif  // BUILDFLAG(IS_ANDROID)
     CHECK(!loaded_locale.empty()) << "Locale could not be found for " << locale;
   }
@@ -4,13 +4,21 @@
 
 #include "radium/browser/badging/badge_manager.h"
 
+#include <algorithm>
+#include <string>
 #include <tuple>
 #include <utility>
 
+#include "base/functional/bind.h"
 #include "base/i18n/number_formatting.h"
+#include "base/json/values_util.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/default_clock.h"
 #include "build/build_config.h"
+#include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "components/ukm/app_source_url_recorder.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
@@ -20,6 +28,7 @@
 #include "radium/browser/badging/badge_manager_factory.h"
 #include "radium/browser/profiles/profile.h"
 #include "radium/browser/ui/browser.h"
+#include "radium/common/pref_names.h"
 #include "services/metrics/public/cpp/delegating_ukm_recorder.h"
 #include "services/metrics/public/cpp/ukm_builders.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -29,6 +38,8 @@
 #include "radium/browser/badging/badge_manager_delegate_mac.h"
 #elif BUILDFLAG(IS_WIN)
 #include "radium/browser/badging/badge_manager_delegate_win.h"
+#elif BUILDFLAG(IS_LINUX) && defined(USE_DBUS)
+#include "radium/browser/badging/badge_manager_delegate_linux.h"
 #endif
 
 // using web_app::WebAppProvider;
@@ -39,20 +50,13 @@ bool IsLastBadgingTimeWithin(base::TimeDelta time_frame,
                              const webapps::AppId& app_id,
                              const base::Clock* clock,
                              Profile* profile) {
-  // const base::Time last_badging_time =
-  //     WebAppProvider::GetForLocalAppsUnchecked(profile)
-  //         ->registrar_unsafe()
-  //         .GetAppLastBadgingTime(app_id);
-  // return clock->Now() < last_badging_time + time_frame;
-  return false;
+  const std::optional<base::Time> last_badging_time = base::ValueToTime(
+      profile->GetPrefs()->GetDict(prefs::kBadgingLastBadgingTimes).Find(
+          app_id));
+  return last_badging_time &&
+         clock->Now() < last_badging_time.value() + time_frame;
 }
 
-// // When web apps are disabled, there is no WebAppProvider.
-// web_app::WebAppSyncBridge* GetWebAppSyncBridgeForProfile(Profile* profile) {
-//   auto* provider = WebAppProvider::GetForLocalAppsUnchecked(profile);
-//   return provider ? &provider->sync_bridge_unsafe() : nullptr;
-// }
-
 }  // namespace
 
 namespace badging {
@@ -65,6 +69,8 @@ BadgeManager::BadgeManager(Profile* profile)
   SetDelegate(std::make_unique<BadgeManagerDelegateMac>(profile, this));
 #elif BUILDFLAG(IS_WIN)
   SetDelegate(std::make_unique<BadgeManagerDelegateWin>(profile, this));
+#elif BUILDFLAG(IS_LINUX) && defined(USE_DBUS)
+  SetDelegate(std::make_unique<BadgeManagerDelegateLinux>(profile, this));
 #endif
 }
 
@@ -72,6 +78,14 @@ BadgeManager::~BadgeManager() = default;
 
 void BadgeManager::SetDelegate(std::unique_ptr<BadgeManagerDelegate> delegate) {
   delegate_ = std::move(delegate);
+  // The new delegate has not been told about any badge yet.
+  reported_badged_apps_.clear();
+  for (const auto& [app_id, value] : badged_apps_) {
+    pending_apps_.insert(app_id);
+  }
+  if (!pending_apps_.empty()) {
+    FlushBadgeUpdates();
+  }
 }
 
 void BadgeManager::BindFrameReceiverIfAllowed(
@@ -174,28 +188,92 @@ const base::Clock* BadgeManager::SetClockForTesting(const base::Clock* clock) {
   return previous;
 }
 
+void BadgeManager::FlushBadgeUpdatesForTesting() {
+  flush_timer_.Stop();
+  FlushBadgeUpdates();
+}
+
 void BadgeManager::UpdateBadge(const webapps::AppId& app_id,
                                std::optional<BadgeValue> value) {
-  // web_app::WebAppSyncBridge* sync_bridge =
-  //     GetWebAppSyncBridgeForProfile(profile_.get());
-  // if (sync_bridge &&
-  //     !IsLastBadgingTimeWithin(badging::kBadgingMinimumUpdateInterval,
-  //     app_id,
-  //                              clock_, profile_)) {
-  //   sync_bridge->SetAppLastBadgingTime(app_id, clock_->Now());
-  // }
+  if (!IsLastBadgingTimeWithin(badging::kBadgingMinimumUpdateInterval, app_id,
+                               clock_, profile_)) {
+    ScopedDictPrefUpdate update(profile_->GetPrefs(),
+                                prefs::kBadgingLastBadgingTimes);
+    // Times older than kBadgingOverrideLifetime no longer matter, drop them
+    // so that apps which stopped badging don't grow the dict forever.
+    const base::Time now = clock_->Now();
+    std::vector<std::string> expired_app_ids;
+    for (const auto& [other_app_id, time] : *update) {
+      const std::optional<base::Time> last_badging_time =
+          base::ValueToTime(time);
+      if (!last_badging_time ||
+          last_badging_time.value() + kBadgingOverrideLifetime <= now) {
+        expired_app_ids.push_back(other_app_id);
+      }
+    }
+    for (const std::string& expired_app_id : expired_app_ids) {
+      update->Remove(expired_app_id);
+    }
+    update->Set(app_id, base::TimeToValue(now));
+  }
 
-  // if (!value) {
-  //   badged_apps_.erase(app_id);
-  // } else {
-  //   badged_apps_[app_id] = value.value();
-  // }
+  if (!value) {
+    badged_apps_.erase(app_id);
+  } else {
+    badged_apps_[app_id] = value.value();
+  }
 
-  // if (!delegate_) {
-  //   return;
-  // }
+  if (!delegate_) {
+    return;
+  }
+
+  // Pages may update their badge many times a second, so updates are
+  // coalesced. The first update after a quiet period is flushed from the next
+  // task, later ones wait for the interval to pass.
+  pending_apps_.insert(app_id);
+  ++pending_update_count_;
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(
+        FROM_HERE,
+        std::max(last_flush_time_ + kBadgeUpdateCoalescingInterval -
+                     base::TimeTicks::Now(),
+                 base::TimeDelta()),
+        base::BindOnce(&BadgeManager::FlushBadgeUpdates,
+                       base::Unretained(this)));
+  }
+}
 
-  // delegate_->OnAppBadgeUpdated(app_id);
+void BadgeManager::FlushBadgeUpdates() {
+  last_flush_time_ = base::TimeTicks::Now();
+  if (pending_update_count_ > 0) {
+    base::UmaHistogramCounts10000("Radium.Badging.UpdatesPerFlush",
+                                  pending_update_count_);
+  }
+  pending_update_count_ = 0;
+
+  std::set<webapps::AppId> apps;
+  apps.swap(pending_apps_);
+  for (const webapps::AppId& app_id : apps) {
+    // Skip the apps whose badge ended up where it was at the last flush.
+    const std::optional<BadgeValue> value = GetBadgeValue(app_id);
+    auto it = reported_badged_apps_.find(app_id);
+    if (it == reported_badged_apps_.end()) {
+      if (!value) {
+        continue;
+      }
+      reported_badged_apps_.emplace(app_id, value.value());
+    } else if (value == it->second) {
+      continue;
+    } else if (value) {
+      it->second = value.value();
+    } else {
+      reported_badged_apps_.erase(it);
+    }
+
+    if (delegate_) {
+      delegate_->OnAppBadgeUpdated(app_id);
+    }
+  }
 }
 
 void BadgeManager::SetBadge(blink::mojom::BadgeValuePtr mojo_value) {
@@ -257,6 +335,9 @@ void BadgeManager::ClearBadge() {
 std::vector<std::tuple<webapps::AppId, GURL>>
 BadgeManager::FrameBindingContext::GetAppIdsAndUrlsForBadging() const {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Radium has no web app registrar to map a frame to an installed app, so
+  // pages can't badge yet. Until there is one, badges only come from
+  // SetBadgeForTesting() and ClearBadgeForTesting().
   (void)process_id_;
   (void)frame_id_;
   return std::vector<std::tuple<webapps::AppId, GURL>>{};
@@ -285,6 +366,7 @@ BadgeManager::FrameBindingContext::GetAppIdsAndUrlsForBadging() const {
 std::vector<std::tuple<webapps::AppId, GURL>>
 BadgeManager::ServiceWorkerBindingContext::GetAppIdsAndUrlsForBadging() const {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // See FrameBindingContext::GetAppIdsAndUrlsForBadging().
   (void)process_id_;
   (void)scope_;
   return std::vector<std::tuple<webapps::AppId, GURL>>{};
@@ -8,11 +8,13 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/webapps/common/web_app_id.h"
 #include "content/public/browser/service_worker_version_base_info.h"
@@ -63,6 +65,11 @@ constexpr base::TimeDelta kBadgingOverrideLifetime = base::Days(14);
 // our updates to minimize load on the Web App database,
 constexpr base::TimeDelta kBadgingMinimumUpdateInterval = base::Hours(2);
 
+// Badge updates are forwarded to the delegate at most once per interval, only
+// the last value set for an app during the interval is shown.
+constexpr base::TimeDelta kBadgeUpdateCoalescingInterval =
+    base::Milliseconds(250);
+
 // Maintains a record of badge contents and dispatches badge changes to a
 // delegate.
 class BadgeManager : public KeyedService, public blink::mojom::BadgeService {
@@ -106,6 +113,9 @@ class BadgeManager : public KeyedService, public blink::mojom::BadgeService {
   void ClearBadgeForTesting(const webapps::AppId& app_id,
                             ukm::UkmRecorder* test_recorder);
   const base::Clock* SetClockForTesting(const base::Clock* clock);
+  // Forwards the pending badge updates to the delegate without waiting for
+  // the coalescing interval to pass.
+  void FlushBadgeUpdatesForTesting();
 
  private:
   // The BindingContext of a mojo request. Allows mojo calls to be tied back
@@ -162,6 +172,10 @@ class BadgeManager : public KeyedService, public blink::mojom::BadgeService {
   void UpdateBadge(const webapps::AppId& app_id,
                    std::optional<BadgeValue> value);
 
+  // Tells the delegate about the apps whose badge changed since the last
+  // flush.
+  void FlushBadgeUpdates();
+
   // blink::mojom::BadgeService:
   // Note: These are private to stop them being called outside of mojo as they
   // require a mojo binding context.
@@ -184,6 +198,17 @@ class BadgeManager : public KeyedService, public blink::mojom::BadgeService {
 
   // Maps app_id to badge contents.
   std::map<webapps::AppId, BadgeValue> badged_apps_;
+
+  // The badge contents the delegate was last told about, by app_id.
+  std::map<webapps::AppId, BadgeValue> reported_badged_apps_;
+
+  // The apps whose badge was updated since the last flush, and the number of
+  // updates.
+  std::set<webapps::AppId> pending_apps_;
+  int pending_update_count_ = 0;
+
+  base::OneShotTimer flush_timer_;
+  base::TimeTicks last_flush_time_;
 };
 
 // Determines the text to put on the badge based on some badge_content.
@@ -0,0 +1,59 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/badging/badge_manager.h"
+
+#include "base/test/simple_test_clock.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "components/prefs/pref_service.h"
+#include "components/ukm/test_ukm_recorder.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/badging/badge_manager_factory.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/common/pref_names.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace badging {
+
+class BadgeManagerBrowserTest : public RadiumBrowserTest {
+ protected:
+  BadgeManager* badge_manager() {
+    return BadgeManagerFactory::GetForProfile(browser()->profile());
+  }
+
+  const base::Value::Dict& GetLastBadgingTimes() {
+    return browser()->profile()->GetPrefs()->GetDict(
+        prefs::kBadgingLastBadgingTimes);
+  }
+
+  ukm::TestUkmRecorder ukm_recorder_;
+};
+
+IN_PROC_BROWSER_TEST_F(BadgeManagerBrowserTest, PrunesLastBadgingTimes) {
+  base::SimpleTestClock clock;
+  clock.SetNow(base::Time::Now());
+  const base::Clock* previous_clock =
+      badge_manager()->SetClockForTesting(&clock);
+
+  badge_manager()->SetBadgeForTesting("old", 1, &ukm_recorder_);
+  clock.Advance(kBadgingOverrideLifetime - base::Days(1));
+  badge_manager()->SetBadgeForTesting("recent", 1, &ukm_recorder_);
+  EXPECT_EQ(2u, GetLastBadgingTimes().size());
+  EXPECT_TRUE(badge_manager()->HasRecentApiUsage("old"));
+
+  // "old" last badged longer than kBadgingOverrideLifetime ago.
+  clock.Advance(base::Days(1));
+  EXPECT_FALSE(badge_manager()->HasRecentApiUsage("old"));
+  badge_manager()->SetBadgeForTesting("new", 1, &ukm_recorder_);
+  EXPECT_FALSE(GetLastBadgingTimes().contains("old"));
+  EXPECT_TRUE(GetLastBadgingTimes().contains("recent"));
+  EXPECT_TRUE(GetLastBadgingTimes().contains("new"));
+
+  badge_manager()->SetClockForTesting(previous_clock);
+}
+
+}  // namespace badging
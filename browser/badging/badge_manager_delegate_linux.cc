@@ -0,0 +1,124 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/badging/badge_manager_delegate_linux.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "base/hash/hash.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "components/dbus/thread_linux/dbus_thread_linux.h"
+#include "dbus/bus.h"
+#include "dbus/exported_object.h"
+#include "dbus/message.h"
+#include "dbus/object_path.h"
+#include "radium/browser/badging/badge_manager.h"
+#include "radium/browser/profiles/profile.h"
+
+namespace badging {
+
+namespace {
+
+constexpr char kLauncherEntryInterface[] = "com.canonical.Unity.LauncherEntry";
+constexpr char kUpdateSignal[] = "Update";
+// libunity derives the object path of an entry from a hash of its URI. Docks
+// only look at the URI in the signal, so any path works as long as it is
+// stable.
+constexpr char kLauncherEntryPathPrefix[] =
+    "/com/canonical/unity/launcherentry/";
+
+dbus::ObjectPath GetObjectPath(Profile* profile) {
+  return dbus::ObjectPath(base::StrCat(
+      {kLauncherEntryPathPrefix,
+       base::NumberToString(
+           base::PersistentHash(profile->GetBaseName().value()))}));
+}
+
+void AppendProperty(dbus::MessageWriter* properties,
+                    const char* name,
+                    bool value) {
+  dbus::MessageWriter entry(nullptr);
+  properties->OpenDictEntry(&entry);
+  entry.AppendString(name);
+  entry.AppendVariantOfBool(value);
+  properties->CloseContainer(&entry);
+}
+
+void AppendProperty(dbus::MessageWriter* properties,
+                    const char* name,
+                    int64_t value) {
+  dbus::MessageWriter entry(nullptr);
+  properties->OpenDictEntry(&entry);
+  entry.AppendString(name);
+  entry.AppendVariantOfInt64(value);
+  properties->CloseContainer(&entry);
+}
+
+}  // namespace
+
+BadgeManagerDelegateLinux::BadgeManagerDelegateLinux(
+    Profile* profile,
+    BadgeManager* badge_manager)
+    : BadgeManagerDelegateLinux(profile,
+                                badge_manager,
+                                dbus_thread_linux::GetSharedSessionBus()) {}
+
+BadgeManagerDelegateLinux::BadgeManagerDelegateLinux(
+    Profile* profile,
+    BadgeManager* badge_manager,
+    scoped_refptr<dbus::Bus> bus)
+    : BadgeManagerDelegate(profile, badge_manager),
+      bus_(std::move(bus)),
+      object_path_(GetObjectPath(profile)),
+      exported_object_(bus_->GetExportedObject(object_path_)) {}
+
+BadgeManagerDelegateLinux::~BadgeManagerDelegateLinux() {
+  exported_object_ = nullptr;
+  bus_->UnregisterExportedObject(object_path_);
+}
+
+void BadgeManagerDelegateLinux::OnAppBadgeUpdated(
+    const webapps::AppId& app_id) {
+  if (!exported_object_) {
+    return;
+  }
+
+  // There is no flag badge in the LauncherEntry interface. Urgency asks for
+  // the user's attention, which is more than a flag means, so a flag hides
+  // the count like a cleared badge.
+  const std::optional<BadgeManager::BadgeValue> badge =
+      badge_manager()->GetBadgeValue(app_id);
+  const bool has_count = badge && badge.value();
+  const int64_t count =
+      has_count ? static_cast<int64_t>(
+                      std::min<uint64_t>(badge.value().value(),
+                                         std::numeric_limits<int64_t>::max()))
+                : 0;
+
+  dbus::Signal signal(kLauncherEntryInterface, kUpdateSignal);
+  dbus::MessageWriter writer(&signal);
+  writer.AppendString(GetAppUri(app_id));
+  dbus::MessageWriter properties(nullptr);
+  writer.OpenArray("{sv}", &properties);
+  AppendProperty(&properties, "count", count);
+  AppendProperty(&properties, "count-visible", has_count);
+  writer.CloseContainer(&properties);
+
+  // Sent from the D-Bus thread.
+  exported_object_->SendSignal(&signal);
+}
+
+std::string BadgeManagerDelegateLinux::GetAppUri(
+    const webapps::AppId& app_id) {
+  return base::StrCat({"application://radium-", app_id, "-",
+                       profile()->GetBaseName().value(), ".desktop"});
+}
+
+}  // namespace badging
@@ -0,0 +1,55 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_BADGING_BADGE_MANAGER_DELEGATE_LINUX_H_
+#define RADIUM_BROWSER_BADGING_BADGE_MANAGER_DELEGATE_LINUX_H_
+
+#include <string>
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "dbus/object_path.h"
+#include "radium/browser/badging/badge_manager_delegate.h"
+
+class Profile;
+
+namespace dbus {
+class Bus;
+class ExportedObject;
+}  // namespace dbus
+
+namespace badging {
+
+class BadgeManager;
+
+// Linux specific implementation of the BadgeManagerDelegate. Badges are set on
+// the launcher entry of the app's desktop file with the Update signal of the
+// com.canonical.Unity.LauncherEntry D-Bus interface, which most docks and
+// launchers implement. The signals of all the apps of a profile are sent
+// from one object, which is exported for as long as the delegate lives.
+class BadgeManagerDelegateLinux : public BadgeManagerDelegate {
+ public:
+  BadgeManagerDelegateLinux(Profile* profile, BadgeManager* badge_manager);
+  // Emits the signals on |bus| instead of the shared session bus.
+  BadgeManagerDelegateLinux(Profile* profile,
+                            BadgeManager* badge_manager,
+                            scoped_refptr<dbus::Bus> bus);
+
+  ~BadgeManagerDelegateLinux() override;
+
+  void OnAppBadgeUpdated(const webapps::AppId& app_id) override;
+
+  // Returns the URI of the launcher entry of |app_id|, for instance
+  // "application://radium-<app_id>-Default.desktop".
+  std::string GetAppUri(const webapps::AppId& app_id);
+
+ private:
+  scoped_refptr<dbus::Bus> bus_;
+  const dbus::ObjectPath object_path_;
+  raw_ptr<dbus::ExportedObject> exported_object_;
+};
+
+}  // namespace badging
+
+#endif  // RADIUM_BROWSER_BADGING_BADGE_MANAGER_DELEGATE_LINUX_H_
@@ -0,0 +1,156 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/badging/badge_manager_delegate_linux.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "components/ukm/test_ukm_recorder.h"
+#include "content/public/test/browser_test.h"
+#include "dbus/bus.h"
+#include "dbus/message.h"
+#include "dbus/mock_bus.h"
+#include "dbus/mock_exported_object.h"
+#include "dbus/object_path.h"
+#include "radium/browser/badging/badge_manager.h"
+#include "radium/browser/badging/badge_manager_factory.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::_;
+using testing::Return;
+
+namespace badging {
+
+namespace {
+
+// The arguments of a com.canonical.Unity.LauncherEntry.Update signal.
+struct LauncherEntryUpdate {
+  std::string app_uri;
+  int64_t count = -1;
+  bool count_visible = false;
+  std::vector<std::string> property_names;
+};
+
+LauncherEntryUpdate ParseUpdate(dbus::Signal* signal) {
+  EXPECT_EQ("com.canonical.Unity.LauncherEntry", signal->GetInterface());
+  EXPECT_EQ("Update", signal->GetMember());
+
+  LauncherEntryUpdate update;
+  dbus::MessageReader reader(signal);
+  EXPECT_TRUE(reader.PopString(&update.app_uri));
+  dbus::MessageReader properties(nullptr);
+  EXPECT_TRUE(reader.PopArray(&properties));
+  while (properties.HasMoreData()) {
+    dbus::MessageReader entry(nullptr);
+    std::string name;
+    EXPECT_TRUE(properties.PopDictEntry(&entry));
+    EXPECT_TRUE(entry.PopString(&name));
+    if (name == "count") {
+      EXPECT_TRUE(entry.PopVariantOfInt64(&update.count));
+    } else if (name == "count-visible") {
+      EXPECT_TRUE(entry.PopVariantOfBool(&update.count_visible));
+    }
+    update.property_names.push_back(name);
+  }
+  return update;
+}
+
+}  // namespace
+
+// Checks the signals of the delegate on a fake session bus.
+class BadgeManagerDelegateLinuxBrowserTest : public RadiumBrowserTest {
+ protected:
+  void PreRunTestOnMainThread() override {
+    RadiumBrowserTest::PreRunTestOnMainThread();
+    bus_ = base::MakeRefCounted<dbus::MockBus>(dbus::Bus::Options());
+    badge_manager_ = BadgeManagerFactory::GetForProfile(browser()->profile());
+    ASSERT_TRUE(badge_manager_);
+  }
+
+  void PostRunTestOnMainThread() override {
+    badge_manager_ = nullptr;
+    RadiumBrowserTest::PostRunTestOnMainThread();
+  }
+
+  // Sets the badge of |app_id| and returns the signal that was sent for it.
+  LauncherEntryUpdate SetBadge(dbus::MockExportedObject* exported_object,
+                               const webapps::AppId& app_id,
+                               BadgeManager::BadgeValue value) {
+    LauncherEntryUpdate update;
+    EXPECT_CALL(*exported_object, SendSignal(_))
+        .WillOnce([&](dbus::Signal* signal) { update = ParseUpdate(signal); });
+    badge_manager_->SetBadgeForTesting(app_id, value, &ukm_recorder_);
+    badge_manager_->FlushBadgeUpdatesForTesting();
+    testing::Mock::VerifyAndClearExpectations(exported_object);
+    return update;
+  }
+
+  scoped_refptr<dbus::MockBus> bus_;
+  raw_ptr<BadgeManager> badge_manager_ = nullptr;
+  ukm::TestUkmRecorder ukm_recorder_;
+};
+
+// All the apps share one exported object, which is unregistered with the
+// delegate.
+IN_PROC_BROWSER_TEST_F(BadgeManagerDelegateLinuxBrowserTest,
+                       ExportsOneObjectPerDelegate) {
+  dbus::ObjectPath object_path;
+  auto exported_object = base::MakeRefCounted<dbus::MockExportedObject>(
+      bus_.get(), dbus::ObjectPath("/com/canonical/unity/launcherentry/0"));
+  EXPECT_CALL(*bus_, GetExportedObject(_))
+      .WillOnce([&](const dbus::ObjectPath& path) {
+        object_path = path;
+        return exported_object.get();
+      });
+  badge_manager_->SetDelegate(std::make_unique<BadgeManagerDelegateLinux>(
+      browser()->profile(), badge_manager_, bus_));
+  EXPECT_TRUE(object_path.IsValid());
+
+  SetBadge(exported_object.get(), "app1", 1);
+  SetBadge(exported_object.get(), "app2", 2);
+  testing::Mock::VerifyAndClearExpectations(bus_.get());
+
+  EXPECT_CALL(*bus_, UnregisterExportedObject(object_path));
+  badge_manager_->SetDelegate(nullptr);
+}
+
+IN_PROC_BROWSER_TEST_F(BadgeManagerDelegateLinuxBrowserTest, SendsCount) {
+  auto exported_object = base::MakeRefCounted<dbus::MockExportedObject>(
+      bus_.get(), dbus::ObjectPath("/com/canonical/unity/launcherentry/0"));
+  EXPECT_CALL(*bus_, GetExportedObject(_))
+      .WillOnce(Return(exported_object.get()));
+  EXPECT_CALL(*bus_, UnregisterExportedObject(_));
+  auto delegate = std::make_unique<BadgeManagerDelegateLinux>(
+      browser()->profile(), badge_manager_, bus_);
+  const std::string app_uri = delegate->GetAppUri("app");
+  badge_manager_->SetDelegate(std::move(delegate));
+
+  LauncherEntryUpdate update = SetBadge(exported_object.get(), "app", 42);
+  EXPECT_EQ(app_uri, update.app_uri);
+  EXPECT_EQ(42, update.count);
+  EXPECT_TRUE(update.count_visible);
+  EXPECT_THAT(update.property_names,
+              testing::UnorderedElementsAre("count", "count-visible"));
+
+  // The LauncherEntry interface has no flag badge. A flag does not mark the
+  // entry as urgent, it hides the count.
+  update = SetBadge(exported_object.get(), "app", std::nullopt);
+  EXPECT_FALSE(update.count_visible);
+  EXPECT_THAT(update.property_names,
+              testing::UnorderedElementsAre("count", "count-visible"));
+
+  badge_manager_->SetDelegate(nullptr);
+}
+
+}  // namespace badging
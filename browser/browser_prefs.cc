@@ -8,6 +8,7 @@
 #include "components/prefs/pref_registry_simple.h"
 #include "components/proxy_config/pref_proxy_config_tracker_impl.h"
 #include "radium/browser/browser_process.h"
+#include "radium/browser/net/http_cache_size_manager.h"
 #include "radium/browser/net/profile_network_context_service.h"
 #include "radium/browser/net/system_network_context_manager.h"
 #include "radium/browser/profiles/profiles_state.h"
@@ -21,6 +22,7 @@
 void RegisterLocalState(PrefRegistrySimple* registry) {
   BrowserProcess::RegisterPrefs(registry);
   PrefProxyConfigTrackerImpl::RegisterPrefs(registry);
+  HttpCacheSizeManager::RegisterPrefs(registry);
   ProfileNetworkContextService::RegisterLocalStatePrefs(registry);
   profiles::RegisterPrefs(registry);
   SSLConfigServiceManager::RegisterPrefs(registry);
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <memory>
 
+#include "base/metrics/histogram_functions.h"
 #include "base/notimplemented.h"
 #include "base/run_loop.h"
 #include "base/sequence_checker.h"
@@ -18,12 +19,14 @@
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "radium/browser/browser_process_platform_part.h"
+#include "radium/browser/devtools/devtools_browser_context_manager.h"
 #include "radium/browser/devtools/remote_debugging_server.h"
 #include "radium/browser/global_features.h"
 #include "radium/browser/lifetime/browser_shutdown.h"
 #include "radium/browser/metrics/radium_feature_list_creator.h"
 #include "radium/browser/net/system_network_context_manager.h"
 #include "radium/browser/policy/radium_browser_policy_connector.h"
+#include "radium/browser/prefs/pref_commit_scheduler.h"
 #include "radium/browser/profiles/profile_manager.h"
 #include "radium/common/pref_names.h"
 
@@ -165,6 +168,7 @@ BrowserProcess::BrowserProcess(
     : browser_policy_connector_(
           radium_feature_list_creator->TakeRadiumBrowserPolicyConnector()),
       local_state_(radium_feature_list_creator->TakePrefService()),
+      pref_commit_scheduler_(std::make_unique<PrefCommitScheduler>()),
       platform_part_(std::make_unique<BrowserProcessPlatformPart>()) {
   g_browser_process = this;
 }
@@ -183,6 +187,8 @@ void BrowserProcess::Init() {
   KeepAliveRegistry::GetInstance()->AddObserver(this);
 #endif  // !BUILDFLAG(IS_ANDROID)
 
+  pref_commit_scheduler_->AddPrefService(local_state_.get());
+
   features_ = std::make_unique<GlobalFeatures>();
   features_->Init();
 }
@@ -285,6 +291,7 @@ bool BrowserProcess::IsShuttingDown() {
 void BrowserProcess::StartTearDown() {
   // Debugger must be cleaned up before ProfileManager.
   remote_debugging_server_.reset();
+  DevToolsBrowserContextManager::GetInstance().Shutdown();
 
   // Need to clear profiles (download managers) before the IO thread.
   {
@@ -296,6 +303,7 @@ void BrowserProcess::StartTearDown() {
     features_.reset();
   }
 
+  pref_commit_scheduler_->RemovePrefService(local_state_.get());
   local_state_->CommitPendingWrite();
 
   // This expects to be destroyed before the task scheduler is torn down.
@@ -306,19 +314,18 @@ void BrowserProcess::PostDestroyThreads() {}
 #endif
 
 void BrowserProcess::EndSession() {
-  // Mark all the profiles as clean.
-  ProfileManager* pm = features_->profile_manager();
+  // Write Local State and the prefs of all profiles in parallel.
   scoped_refptr<RundownTaskCounter> rundown_counter =
       base::MakeRefCounted<RundownTaskCounter>();
-  for (Profile* profile : pm->GetLoadedProfiles()) {
-    if (profile->GetPrefs()) {
-      profile->GetPrefs()->CommitPendingWrite(
-          base::OnceClosure(), rundown_counter->GetRundownClosure());
-    }
-  }
+  pref_commit_scheduler_->CommitAllNow(base::BindRepeating(
+      &RundownTaskCounter::GetRundownClosure, rundown_counter));
 
 #if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_OZONE)
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   rundown_counter->TimedWait(kEndSessionTimeout);
+  base::UmaHistogramMediumTimes(
+      "Radium.Prefs.CommitScheduler.EndSessionFlushLatency",
+      base::TimeTicks::Now() - start_time);
 #else
   NOTIMPLEMENTED();
 #endif
@@ -334,6 +341,10 @@ PrefService* BrowserProcess::local_state() {
   return local_state_.get();
 }
 
+PrefCommitScheduler* BrowserProcess::pref_commit_scheduler() {
+  return pref_commit_scheduler_.get();
+}
+
 GpuModeManager* BrowserProcess::gpu_mode_manager() {
   // TODO
   return nullptr;
@@ -14,6 +14,7 @@
 class BrowserProcessPlatformPart;
 class GlobalFeatures;
 class GpuModeManager;
+class PrefCommitScheduler;
 class PrefRegistrySimple;
 class PrefService;
 class RadiumFeatureListCreator;
@@ -75,6 +76,7 @@ class BrowserProcess : public KeepAliveStateObserver {
 
   policy::RadiumBrowserPolicyConnector* browser_policy_connector();
   PrefService* local_state();
+  PrefCommitScheduler* pref_commit_scheduler();
   GpuModeManager* gpu_mode_manager();
   os_crypt_async::OSCryptAsync* os_crypt_async();
   policy::PolicyService* policy_service();
@@ -100,6 +102,10 @@ class BrowserProcess : public KeepAliveStateObserver {
 
   const std::unique_ptr<PrefService> local_state_;
 
+  // Commits Local State and the profile prefs. Must be destroyed before
+  // |local_state_| and after |features_|.
+  const std::unique_ptr<PrefCommitScheduler> pref_commit_scheduler_;
+
 #if !BUILDFLAG(IS_ANDROID)
   std::unique_ptr<RemoteDebuggingServer> remote_debugging_server_;
 #endif
@@ -4,9 +4,62 @@
 
 #include "radium/browser/devtools/devtools_browser_context_manager.h"
 
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/no_destructor.h"
+#include "base/strings/strcat.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "base/uuid.h"
+#include "content/public/browser/render_process_host.h"
 #include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_keep_alive_types.h"
 #include "radium/browser/profiles/profile_manager.h"
+#include "radium/browser/profiles/scoped_profile_keep_alive.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_list.h"
+#include "radium/browser/ui/browser_window.h"
+
+namespace {
+
+constexpr char kOffTheRecordProfileIdPrefix[] = "DevTools::BrowserContext::";
+
+// How long to wait before checking again whether the renderers of a context
+// that is being disposed of are gone.
+constexpr base::TimeDelta kDestroyRetryDelay = base::Milliseconds(100);
+
+std::vector<Browser*> GetBrowsers(const Profile* profile) {
+  std::vector<Browser*> browsers;
+  for (Browser* browser : *BrowserList::GetInstance()) {
+    if (browser->profile() == profile) {
+      browsers.push_back(browser);
+    }
+  }
+  return browsers;
+}
+
+bool HasLiveRenderProcessHosts(const Profile* profile) {
+  for (content::RenderProcessHost::iterator it =
+           content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (host->GetBrowserContext() == profile && !host->HostHasNotBeenUsed()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+DevToolsBrowserContextManager::BrowserContextInfo::BrowserContextInfo() =
+    default;
+DevToolsBrowserContextManager::BrowserContextInfo::~BrowserContextInfo() =
+    default;
 
 // static
 DevToolsBrowserContextManager& DevToolsBrowserContextManager::GetInstance() {
@@ -14,12 +67,22 @@ DevToolsBrowserContextManager& DevToolsBrowserContextManager::GetInstance() {
   return *instance;
 }
 
-DevToolsBrowserContextManager::DevToolsBrowserContextManager() = default;
-DevToolsBrowserContextManager::~DevToolsBrowserContextManager() = default;
+DevToolsBrowserContextManager::DevToolsBrowserContextManager() {
+  BrowserList::AddObserver(this);
+}
+
+DevToolsBrowserContextManager::~DevToolsBrowserContextManager() {
+  BrowserList::RemoveObserver(this);
+}
 
 std::vector<content::BrowserContext*>
 DevToolsBrowserContextManager::GetBrowserContexts() {
-  return {};
+  std::vector<content::BrowserContext*> contexts;
+  contexts.reserve(contexts_.size());
+  for (const auto& [context_id, info] : contexts_) {
+    contexts.push_back(info->profile);
+  }
+  return contexts;
 }
 
 content::BrowserContext*
@@ -28,5 +91,119 @@ DevToolsBrowserContextManager::GetDefaultBrowserContext() {
 }
 
 content::BrowserContext* DevToolsBrowserContextManager::CreateBrowserContext() {
-  return nullptr;
+  TRACE_EVENT0("browser",
+               "DevToolsBrowserContextManager::CreateBrowserContext");
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  Profile* original_profile =
+      ProfileManager::GetLastUsedProfile()->GetOriginalProfile();
+  auto info = std::make_unique<BrowserContextInfo>();
+  info->keep_alive = std::make_unique<ScopedProfileKeepAlive>(
+      original_profile, ProfileKeepAliveOrigin::kDevToolsBrowserContext);
+  info->profile = original_profile->CreateOffTheRecordProfile(
+      base::StrCat({kOffTheRecordProfileIdPrefix,
+                    base::Uuid::GenerateRandomV4().AsLowercaseString()}));
+
+  Profile* profile = info->profile;
+  contexts_[profile->UniqueId()] = std::move(info);
+  base::UmaHistogramTimes("Radium.DevTools.BrowserContextCreationTime",
+                          base::TimeTicks::Now() - start_time);
+  return profile;
+}
+
+void DevToolsBrowserContextManager::DisposeBrowserContext(
+    content::BrowserContext* context,
+    content::DevToolsManagerDelegate::DisposeCallback callback) {
+  const std::string& context_id = context->UniqueId();
+  auto it = contexts_.find(context_id);
+  if (it == contexts_.end()) {
+    std::move(callback).Run(
+        false, base::StrCat({"Failed to find context with id ", context_id}));
+    return;
+  }
+  BrowserContextInfo* info = it->second.get();
+  if (info->dispose_callback) {
+    std::move(callback).Run(
+        false, base::StrCat({"Disposal of browser context ", context_id,
+                             " is already pending"}));
+    return;
+  }
+
+  info->dispose_callback = std::move(callback);
+  // The pages of the context are closed without running their beforeunload
+  // handlers. The windows close asynchronously, see OnBrowserRemoved().
+  for (Browser* browser : GetBrowsers(info->profile)) {
+    browser->set_force_skip_warning_user_on_close(true);
+    browser->window()->Close();
+  }
+  MaybeDestroyBrowserContext(context_id);
+}
+
+Profile* DevToolsBrowserContextManager::GetBrowserContext(
+    const std::string& context_id) {
+  auto it = contexts_.find(context_id);
+  return it == contexts_.end() ? nullptr : it->second->profile.get();
+}
+
+void DevToolsBrowserContextManager::Shutdown() {
+  // Pending disposals are not reported, the clients are gone by now.
+  while (!contexts_.empty()) {
+    DestroyBrowserContext(contexts_.begin()->first);
+  }
+}
+
+void DevToolsBrowserContextManager::OnBrowserRemoved(Browser* browser) {
+  for (const auto& [context_id, info] : contexts_) {
+    if (info->profile == browser->profile() && info->dispose_callback) {
+      // |browser| is still being destroyed, and its pages with it.
+      base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE,
+          base::BindOnce(
+              &DevToolsBrowserContextManager::MaybeDestroyBrowserContext,
+              base::Unretained(this), context_id));
+      return;
+    }
+  }
+}
+
+void DevToolsBrowserContextManager::MaybeDestroyBrowserContext(
+    const std::string& context_id) {
+  auto it = contexts_.find(context_id);
+  if (it == contexts_.end() || !it->second->dispose_callback ||
+      !GetBrowsers(it->second->profile).empty()) {
+    return;
+  }
+
+  if (HasLiveRenderProcessHosts(it->second->profile)) {
+    // Closed pages may still be running unload handlers. Check again later.
+    // Unretained is safe because this object is never destroyed.
+    base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(
+            &DevToolsBrowserContextManager::MaybeDestroyBrowserContext,
+            base::Unretained(this), context_id),
+        kDestroyRetryDelay);
+    return;
+  }
+
+  content::DevToolsManagerDelegate::DisposeCallback callback =
+      std::move(it->second->dispose_callback);
+  DestroyBrowserContext(context_id);
+  std::move(callback).Run(true, std::string());
+}
+
+void DevToolsBrowserContextManager::DestroyBrowserContext(
+    const std::string& context_id) {
+  TRACE_EVENT0("browser",
+               "DevToolsBrowserContextManager::DestroyBrowserContext");
+  auto it = contexts_.find(context_id);
+  CHECK(it != contexts_.end());
+  std::unique_ptr<BrowserContextInfo> info = std::move(it->second);
+  contexts_.erase(it);
+
+  Profile* profile = info->profile;
+  info->profile = nullptr;
+  profile->GetOriginalProfile()->DestroyOffTheRecordProfile(profile);
+  // Only now that the context is gone, let the original profile be unloaded.
+  info.reset();
 }
@@ -5,13 +5,27 @@
 #ifndef RADIUM_BROWSER_DEVTOOLS_DEVTOOLS_BROWSER_CONTEXT_MANAGER_H_
 #define RADIUM_BROWSER_DEVTOOLS_DEVTOOLS_BROWSER_CONTEXT_MANAGER_H_
 
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "base/memory/raw_ptr.h"
+#include "content/public/browser/devtools_manager_delegate.h"
+#include "radium/browser/ui/browser_list_observer.h"
+
+class Profile;
+class ScopedProfileKeepAlive;
+
 namespace content {
 class BrowserContext;
 }
 
-class DevToolsBrowserContextManager {
+// Manages the browser contexts created with Target.createBrowserContext. Each
+// of them is an off-the-record profile of the default profile that keeps its
+// preferences, cookies and HTTP cache in memory, so that clients can run
+// isolated sessions in parallel without launching more browser processes.
+class DevToolsBrowserContextManager : public BrowserListObserver {
  public:
   static DevToolsBrowserContextManager& GetInstance();
 
@@ -20,11 +34,47 @@ class DevToolsBrowserContextManager {
   DevToolsBrowserContextManager& operator=(
       const DevToolsBrowserContextManager&) = delete;
 
-  ~DevToolsBrowserContextManager();
+  ~DevToolsBrowserContextManager() override;
 
   std::vector<content::BrowserContext*> GetBrowserContexts();
   content::BrowserContext* GetDefaultBrowserContext();
   content::BrowserContext* CreateBrowserContext();
+
+  // Closes the windows of |context| and destroys it once they are gone.
+  void DisposeBrowserContext(
+      content::BrowserContext* context,
+      content::DevToolsManagerDelegate::DisposeCallback callback);
+
+  // Returns the browser context created by CreateBrowserContext() whose
+  // UniqueId() is |context_id|, or null.
+  Profile* GetBrowserContext(const std::string& context_id);
+
+  // Destroys the remaining browser contexts. Called before the profiles are
+  // torn down.
+  void Shutdown();
+
+ private:
+  struct BrowserContextInfo {
+    BrowserContextInfo();
+    ~BrowserContextInfo();
+
+    raw_ptr<Profile> profile;
+    // Keeps the original profile, which owns |profile|, loaded.
+    std::unique_ptr<ScopedProfileKeepAlive> keep_alive;
+    // Set while DisposeBrowserContext() waits for the windows to close.
+    content::DevToolsManagerDelegate::DisposeCallback dispose_callback;
+  };
+
+  // BrowserListObserver:
+  void OnBrowserRemoved(Browser* browser) override;
+
+  // Destroys the browser context |context_id| if it is being disposed of and
+  // nothing uses it anymore.
+  void MaybeDestroyBrowserContext(const std::string& context_id);
+  void DestroyBrowserContext(const std::string& context_id);
+
+  // By BrowserContext::UniqueId().
+  std::map<std::string, std::unique_ptr<BrowserContextInfo>> contexts_;
 };
 
 #endif  // RADIUM_BROWSER_DEVTOOLS_DEVTOOLS_BROWSER_CONTEXT_MANAGER_H_
@@ -0,0 +1,327 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/devtools/protocol/radium_performance_handler.h"
+
+#include <map>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/location.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/process/process_handle.h"
+#include "base/time/time.h"
+#include "components/startup_metric_utils/common/startup_metric_utils.h"
+#include "content/public/browser/devtools_agent_host.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/metrics/startup_milestones.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/browser/ui/webui/webui_process_model.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+
+namespace RadiumPerformance = protocol::RadiumPerformance;
+
+namespace {
+
+constexpr base::TimeDelta kMinStreamingInterval = base::Milliseconds(100);
+constexpr base::TimeDelta kDefaultStreamingInterval = base::Seconds(1);
+
+using SnapshotCallback =
+    base::OnceCallback<void(std::unique_ptr<RadiumPerformance::Snapshot>)>;
+
+double GetMillisecondsSinceMainEntryPoint(base::TimeTicks time) {
+  return (time - startup_metric_utils::GetCommon().MainEntryPointTicks())
+      .InMillisecondsF();
+}
+
+std::string GetProfileName(Profile* profile) {
+  return profile->GetBaseName().AsUTF8Unsafe();
+}
+
+// Returns the live renderer process of the primary main frame of
+// |web_contents|, if any.
+content::RenderProcessHost* GetMainFrameProcess(
+    content::WebContents* web_contents) {
+  content::RenderProcessHost* host =
+      web_contents->GetPrimaryMainFrame()->GetProcess();
+  return host->IsInitializedAndNotDead() ? host : nullptr;
+}
+
+// Builds a snapshot of the processes as they are now. |dump| holds the
+// private memory footprint of the processes, or is null if it could not be
+// measured.
+std::unique_ptr<RadiumPerformance::Snapshot> BuildSnapshot(
+    const memory_instrumentation::GlobalMemoryDump* dump) {
+  std::map<base::ProcessId, uint64_t> footprints_kb;
+  if (dump) {
+    for (const memory_instrumentation::GlobalMemoryDump::ProcessDump&
+             process_dump : dump->process_dumps()) {
+      footprints_kb[process_dump.pid()] =
+          process_dump.os_dump().private_footprint_kb;
+    }
+  }
+  auto get_footprint_kb =
+      [&footprints_kb](base::ProcessId pid) -> std::optional<uint64_t> {
+    auto it = footprints_kb.find(pid);
+    if (it == footprints_kb.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  };
+
+  struct ProfileData {
+    int renderer_count = 0;
+    uint64_t footprint_kb = 0;
+  };
+  // Loaded profiles are reported even when they have no renderer.
+  std::map<Profile*, ProfileData> profiles;
+  for (Profile* profile : BrowserProcess::Get()
+                              ->GetFeatures()
+                              ->profile_manager()
+                              ->GetLoadedProfiles()) {
+    profiles[profile];
+  }
+
+  int renderer_count = 0;
+  for (content::RenderProcessHost::iterator it =
+           content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (!host->IsInitializedAndNotDead()) {
+      continue;
+    }
+    ++renderer_count;
+    ProfileData& data =
+        profiles[Profile::FromBrowserContext(host->GetBrowserContext())];
+    ++data.renderer_count;
+    data.footprint_kb +=
+        get_footprint_kb(host->GetProcess().Pid()).value_or(0);
+  }
+
+  auto profile_metrics =
+      std::make_unique<protocol::Array<RadiumPerformance::ProfileMetrics>>();
+  for (const auto& [profile, data] : profiles) {
+    std::unique_ptr<RadiumPerformance::ProfileMetrics> metrics =
+        RadiumPerformance::ProfileMetrics::Create()
+            .SetProfile(GetProfileName(profile))
+            .SetOffTheRecord(profile->IsOffTheRecord())
+            .SetRendererCount(data.renderer_count)
+            .SetServicesCreationTime(
+                profile->services_creation_time().InMillisecondsF())
+            .Build();
+    if (dump) {
+      metrics->SetPrivateMemoryFootprint(data.footprint_kb);
+    }
+    profile_metrics->push_back(std::move(metrics));
+  }
+
+  auto web_contents_metrics = std::make_unique<
+      protocol::Array<RadiumPerformance::WebContentsMetrics>>();
+  for (const scoped_refptr<content::DevToolsAgentHost>& agent_host :
+       content::DevToolsAgentHost::GetOrCreateAll()) {
+    content::WebContents* web_contents = agent_host->GetWebContents();
+    if (agent_host->GetType() != content::DevToolsAgentHost::kTypePage ||
+        !web_contents) {
+      continue;
+    }
+    std::unique_ptr<RadiumPerformance::WebContentsMetrics> metrics =
+        RadiumPerformance::WebContentsMetrics::Create()
+            .SetTargetId(agent_host->GetId())
+            .SetProfile(GetProfileName(
+                Profile::FromBrowserContext(web_contents->GetBrowserContext())))
+            .SetUrl(web_contents->GetLastCommittedURL().spec())
+            .Build();
+    if (content::RenderProcessHost* host = GetMainFrameProcess(web_contents)) {
+      std::optional<uint64_t> footprint_kb =
+          get_footprint_kb(host->GetProcess().Pid());
+      if (footprint_kb) {
+        metrics->SetMainFrameProcessPrivateMemoryFootprint(*footprint_kb);
+      }
+    }
+    web_contents_metrics->push_back(std::move(metrics));
+  }
+
+  std::unique_ptr<RadiumPerformance::Snapshot> snapshot =
+      RadiumPerformance::Snapshot::Create()
+          .SetTime(GetMillisecondsSinceMainEntryPoint(base::TimeTicks::Now()))
+          .SetRendererCount(renderer_count)
+          .SetWebUIRendererCount(
+              WebUIProcessModel::GetWebUIRendererCount(nullptr))
+          .SetProfiles(std::move(profile_metrics))
+          .SetWebContents(std::move(web_contents_metrics))
+          .Build();
+  std::optional<uint64_t> browser_footprint_kb =
+      get_footprint_kb(base::GetCurrentProcId());
+  if (browser_footprint_kb) {
+    snapshot->SetBrowserPrivateMemoryFootprint(*browser_footprint_kb);
+  }
+  return snapshot;
+}
+
+void OnMemoryDump(
+    SnapshotCallback callback,
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump) {
+  std::move(callback).Run(BuildSnapshot(success ? dump.get() : nullptr));
+}
+
+// Measures the memory of all processes and runs |callback| with a snapshot
+// once done.
+void TakeSnapshot(SnapshotCallback callback) {
+  auto* instrumentation =
+      memory_instrumentation::MemoryInstrumentation::GetInstance();
+  if (!instrumentation) {
+    std::move(callback).Run(BuildSnapshot(nullptr));
+    return;
+  }
+  instrumentation->RequestPrivateMemoryFootprint(
+      base::kNullProcessId, base::BindOnce(&OnMemoryDump, std::move(callback)));
+}
+
+std::unique_ptr<RadiumPerformance::Histogram> GetHistogramData(
+    const std::string& name,
+    const base::HistogramSamples& samples) {
+  auto buckets = std::make_unique<protocol::Array<RadiumPerformance::Bucket>>();
+  for (std::unique_ptr<base::SampleCountIterator> it = samples.Iterator();
+       !it->Done(); it->Next()) {
+    base::HistogramBase::Sample low;
+    int64_t high;
+    base::HistogramBase::Count count;
+    it->Get(&low, &high, &count);
+    buckets->push_back(RadiumPerformance::Bucket::Create()
+                           .SetLow(low)
+                           .SetHigh(base::saturated_cast<int>(high))
+                           .SetCount(count)
+                           .Build());
+  }
+
+  return RadiumPerformance::Histogram::Create()
+      .SetName(name)
+      .SetSum(static_cast<double>(samples.sum()))
+      .SetCount(samples.TotalCount())
+      .SetBuckets(std::move(buckets))
+      .Build();
+}
+
+}  // namespace
+
+RadiumPerformanceHandler::RadiumPerformanceHandler(
+    protocol::UberDispatcher* dispatcher)
+    : frontend_(std::make_unique<RadiumPerformance::Frontend>(
+          dispatcher->channel())) {
+  RadiumPerformance::Dispatcher::wire(dispatcher, this);
+}
+
+RadiumPerformanceHandler::~RadiumPerformanceHandler() = default;
+
+protocol::Response RadiumPerformanceHandler::GetStartupTimestamps(
+    std::unique_ptr<protocol::Array<RadiumPerformance::StartupTimestamp>>*
+        out_timestamps) {
+  *out_timestamps = std::make_unique<
+      protocol::Array<RadiumPerformance::StartupTimestamp>>();
+  for (const startup_milestones::Milestone& milestone :
+       startup_milestones::Get()) {
+    (*out_timestamps)
+        ->push_back(RadiumPerformance::StartupTimestamp::Create()
+                        .SetName(milestone.name)
+                        .SetTime(GetMillisecondsSinceMainEntryPoint(
+                            milestone.time))
+                        .Build());
+  }
+  return protocol::Response::Success();
+}
+
+void RadiumPerformanceHandler::GetSnapshot(
+    std::unique_ptr<GetSnapshotCallback> callback) {
+  TakeSnapshot(base::BindOnce(
+      [](std::unique_ptr<GetSnapshotCallback> callback,
+         std::unique_ptr<RadiumPerformance::Snapshot> snapshot) {
+        callback->sendSuccess(std::move(snapshot));
+      },
+      std::move(callback)));
+}
+
+protocol::Response RadiumPerformanceHandler::GetHistograms(
+    std::optional<std::string> in_query,
+    std::optional<bool> in_delta,
+    std::unique_ptr<protocol::Array<RadiumPerformance::Histogram>>*
+        out_histograms) {
+  // Include the samples of the child processes.
+  base::StatisticsRecorder::ImportProvidedHistogramsSync();
+  *out_histograms =
+      std::make_unique<protocol::Array<RadiumPerformance::Histogram>>();
+  for (base::HistogramBase* const histogram :
+       base::StatisticsRecorder::Sort(base::StatisticsRecorder::WithName(
+           base::StatisticsRecorder::GetHistograms(), in_query.value_or(""),
+           /*case_sensitive=*/true))) {
+    const std::string name = histogram->histogram_name();
+    std::unique_ptr<base::HistogramSamples> samples =
+        histogram->SnapshotSamples();
+    if (!in_delta.value_or(false)) {
+      (*out_histograms)->push_back(GetHistogramData(name, *samples));
+      continue;
+    }
+
+    // SnapshotDelta() would take the samples from the UMA upload, so deltas
+    // are computed against what this session last reported instead.
+    std::unique_ptr<base::HistogramSamples>& baseline =
+        delta_baselines_[name];
+    if (!baseline) {
+      (*out_histograms)->push_back(GetHistogramData(name, *samples));
+      baseline = std::move(samples);
+      continue;
+    }
+    samples->Subtract(*baseline);
+    baseline->Add(*samples);
+    (*out_histograms)->push_back(GetHistogramData(name, *samples));
+  }
+  return protocol::Response::Success();
+}
+
+protocol::Response RadiumPerformanceHandler::StartStreaming(
+    std::optional<int> in_interval) {
+  const base::TimeDelta interval =
+      in_interval ? base::Milliseconds(*in_interval)
+                  : kDefaultStreamingInterval;
+  if (interval < kMinStreamingInterval) {
+    return protocol::Response::InvalidParams(
+        "The interval must be at least 100 ms");
+  }
+  streaming_timer_.Start(FROM_HERE, interval, this,
+                         &RadiumPerformanceHandler::OnStreamingTimer);
+  return protocol::Response::Success();
+}
+
+protocol::Response RadiumPerformanceHandler::StopStreaming() {
+  streaming_timer_.Stop();
+  return protocol::Response::Success();
+}
+
+void RadiumPerformanceHandler::OnStreamingTimer() {
+  if (streaming_snapshot_pending_) {
+    return;
+  }
+  streaming_snapshot_pending_ = true;
+  TakeSnapshot(base::BindOnce(&RadiumPerformanceHandler::OnStreamingSnapshot,
+                              weak_ptr_factory_.GetWeakPtr()));
+}
+
+void RadiumPerformanceHandler::OnStreamingSnapshot(
+    std::unique_ptr<RadiumPerformance::Snapshot> snapshot) {
+  streaming_snapshot_pending_ = false;
+  // Streaming may have been stopped while the snapshot was taken.
+  if (streaming_timer_.IsRunning()) {
+    frontend_->SnapshotTaken(std::move(snapshot));
+  }
+}
@@ -0,0 +1,66 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_DEVTOOLS_PROTOCOL_RADIUM_PERFORMANCE_HANDLER_H_
+#define RADIUM_BROWSER_DEVTOOLS_PROTOCOL_RADIUM_PERFORMANCE_HANDLER_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "radium/browser/devtools/protocol/radium_performance.h"
+
+namespace base {
+class HistogramSamples;
+}
+
+// Implements the RadiumPerformance domain, see radium_protocol.pdl.
+class RadiumPerformanceHandler : public protocol::RadiumPerformance::Backend {
+ public:
+  explicit RadiumPerformanceHandler(protocol::UberDispatcher* dispatcher);
+  RadiumPerformanceHandler(const RadiumPerformanceHandler&) = delete;
+  RadiumPerformanceHandler& operator=(const RadiumPerformanceHandler&) =
+      delete;
+
+  ~RadiumPerformanceHandler() override;
+
+  // protocol::RadiumPerformance::Backend:
+  protocol::Response GetStartupTimestamps(
+      std::unique_ptr<
+          protocol::Array<protocol::RadiumPerformance::StartupTimestamp>>*
+          out_timestamps) override;
+  void GetSnapshot(std::unique_ptr<GetSnapshotCallback> callback) override;
+  protocol::Response GetHistograms(
+      std::optional<std::string> in_query,
+      std::optional<bool> in_delta,
+      std::unique_ptr<protocol::Array<protocol::RadiumPerformance::Histogram>>*
+          out_histograms) override;
+  protocol::Response StartStreaming(std::optional<int> in_interval) override;
+  protocol::Response StopStreaming() override;
+
+ private:
+  void OnStreamingTimer();
+  void OnStreamingSnapshot(
+      std::unique_ptr<protocol::RadiumPerformance::Snapshot> snapshot);
+
+  std::unique_ptr<protocol::RadiumPerformance::Frontend> frontend_;
+
+  // The samples of each histogram as of the last getHistograms call with
+  // delta, by histogram name.
+  std::map<std::string, std::unique_ptr<base::HistogramSamples>>
+      delta_baselines_;
+
+  base::RepeatingTimer streaming_timer_;
+  // Whether a snapshot for streaming is being taken. A tick of
+  // |streaming_timer_| is skipped rather than piling up memory dumps when the
+  // previous one has not completed yet.
+  bool streaming_snapshot_pending_ = false;
+
+  base::WeakPtrFactory<RadiumPerformanceHandler> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_BROWSER_DEVTOOLS_PROTOCOL_RADIUM_PERFORMANCE_HANDLER_H_
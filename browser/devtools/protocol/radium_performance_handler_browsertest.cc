@@ -0,0 +1,318 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/functional/function_ref.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/message_loop/message_pump_for_io.h"
+#include "base/message_loop/message_pump_type.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/run_loop.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/current_thread.h"
+#include "base/threading/sequence_bound.h"
+#include "base/threading/thread.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/values.h"
+#include "content/public/common/content_switches.h"
+#include "content/public/test/browser_test.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr char kHistogramName[] = "Radium.Test.RadiumPerformanceHandler";
+
+// With --remote-debugging-pipe the browser reads messages from fd 3 and
+// writes its own to fd 4. Each message is JSON followed by a null byte.
+constexpr int kBrowserReadFd = 3;
+constexpr int kBrowserWriteFd = 4;
+
+// Reads the messages of the browser on an IO thread, and hands each one to
+// |on_message|.
+class PipeReader : public base::MessagePumpForIO::FdWatcher {
+ public:
+  PipeReader(base::ScopedFD fd,
+             base::RepeatingCallback<void(std::string)> on_message)
+      : fd_(std::move(fd)), on_message_(std::move(on_message)) {
+    CHECK(base::SetNonBlocking(fd_.get()));
+    base::CurrentIOThread::Get()->WatchFileDescriptor(
+        fd_.get(), /*persistent=*/true, base::MessagePumpForIO::WATCH_READ,
+        &controller_, this);
+  }
+
+  PipeReader(const PipeReader&) = delete;
+  PipeReader& operator=(const PipeReader&) = delete;
+
+  ~PipeReader() override = default;
+
+ private:
+  // base::MessagePumpForIO::FdWatcher:
+  void OnFileCanReadWithoutBlocking(int fd) override {
+    char buffer[4096];
+    ssize_t result = HANDLE_EINTR(read(fd, buffer, sizeof(buffer)));
+    if (result <= 0) {
+      if (result == 0 || errno != EAGAIN) {
+        controller_.StopWatchingFileDescriptor();
+      }
+      return;
+    }
+    pending_.append(buffer, static_cast<size_t>(result));
+    size_t end;
+    while ((end = pending_.find('\0')) != std::string::npos) {
+      on_message_.Run(pending_.substr(0, end));
+      pending_.erase(0, end + 1);
+    }
+  }
+
+  void OnFileCanWriteWithoutBlocking(int fd) override {}
+
+  base::ScopedFD fd_;
+  base::RepeatingCallback<void(std::string)> on_message_;
+  base::MessagePumpForIO::FdWatchController controller_{FROM_HERE};
+  // Bytes of a message that has not been read completely.
+  std::string pending_;
+};
+
+}  // namespace
+
+// Drives the RadiumPerformance domain the way a dashboard does: as a client on
+// the other end of --remote-debugging-pipe, talking to the browser target.
+class RadiumPerformanceHandlerBrowserTest : public RadiumBrowserTest {
+ protected:
+  // RadiumBrowserTest:
+  void SetUp() override {
+    int to_browser[2];
+    int from_browser[2];
+    ASSERT_EQ(0, pipe(to_browser));
+    ASSERT_EQ(0, pipe(from_browser));
+    // Keep the ends of the test clear of the fds the browser uses.
+    write_fd_.reset(
+        fcntl(to_browser[1], F_DUPFD_CLOEXEC, kBrowserWriteFd + 1));
+    read_fd_.reset(
+        fcntl(from_browser[0], F_DUPFD_CLOEXEC, kBrowserWriteFd + 1));
+    ASSERT_TRUE(write_fd_.is_valid());
+    ASSERT_TRUE(read_fd_.is_valid());
+    ASSERT_EQ(kBrowserReadFd,
+              HANDLE_EINTR(dup2(to_browser[0], kBrowserReadFd)));
+    ASSERT_EQ(kBrowserWriteFd,
+              HANDLE_EINTR(dup2(from_browser[1], kBrowserWriteFd)));
+    for (int fd :
+         {to_browser[0], to_browser[1], from_browser[0], from_browser[1]}) {
+      if (fd != kBrowserReadFd && fd != kBrowserWriteFd) {
+        close(fd);
+      }
+    }
+    RadiumBrowserTest::SetUp();
+  }
+
+  // content::BrowserTestBase:
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    command_line->AppendSwitch(switches::kRemoteDebuggingPipe);
+  }
+
+  // RadiumBrowserTest:
+  void PreRunTestOnMainThread() override {
+    RadiumBrowserTest::PreRunTestOnMainThread();
+    ASSERT_TRUE(reader_thread_.StartWithOptions(
+        base::Thread::Options(base::MessagePumpType::IO, 0)));
+    reader_ = base::SequenceBound<PipeReader>(
+        reader_thread_.task_runner(), std::move(read_fd_),
+        base::BindPostTaskToCurrentDefault(base::BindRepeating(
+            &RadiumPerformanceHandlerBrowserTest::OnMessage,
+            base::Unretained(this))));
+  }
+
+  void PostRunTestOnMainThread() override {
+    reader_.Reset();
+    {
+      base::ScopedAllowBaseSyncPrimitivesForTesting allow_wait;
+      reader_thread_.Stop();
+    }
+    RadiumBrowserTest::PostRunTestOnMainThread();
+  }
+
+  // Sends a command to |session_id|, or to the session of the pipe when it is
+  // empty. Returns the result, or nothing if the command failed.
+  std::optional<base::Value::Dict> SendCommand(
+      std::string_view method,
+      base::Value::Dict params = base::Value::Dict(),
+      std::string_view session_id = std::string_view()) {
+    const int id = ++last_command_id_;
+    base::Value::Dict command;
+    command.Set("id", id);
+    command.Set("method", method);
+    command.Set("params", std::move(params));
+    if (!session_id.empty()) {
+      command.Set("sessionId", session_id);
+    }
+    std::optional<std::string> json = base::WriteJson(command);
+    CHECK(json);
+    json->push_back('\0');
+    {
+      base::ScopedAllowBlockingForTesting allow_blocking;
+      CHECK(base::WriteFileDescriptor(write_fd_.get(), *json));
+    }
+
+    base::Value::Dict response =
+        WaitForMessage([id](const base::Value::Dict& message) {
+          return message.FindInt("id") == id;
+        });
+    base::Value::Dict* result = response.FindDict("result");
+    if (!result) {
+      return std::nullopt;
+    }
+    return std::move(*result);
+  }
+
+  // Waits for an event named |method|, and returns its params.
+  base::Value::Dict WaitForNotification(std::string_view method) {
+    base::Value::Dict notification =
+        WaitForMessage([method](const base::Value::Dict& message) {
+          const std::string* name = message.FindString("method");
+          return name && *name == method;
+        });
+    base::Value::Dict* params = notification.FindDict("params");
+    return params ? std::move(*params) : base::Value::Dict();
+  }
+
+  // Returns the test histogram as reported by getHistograms.
+  base::Value::Dict GetHistogram(
+      bool delta,
+      std::string_view session_id = std::string_view()) {
+    std::optional<base::Value::Dict> result = SendCommand(
+        "RadiumPerformance.getHistograms",
+        base::Value::Dict().Set("query", kHistogramName).Set("delta", delta),
+        session_id);
+    if (!result) {
+      ADD_FAILURE() << "getHistograms failed";
+      return base::Value::Dict();
+    }
+    const base::Value::List* histograms = result->FindList("histograms");
+    if (!histograms || histograms->size() != 1u) {
+      ADD_FAILURE() << "Expected one histogram";
+      return base::Value::Dict();
+    }
+    return (*histograms)[0].GetDict().Clone();
+  }
+
+ private:
+  void OnMessage(std::string json) {
+    std::optional<base::Value::Dict> message = base::JSONReader::ReadDict(json);
+    ASSERT_TRUE(message) << json;
+    messages_.push_back(std::move(*message));
+    if (quit_closure_) {
+      std::move(quit_closure_).Run();
+    }
+  }
+
+  // Removes and returns the first message that |predicate| accepts, waiting
+  // for it if needed. Other messages stay for later waits.
+  base::Value::Dict WaitForMessage(
+      base::FunctionRef<bool(const base::Value::Dict&)> predicate) {
+    while (true) {
+      auto it = std::ranges::find_if(
+          messages_,
+          [&](const base::Value::Dict& message) { return predicate(message); });
+      if (it != messages_.end()) {
+        base::Value::Dict message = std::move(*it);
+        messages_.erase(it);
+        return message;
+      }
+      base::RunLoop run_loop;
+      quit_closure_ = run_loop.QuitClosure();
+      run_loop.Run();
+    }
+  }
+
+  base::ScopedFD write_fd_;
+  // Handed to |reader_| once the browser runs.
+  base::ScopedFD read_fd_;
+  base::Thread reader_thread_{"DevToolsPipeReader"};
+  base::SequenceBound<PipeReader> reader_;
+  std::vector<base::Value::Dict> messages_;
+  base::OnceClosure quit_closure_;
+  int last_command_id_ = 0;
+};
+
+IN_PROC_BROWSER_TEST_F(RadiumPerformanceHandlerBrowserTest, GetSnapshot) {
+  std::optional<base::Value::Dict> result =
+      SendCommand("RadiumPerformance.getSnapshot");
+  ASSERT_TRUE(result);
+  const base::Value::Dict* snapshot = result->FindDict("snapshot");
+  ASSERT_TRUE(snapshot);
+  EXPECT_GE(snapshot->FindInt("rendererCount").value_or(0), 1);
+  const base::Value::List* profiles = snapshot->FindList("profiles");
+  ASSERT_TRUE(profiles);
+  EXPECT_FALSE(profiles->empty());
+  const base::Value::List* web_contents = snapshot->FindList("webContents");
+  ASSERT_TRUE(web_contents);
+  ASSERT_FALSE(web_contents->empty());
+  EXPECT_TRUE((*web_contents)[0].GetDict().FindString("targetId"));
+}
+
+// Deltas are relative to what the session last reported, and leave the
+// samples of the UMA upload alone.
+IN_PROC_BROWSER_TEST_F(RadiumPerformanceHandlerBrowserTest,
+                       GetHistogramsDelta) {
+  base::UmaHistogramCounts100(kHistogramName, 5);
+  base::Value::Dict histogram = GetHistogram(/*delta=*/true);
+  EXPECT_EQ(1, histogram.FindInt("count"));
+  EXPECT_EQ(5, histogram.FindDouble("sum"));
+
+  base::UmaHistogramCounts100(kHistogramName, 7);
+  histogram = GetHistogram(/*delta=*/true);
+  EXPECT_EQ(1, histogram.FindInt("count"));
+  EXPECT_EQ(7, histogram.FindDouble("sum"));
+
+  histogram = GetHistogram(/*delta=*/true);
+  EXPECT_EQ(0, histogram.FindInt("count"));
+
+  histogram = GetHistogram(/*delta=*/false);
+  EXPECT_EQ(2, histogram.FindInt("count"));
+  EXPECT_EQ(12, histogram.FindDouble("sum"));
+
+  base::HistogramBase* uma_histogram =
+      base::StatisticsRecorder::FindHistogram(kHistogramName);
+  ASSERT_TRUE(uma_histogram);
+  EXPECT_EQ(2, uma_histogram->SnapshotDelta()->TotalCount());
+
+  // A new session starts from all the samples.
+  std::optional<base::Value::Dict> attached =
+      SendCommand("Target.attachToBrowserTarget");
+  ASSERT_TRUE(attached);
+  const std::string* session_id = attached->FindString("sessionId");
+  ASSERT_TRUE(session_id);
+  histogram = GetHistogram(/*delta=*/true, *session_id);
+  EXPECT_EQ(2, histogram.FindInt("count"));
+}
+
+IN_PROC_BROWSER_TEST_F(RadiumPerformanceHandlerBrowserTest, StreamsSnapshots) {
+  ASSERT_TRUE(SendCommand("RadiumPerformance.startStreaming",
+                          base::Value::Dict().Set("interval", 100)));
+  base::Value::Dict params =
+      WaitForNotification("RadiumPerformance.snapshotTaken");
+  EXPECT_TRUE(params.FindDict("snapshot"));
+  ASSERT_TRUE(SendCommand("RadiumPerformance.stopStreaming"));
+}
@@ -0,0 +1,68 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/devtools/protocol/target_handler.h"
+
+#include "base/strings/strcat.h"
+#include "content/public/browser/devtools_agent_host.h"
+#include "radium/browser/devtools/devtools_browser_context_manager.h"
+#include "radium/browser/devtools/radium_devtools_manager_delegate.h"
+#include "url/gurl.h"
+#include "url/url_constants.h"
+
+TargetHandler::TargetHandler(protocol::UberDispatcher* dispatcher) {
+  protocol::Target::Dispatcher::wire(dispatcher, this);
+}
+
+TargetHandler::~TargetHandler() = default;
+
+protocol::Response TargetHandler::SetRemoteLocations(
+    std::unique_ptr<protocol::Array<protocol::Target::RemoteLocation>>
+        in_locations) {
+  return protocol::Response::FallThrough();
+}
+
+protocol::Response TargetHandler::CreateTarget(
+    const std::string& in_url,
+    std::optional<int> in_left,
+    std::optional<int> in_top,
+    std::optional<int> in_width,
+    std::optional<int> in_height,
+    std::optional<std::string> in_window_state,
+    std::optional<std::string> in_browser_context_id,
+    std::optional<bool> in_enable_begin_frame_control,
+    std::optional<bool> in_new_window,
+    std::optional<bool> in_background,
+    std::optional<bool> in_for_tab,
+    std::optional<bool> in_hidden,
+    std::string* out_target_id) {
+  // Content creates the targets of the default browser context through
+  // RadiumDevToolsManagerDelegate::CreateNewTarget().
+  if (!in_browser_context_id) {
+    return protocol::Response::FallThrough();
+  }
+
+  Profile* profile = DevToolsBrowserContextManager::GetInstance()
+                         .GetBrowserContext(*in_browser_context_id);
+  if (!profile) {
+    return protocol::Response::InvalidParams(base::StrCat(
+        {"Failed to find browser context with id ", *in_browser_context_id}));
+  }
+
+  GURL url(in_url);
+  if (in_url.empty()) {
+    url = GURL(url::kAboutBlankURL);
+  }
+  scoped_refptr<content::DevToolsAgentHost> agent_host =
+      RadiumDevToolsManagerDelegate::CreateNewTargetForProfile(
+          profile, url,
+          in_for_tab.value_or(false)
+              ? content::DevToolsManagerDelegate::TargetType::kTab
+              : content::DevToolsManagerDelegate::TargetType::kPage);
+  if (!agent_host) {
+    return protocol::Response::ServerError("Failed to open a new window");
+  }
+  *out_target_id = agent_host->GetId();
+  return protocol::Response::Success();
+}
@@ -0,0 +1,44 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_DEVTOOLS_PROTOCOL_TARGET_HANDLER_H_
+#define RADIUM_BROWSER_DEVTOOLS_PROTOCOL_TARGET_HANDLER_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "radium/browser/devtools/protocol/target.h"
+
+// Creates pages in the browser contexts of DevToolsBrowserContextManager.
+// Everything else falls through to content's Target domain.
+class TargetHandler : public protocol::Target::Backend {
+ public:
+  explicit TargetHandler(protocol::UberDispatcher* dispatcher);
+  TargetHandler(const TargetHandler&) = delete;
+  TargetHandler& operator=(const TargetHandler&) = delete;
+
+  ~TargetHandler() override;
+
+  // protocol::Target::Backend:
+  protocol::Response SetRemoteLocations(
+      std::unique_ptr<protocol::Array<protocol::Target::RemoteLocation>>
+          in_locations) override;
+  protocol::Response CreateTarget(
+      const std::string& in_url,
+      std::optional<int> in_left,
+      std::optional<int> in_top,
+      std::optional<int> in_width,
+      std::optional<int> in_height,
+      std::optional<std::string> in_window_state,
+      std::optional<std::string> in_browser_context_id,
+      std::optional<bool> in_enable_begin_frame_control,
+      std::optional<bool> in_new_window,
+      std::optional<bool> in_background,
+      std::optional<bool> in_for_tab,
+      std::optional<bool> in_hidden,
+      std::string* out_target_id) override;
+};
+
+#endif  // RADIUM_BROWSER_DEVTOOLS_PROTOCOL_TARGET_HANDLER_H_
@@ -0,0 +1,89 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "content/public/browser/devtools_agent_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "content/public/test/test_devtools_protocol_client.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// Opens pages in the browser contexts of Target.createBrowserContext, which
+// are off-the-record profiles of the default profile.
+class TargetHandlerBrowserTest : public RadiumBrowserTest,
+                                 public content::TestDevToolsProtocolClient {
+ protected:
+  void PreRunTestOnMainThread() override {
+    RadiumBrowserTest::PreRunTestOnMainThread();
+    AttachToBrowserTarget();
+  }
+
+  void PostRunTestOnMainThread() override {
+    DetachProtocolClient();
+    RadiumBrowserTest::PostRunTestOnMainThread();
+  }
+
+  ProfileManager* profile_manager() {
+    return BrowserProcess::Get()->GetFeatures()->profile_manager();
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(TargetHandlerBrowserTest,
+                       CreatesTargetInBrowserContext) {
+  const base::Value::Dict* result =
+      SendCommandSync("Target.createBrowserContext");
+  ASSERT_TRUE(result);
+  const std::string* context_id = result->FindString("browserContextId");
+  ASSERT_TRUE(context_id);
+  const std::string browser_context_id = *context_id;
+
+  const GURL url(radium::kRadiumUIExampleURL);
+  result = SendCommandSync(
+      "Target.createTarget",
+      base::Value::Dict()
+          .Set("url", url.spec())
+          .Set("browserContextId", browser_context_id));
+  ASSERT_TRUE(result);
+  const std::string* target_id = result->FindString("targetId");
+  ASSERT_TRUE(target_id);
+
+  scoped_refptr<content::DevToolsAgentHost> agent_host =
+      content::DevToolsAgentHost::GetForId(*target_id);
+  ASSERT_TRUE(agent_host);
+  content::WebContents* web_contents = agent_host->GetWebContents();
+  ASSERT_TRUE(web_contents);
+  EXPECT_TRUE(content::WaitForLoadStop(web_contents));
+  EXPECT_EQ(url, web_contents->GetLastCommittedURL());
+
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+  EXPECT_TRUE(profile->IsOffTheRecord());
+  EXPECT_EQ(browser_context_id, profile->UniqueId());
+  // The ProfileManager only knows the original profile, whose path the
+  // off-the-record profile shares.
+  Profile* original_profile = profile->GetOriginalProfile();
+  const base::FilePath path = original_profile->GetPath();
+  EXPECT_EQ(original_profile, profile_manager()->GetProfileByPath(path));
+
+  base::WeakPtr<content::WebContents> weak_web_contents =
+      web_contents->GetWeakPtr();
+  ASSERT_TRUE(SendCommandSync(
+      "Target.disposeBrowserContext",
+      base::Value::Dict().Set("browserContextId", browser_context_id)));
+  EXPECT_FALSE(weak_web_contents);
+  EXPECT_EQ(original_profile, profile_manager()->GetProfileByPath(path));
+}
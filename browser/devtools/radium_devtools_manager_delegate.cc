@@ -6,10 +6,17 @@
 
 #include "components/keep_alive_registry/scoped_keep_alive.h"
 #include "content/public/browser/devtools_agent_host.h"
+#include "content/public/browser/navigation_controller.h"
 #include "content/public/browser/web_contents.h"
 #include "radium/browser/devtools/devtools_browser_context_manager.h"
 #include "radium/browser/devtools/radium_devtools_session.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/gallery/gallery_window_factory.h"
+#include "ui/base/page_transition_types.h"
 #include "ui/views/controls/webview/webview.h"
+#include "url/gurl.h"
 
 namespace {
 RadiumDevToolsManagerDelegate* g_instance = nullptr;
@@ -27,6 +34,25 @@ void RadiumDevToolsManagerDelegate::AllowBrowserToClose() {
   }
 }
 
+// static
+scoped_refptr<content::DevToolsAgentHost>
+RadiumDevToolsManagerDelegate::CreateNewTargetForProfile(
+    Profile* profile,
+    const GURL& url,
+    TargetType target_type) {
+  Browser* browser = CreateGalleryBrowser(profile);
+  if (browser->tabs().empty()) {
+    return nullptr;
+  }
+  content::WebContents* web_contents = browser->tabs().begin()->get();
+  content::NavigationController::LoadURLParams params(url);
+  params.transition_type = ui::PAGE_TRANSITION_AUTO_TOPLEVEL;
+  web_contents->GetController().LoadURLWithParams(params);
+  return target_type == TargetType::kTab
+             ? content::DevToolsAgentHost::GetOrCreateForTab(web_contents)
+             : content::DevToolsAgentHost::GetOrCreateFor(web_contents);
+}
+
 RadiumDevToolsManagerDelegate::RadiumDevToolsManagerDelegate() {
   DCHECK(!g_instance);
   g_instance = this;
@@ -92,12 +118,15 @@ RadiumDevToolsManagerDelegate::GetDefaultBrowserContext() {
 }
 
 content::BrowserContext* RadiumDevToolsManagerDelegate::CreateBrowserContext() {
-  return nullptr;
+  return DevToolsBrowserContextManager::GetInstance().CreateBrowserContext();
 }
 
 void RadiumDevToolsManagerDelegate::DisposeBrowserContext(
-    content::BrowserContext*,
-    DisposeCallback callback) {}
+    content::BrowserContext* context,
+    DisposeCallback callback) {
+  DevToolsBrowserContextManager::GetInstance().DisposeBrowserContext(
+      context, std::move(callback));
+}
 
 bool RadiumDevToolsManagerDelegate::AllowInspectingRenderFrameHost(
     content::RenderFrameHost* rfh) {
@@ -119,7 +148,10 @@ scoped_refptr<content::DevToolsAgentHost>
 RadiumDevToolsManagerDelegate::CreateNewTarget(const GURL& url,
                                                TargetType target_type,
                                                bool new_window) {
-  return nullptr;
+  // Every page has its own window.
+  return CreateNewTargetForProfile(
+      ProfileManager::GetLastUsedProfile()->GetOriginalProfile(), url,
+      target_type);
 }
 
 bool RadiumDevToolsManagerDelegate::HasBundledFrontendResources() {
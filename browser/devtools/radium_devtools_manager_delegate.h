@@ -9,6 +9,7 @@
 
 #include "content/public/browser/devtools_manager_delegate.h"
 
+class Profile;
 class RadiumDevToolsSession;
 class ScopedKeepAlive;
 
@@ -26,6 +27,12 @@ class RadiumDevToolsManagerDelegate : public content::DevToolsManagerDelegate {
   // Release browser keep alive allowing browser to close.
   static void AllowBrowserToClose();
 
+  // Opens |url| in a new window of |profile| and returns its DevTools target.
+  static scoped_refptr<content::DevToolsAgentHost> CreateNewTargetForProfile(
+      Profile* profile,
+      const GURL& url,
+      TargetType target_type);
+
  private:
   // content::DevToolsManagerDelegate implementation.
   void Inspect(content::DevToolsAgentHost* agent_host) override;
@@ -4,11 +4,24 @@
 
 #include "radium/browser/devtools/radium_devtools_session.h"
 
+#include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/devtools_agent_host_client_channel.h"
+#include "radium/browser/devtools/protocol/radium_performance_handler.h"
+#include "radium/browser/devtools/protocol/target_handler.h"
 
 RadiumDevToolsSession::RadiumDevToolsSession(
     content::DevToolsAgentHostClientChannel* channel)
-    : dispatcher_(this), client_channel_(channel) {}
+    : dispatcher_(this), client_channel_(channel) {
+  // The performance data is about the whole browser and the browser contexts
+  // are managed from the browser target, so these domains are only exposed on
+  // it.
+  if (channel->GetAgentHost()->GetType() ==
+      content::DevToolsAgentHost::kTypeBrowser) {
+    performance_handler_ =
+        std::make_unique<RadiumPerformanceHandler>(&dispatcher_);
+    target_handler_ = std::make_unique<TargetHandler>(&dispatcher_);
+  }
+}
 
 RadiumDevToolsSession::~RadiumDevToolsSession() = default;
 
@@ -5,9 +5,14 @@
 #ifndef RADIUM_BROWSER_DEVTOOLS_RADIUM_DEVTOOLS_SESSION_H_
 #define RADIUM_BROWSER_DEVTOOLS_RADIUM_DEVTOOLS_SESSION_H_
 
+#include <memory>
+
 #include "content/public/browser/devtools_manager_delegate.h"
 #include "radium/browser/devtools/protocol/protocol.h"
 
+class RadiumPerformanceHandler;
+class TargetHandler;
+
 namespace content {
 class DevToolsAgentHostClientChannel;
 }  // namespace content
@@ -43,6 +48,9 @@ class RadiumDevToolsSession : public protocol::FrontendChannel {
 
   protocol::UberDispatcher dispatcher_;
   raw_ptr<content::DevToolsAgentHostClientChannel> client_channel_;
+
+  std::unique_ptr<RadiumPerformanceHandler> performance_handler_;
+  std::unique_ptr<TargetHandler> target_handler_;
 };
 
 #endif  // RADIUM_BROWSER_DEVTOOLS_RADIUM_DEVTOOLS_SESSION_H_
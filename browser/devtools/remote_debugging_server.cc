@@ -5,6 +5,7 @@
 #include "radium/browser/devtools/remote_debugging_server.h"
 
 #include "base/command_line.h"
+#include "base/functional/bind.h"
 #include "base/path_service.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/devtools_agent_host.h"
@@ -14,6 +15,7 @@
 #include "net/socket/tcp_server_socket.h"
 #include "radium/browser/browser_process.h"
 #include "radium/browser/global_features.h"
+#include "radium/browser/lifetime/application_lifetime.h"
 #include "radium/common/pref_names.h"
 #include "radium/common/radium_paths.h"
 #include "radium/common/radium_paths_internal.h"
@@ -106,6 +108,13 @@ RemoteDebuggingServer::GetInstance(PrefService* local_state) {
         base::FilePath());
   }
 
+  if (command_line.HasSwitch(::switches::kRemoteDebuggingPipe)) {
+    being_debugged = true;
+    // The client owns the browser: closing the pipe closes the browser.
+    content::DevToolsAgentHost::StartRemoteDebuggingPipeHandler(
+        base::BindOnce(&radium::AttemptExit));
+  }
+
   if (being_debugged) {
     return base::WrapUnique(new RemoteDebuggingServer);
   }
@@ -9,7 +9,10 @@
 #include "base/check_is_test.h"
 #include "base/memory/ptr_util.h"
 #include "base/no_destructor.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/net/http_cache_size_manager.h"
 #include "radium/browser/profiles/profile_manager.h"
+#include "radium/browser/ui/webui/webui_process_model.h"
 
 namespace {
 
@@ -37,4 +40,10 @@ GlobalFeatures::~GlobalFeatures() = default;
 
 void GlobalFeatures::Init() {
   profile_manager_ = ProfileManager::Create();
+  webui_process_model_ = std::make_unique<WebUIProcessModel>();
+  http_cache_size_manager_ =
+      HttpCacheSizeManager::Create(BrowserProcess::Get()->local_state());
+  if (http_cache_size_manager_) {
+    http_cache_size_manager_->Start();
+  }
 }
@@ -10,7 +10,9 @@
 #include "base/functional/callback.h"
 #include "build/build_config.h"
 
+class HttpCacheSizeManager;
 class ProfileManager;
+class WebUIProcessModel;
 
 class GlobalFeatures {
  public:
@@ -31,9 +33,18 @@ class GlobalFeatures {
   void Init();
 
   ProfileManager* profile_manager() const { return profile_manager_.get(); }
+  WebUIProcessModel* webui_process_model() const {
+    return webui_process_model_.get();
+  }
+  // Null if features::kAdaptiveHttpCacheSize is disabled.
+  HttpCacheSizeManager* http_cache_size_manager() const {
+    return http_cache_size_manager_.get();
+  }
 
  private:
   std::unique_ptr<ProfileManager> profile_manager_;
+  std::unique_ptr<WebUIProcessModel> webui_process_model_;
+  std::unique_ptr<HttpCacheSizeManager> http_cache_size_manager_;
 };
 
 #endif  // RADIUM_BROWSER_GLOBAL_FEATURES_H_
@@ -0,0 +1,43 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/high_dpi_resource_pak_loader.h"
+
+#include <utility>
+
+#include "ui/display/display.h"
+
+HighDpiResourcePakLoader::HighDpiResourcePakLoader(display::Screen* screen,
+                                                   base::OnceClosure load_pak)
+    : load_pak_(std::move(load_pak)) {
+  for (const display::Display& display : screen->GetAllDisplays()) {
+    MaybeLoad(display);
+  }
+  if (!loaded()) {
+    screen_observation_.Observe(screen);
+  }
+}
+
+HighDpiResourcePakLoader::~HighDpiResourcePakLoader() = default;
+
+void HighDpiResourcePakLoader::OnDisplayAdded(
+    const display::Display& new_display) {
+  MaybeLoad(new_display);
+}
+
+void HighDpiResourcePakLoader::OnDisplayMetricsChanged(
+    const display::Display& display,
+    uint32_t changed_metrics) {
+  if (changed_metrics & DISPLAY_METRIC_DEVICE_SCALE_FACTOR) {
+    MaybeLoad(display);
+  }
+}
+
+void HighDpiResourcePakLoader::MaybeLoad(const display::Display& display) {
+  if (loaded() || display.device_scale_factor() <= kMinDeviceScaleFactor) {
+    return;
+  }
+  std::move(load_pak_).Run();
+  screen_observation_.Reset();
+}
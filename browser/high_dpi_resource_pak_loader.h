@@ -0,0 +1,53 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_HIGH_DPI_RESOURCE_PAK_LOADER_H_
+#define RADIUM_BROWSER_HIGH_DPI_RESOURCE_PAK_LOADER_H_
+
+#include <stdint.h>
+
+#include "base/functional/callback.h"
+#include "base/scoped_observation.h"
+#include "ui/display/display_observer.h"
+#include "ui/display/screen.h"
+
+// Runs a callback that loads the 2x resource pak once a display with a
+// device scale factor above kMinDeviceScaleFactor is attached, so that the
+// browser doesn't load it on 1x displays. Displays already attached count,
+// which includes --force-device-scale-factor.
+//
+// Images whose 2x representation was asked for before the pak is loaded keep
+// their 1x bitmap scaled up, since ui::ResourceBundle caches representations
+// and can't drop them. Create the loader before any window exists: display
+// observers are notified in order, so the pak is then added before views
+// repaint at the new scale factor.
+class HighDpiResourcePakLoader : public display::DisplayObserver {
+ public:
+  static constexpr float kMinDeviceScaleFactor = 1.5f;
+
+  HighDpiResourcePakLoader(display::Screen* screen,
+                           base::OnceClosure load_pak);
+  HighDpiResourcePakLoader(const HighDpiResourcePakLoader&) = delete;
+  HighDpiResourcePakLoader& operator=(const HighDpiResourcePakLoader&) =
+      delete;
+
+  ~HighDpiResourcePakLoader() override;
+
+  bool loaded() const { return !load_pak_; }
+
+  // display::DisplayObserver:
+  void OnDisplayAdded(const display::Display& new_display) override;
+  void OnDisplayMetricsChanged(const display::Display& display,
+                               uint32_t changed_metrics) override;
+
+ private:
+  void MaybeLoad(const display::Display& display);
+
+  base::OnceClosure load_pak_;
+
+  base::ScopedObservation<display::Screen, display::DisplayObserver>
+      screen_observation_{this};
+};
+
+#endif  // RADIUM_BROWSER_HIGH_DPI_RESOURCE_PAK_LOADER_H_
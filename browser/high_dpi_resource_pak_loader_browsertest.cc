@@ -0,0 +1,67 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/high_dpi_resource_pak_loader.h"
+
+#include "base/command_line.h"
+#include "base/functional/bind.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/radium_resource_bundle_helper.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/display/display.h"
+#include "ui/display/display_observer.h"
+#include "ui/display/display_switches.h"
+#include "ui/display/screen.h"
+
+class HighDpiResourcePakLoaderBrowserTest : public RadiumBrowserTest {
+ protected:
+  void SetDeviceScaleFactor(HighDpiResourcePakLoader& loader,
+                            float device_scale_factor) {
+    display::Display display =
+        display::Screen::GetScreen()->GetPrimaryDisplay();
+    display.set_device_scale_factor(device_scale_factor);
+    loader.OnDisplayMetricsChanged(
+        display,
+        display::DisplayObserver::DISPLAY_METRIC_DEVICE_SCALE_FACTOR);
+  }
+};
+
+// The headless display is 1x, so the 2x pak only gets loaded once the scale
+// factor of the display goes above 1.5.
+IN_PROC_BROWSER_TEST_F(HighDpiResourcePakLoaderBrowserTest,
+                       LoadsOnHighDpiDisplay) {
+  ASSERT_FALSE(IsHighDpiResourcePakLoaded());
+  HighDpiResourcePakLoader loader(display::Screen::GetScreen(),
+                                  base::BindOnce(&LoadHighDpiResourcePak));
+  EXPECT_FALSE(loader.loaded());
+
+  SetDeviceScaleFactor(loader, 1.25f);
+  EXPECT_FALSE(loader.loaded());
+  EXPECT_FALSE(IsHighDpiResourcePakLoaded());
+
+  SetDeviceScaleFactor(loader, 2.0f);
+  EXPECT_TRUE(loader.loaded());
+  EXPECT_TRUE(IsHighDpiResourcePakLoaded());
+
+  // The pak stays loaded when the display goes back to 1x.
+  SetDeviceScaleFactor(loader, 1.0f);
+  EXPECT_TRUE(IsHighDpiResourcePakLoaded());
+}
+
+class HighDpiResourcePakLoaderForcedScaleBrowserTest
+    : public HighDpiResourcePakLoaderBrowserTest {
+ protected:
+  // content::BrowserTestBase:
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    command_line->AppendSwitchASCII(switches::kForceDeviceScaleFactor, "2");
+  }
+};
+
+// A display that is high DPI from the start gets the pak before the first
+// window is shown.
+IN_PROC_BROWSER_TEST_F(HighDpiResourcePakLoaderForcedScaleBrowserTest,
+                       LoadsAtStartup) {
+  EXPECT_TRUE(IsHighDpiResourcePakLoaded());
+}
@@ -11,13 +11,14 @@
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "components/language/core/browser/pref_names.h"
-#include "components/prefs/json_pref_store.h"
+#include "components/prefs/persistent_pref_store.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/pref_service_factory.h"
 #include "content/child/field_trial.h"
 #include "radium/browser/browser_prefs.h"
 #include "radium/browser/policy/radium_browser_policy_connector.h"
+#include "radium/browser/prefs/binary_pref_store.h"
 #include "radium/browser/radium_browser_field_trials.h"
 #include "radium/common/radium_paths.h"
 
@@ -58,8 +59,11 @@ void RadiumFeatureListCreator::CreatePrefService() {
   // ManagementService needs Local State but creating local state needs
   // ManagementService, instantiate the underlying PrefStore early and share it
   // between both.
-  auto local_state_pref_store =
-      base::MakeRefCounted<JsonPrefStore>(local_state_file);
+  // Local State is read before the FeatureList exists, so the binary store can
+  // only be selected with a switch.
+  scoped_refptr<PersistentPrefStore> local_state_pref_store =
+      CreatePersistentPrefStore(local_state_file, nullptr,
+                                /*read_async=*/false);
 
   PrefServiceFactory pref_service_factory;
   pref_service_factory.set_user_prefs(local_state_pref_store);
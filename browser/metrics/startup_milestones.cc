@@ -0,0 +1,36 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/metrics/startup_milestones.h"
+
+#include <algorithm>
+
+#include "base/no_destructor.h"
+
+namespace startup_milestones {
+
+namespace {
+
+std::vector<Milestone>& GetMilestones() {
+  static base::NoDestructor<std::vector<Milestone>> milestones;
+  return *milestones;
+}
+
+}  // namespace
+
+void Record(std::string_view name) {
+  std::vector<Milestone>& milestones = GetMilestones();
+  if (std::ranges::any_of(milestones, [name](const Milestone& milestone) {
+        return milestone.name == name;
+      })) {
+    return;
+  }
+  milestones.push_back({std::string(name), base::TimeTicks::Now()});
+}
+
+const std::vector<Milestone>& Get() {
+  return GetMilestones();
+}
+
+}  // namespace startup_milestones
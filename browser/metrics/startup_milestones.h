@@ -0,0 +1,33 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_METRICS_STARTUP_MILESTONES_H_
+#define RADIUM_BROWSER_METRICS_STARTUP_MILESTONES_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/time/time.h"
+
+// Keeps the time at which the browser process reached the milestones of its
+// startup, so that they can be queried after the fact, e.g. over DevTools.
+// Only used on the UI thread.
+namespace startup_milestones {
+
+struct Milestone {
+  std::string name;
+  base::TimeTicks time;
+};
+
+// Records that startup reached |name| now. Only the first time a milestone is
+// reached is kept.
+void Record(std::string_view name);
+
+// Returns the milestones reached so far, in the order they were reached.
+const std::vector<Milestone>& Get();
+
+}  // namespace startup_milestones
+
+#endif  // RADIUM_BROWSER_METRICS_STARTUP_MILESTONES_H_
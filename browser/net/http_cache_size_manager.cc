@@ -0,0 +1,195 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/net/http_cache_size_manager.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "base/feature_list.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/path_service.h"
+#include "base/system/sys_info.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/histogram_fetcher.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/common/pref_names.h"
+#include "radium/common/radium_features.h"
+#include "radium/common/radium_paths.h"
+#include "radium/common/radium_paths_internal.h"
+
+namespace {
+
+// Recorded by the network service for each HTTP cache transaction, with the
+// values of net::HttpCache::Transaction::CachePattern.
+constexpr char kCachePatternHistogram[] = "HttpCache.Pattern";
+enum CachePattern {
+  kEntryNotCached = 2,
+  kEntryUsed = 3,
+  kEntryValidated = 4,
+  kEntryUpdated = 5,
+  kEntryCantConditionalize = 6,
+};
+
+// How long to wait for child processes to send their histograms.
+constexpr base::TimeDelta kFetchHistogramsTimeout = base::Seconds(10);
+
+int64_t GetFreeDiskSpace(const base::FilePath& path) {
+  // The cache directory is only created with the first cache entry.
+  base::FilePath existing_path = path;
+  while (!base::PathExists(existing_path) &&
+         existing_path != existing_path.DirName()) {
+    existing_path = existing_path.DirName();
+  }
+  return base::SysInfo::AmountOfFreeDiskSpace(existing_path);
+}
+
+size_t GetOnDiskProfileCount() {
+  ProfileManager* profile_manager =
+      BrowserProcess::Get()->GetFeatures()->profile_manager();
+  return std::ranges::count_if(
+      profile_manager->GetLoadedProfiles(),
+      [](Profile* profile) { return !profile->IsOffTheRecord(); });
+}
+
+HttpCacheSizePolicy::CacheStats ReadCacheStats() {
+  HttpCacheSizePolicy::CacheStats stats;
+  base::HistogramBase* histogram =
+      base::StatisticsRecorder::FindHistogram(kCachePatternHistogram);
+  if (!histogram) {
+    return stats;
+  }
+  std::unique_ptr<base::HistogramSamples> samples =
+      histogram->SnapshotSamples();
+  stats.hits = samples->GetCount(kEntryUsed) +
+               samples->GetCount(kEntryValidated);
+  stats.misses = samples->GetCount(kEntryNotCached) +
+                 samples->GetCount(kEntryUpdated) +
+                 samples->GetCount(kEntryCantConditionalize);
+  return stats;
+}
+
+void GetCacheStats(
+    base::OnceCallback<void(const HttpCacheSizePolicy::CacheStats&)>
+        callback) {
+  // The network service usually runs in its own process.
+  content::FetchHistogramsAsynchronously(
+      base::SequencedTaskRunner::GetCurrentDefault(),
+      base::BindOnce(
+          [](base::OnceCallback<void(const HttpCacheSizePolicy::CacheStats&)>
+                 callback) { std::move(callback).Run(ReadCacheStats()); },
+          std::move(callback)),
+      kFetchHistogramsTimeout);
+}
+
+std::optional<double> GetBudgetHitRate(PrefService* local_state) {
+  const double hit_rate =
+      local_state->GetDouble(prefs::kHttpCacheBudgetHitRate);
+  if (hit_rate < 0) {
+    return std::nullopt;
+  }
+  return hit_rate;
+}
+
+base::FilePath GetCacheDir(PrefService* local_state) {
+  base::FilePath cache_dir = local_state->GetFilePath(prefs::kDiskCacheDir);
+  if (!cache_dir.empty()) {
+    return cache_dir;
+  }
+  base::FilePath user_data_dir;
+  base::PathService::Get(radium::DIR_USER_DATA, &user_data_dir);
+  radium::GetUserCacheDirectory(user_data_dir, &cache_dir);
+  return cache_dir;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<HttpCacheSizeManager> HttpCacheSizeManager::Create(
+    PrefService* local_state) {
+  if (!base::FeatureList::IsEnabled(features::kAdaptiveHttpCacheSize)) {
+    return nullptr;
+  }
+  return std::make_unique<HttpCacheSizeManager>(
+      local_state, GetCacheDir(local_state),
+      base::BindRepeating(&GetFreeDiskSpace),
+      base::BindRepeating(&GetOnDiskProfileCount),
+      base::BindRepeating(&GetCacheStats));
+}
+
+// static
+void HttpCacheSizeManager::RegisterPrefs(PrefRegistrySimple* registry) {
+  registry->RegisterIntegerPref(prefs::kHttpCacheProfileBudget, 0);
+  registry->RegisterDoublePref(prefs::kHttpCacheBudgetHitRate, -1.0);
+}
+
+HttpCacheSizeManager::HttpCacheSizeManager(
+    PrefService* local_state,
+    base::FilePath cache_dir,
+    FreeDiskSpaceGetter free_disk_space_getter,
+    ProfileCountGetter profile_count_getter,
+    CacheStatsGetter cache_stats_getter)
+    : local_state_(local_state),
+      cache_dir_(std::move(cache_dir)),
+      free_disk_space_getter_(std::move(free_disk_space_getter)),
+      profile_count_getter_(std::move(profile_count_getter)),
+      cache_stats_getter_(std::move(cache_stats_getter)),
+      policy_(local_state->GetInteger(prefs::kHttpCacheProfileBudget),
+              GetBudgetHitRate(local_state)) {}
+
+HttpCacheSizeManager::~HttpCacheSizeManager() = default;
+
+void HttpCacheSizeManager::Start() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  update_timer_.Start(FROM_HERE, kUpdateInterval, this,
+                      &HttpCacheSizeManager::Update);
+}
+
+int64_t HttpCacheSizeManager::GetProfileBudget() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return local_state_->GetInteger(prefs::kHttpCacheProfileBudget);
+}
+
+void HttpCacheSizeManager::Update() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  cache_stats_getter_.Run(base::BindOnce(&HttpCacheSizeManager::OnCacheStats,
+                                         weak_ptr_factory_.GetWeakPtr()));
+}
+
+void HttpCacheSizeManager::OnCacheStats(
+    const HttpCacheSizePolicy::CacheStats& stats) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(free_disk_space_getter_, cache_dir_),
+      base::BindOnce(&HttpCacheSizeManager::OnFreeDiskSpace,
+                     weak_ptr_factory_.GetWeakPtr(), stats));
+}
+
+void HttpCacheSizeManager::OnFreeDiskSpace(
+    const HttpCacheSizePolicy::CacheStats& stats,
+    int64_t free_disk_space) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  policy_.Update(free_disk_space, profile_count_getter_.Run(), stats);
+  local_state_->SetInteger(
+      prefs::kHttpCacheProfileBudget,
+      base::saturated_cast<int>(policy_.profile_budget()));
+  local_state_->SetDouble(prefs::kHttpCacheBudgetHitRate,
+                          policy_.budget_hit_rate().value_or(-1.0));
+}
@@ -0,0 +1,97 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_NET_HTTP_CACHE_SIZE_MANAGER_H_
+#define RADIUM_BROWSER_NET_HTTP_CACHE_SIZE_MANAGER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "radium/browser/net/http_cache_size_policy.h"
+
+class PrefRegistrySimple;
+class PrefService;
+
+// Feeds HttpCacheSizePolicy with measurements of the disk, the loaded
+// profiles and the HTTP cache hit rate every kUpdateInterval, and keeps the
+// resulting budget in Local State, along with the hit rate it was scaled
+// with so that the next session keeps the scaling until it measures its own.
+//
+// The network service cannot resize the cache of a live NetworkContext, so
+// the budget applies to the contexts created after it is computed, including
+// the ones of the next session.
+class HttpCacheSizeManager {
+ public:
+  static constexpr base::TimeDelta kUpdateInterval = base::Minutes(30);
+
+  // Returns the free space on the volume holding a path, or -1 on failure.
+  // Runs on a thread that may block.
+  using FreeDiskSpaceGetter =
+      base::RepeatingCallback<int64_t(const base::FilePath&)>;
+  // Returns the number of loaded profiles with an HTTP cache on disk.
+  using ProfileCountGetter = base::RepeatingCallback<size_t()>;
+  // Runs its argument with the cumulative HTTP cache lookups of all
+  // profiles.
+  using CacheStatsGetter = base::RepeatingCallback<void(
+      base::OnceCallback<void(const HttpCacheSizePolicy::CacheStats&)>)>;
+
+  // Returns a manager measuring the volume of the disk cache directory, the
+  // profiles of the ProfileManager and the HttpCache.Pattern histogram of the
+  // network service. Returns null if features::kAdaptiveHttpCacheSize is
+  // disabled.
+  static std::unique_ptr<HttpCacheSizeManager> Create(PrefService* local_state);
+
+  static void RegisterPrefs(PrefRegistrySimple* registry);
+
+  HttpCacheSizeManager(PrefService* local_state,
+                       base::FilePath cache_dir,
+                       FreeDiskSpaceGetter free_disk_space_getter,
+                       ProfileCountGetter profile_count_getter,
+                       CacheStatsGetter cache_stats_getter);
+  HttpCacheSizeManager(const HttpCacheSizeManager&) = delete;
+  HttpCacheSizeManager& operator=(const HttpCacheSizeManager&) = delete;
+  ~HttpCacheSizeManager();
+
+  // Updates the budget every kUpdateInterval. The first update has no hit
+  // rate yet, as it only takes a baseline of the cache stats, and scales the
+  // budget with the hit rate kept from the previous session.
+  void Start();
+
+  // Returns the budget for the HTTP cache of a profile, in bytes. 0 leaves
+  // the size to the network service.
+  int64_t GetProfileBudget() const;
+
+  // Runs an update right away.
+  void UpdateForTesting() { Update(); }
+
+ private:
+  void Update();
+  void OnCacheStats(const HttpCacheSizePolicy::CacheStats& stats);
+  void OnFreeDiskSpace(const HttpCacheSizePolicy::CacheStats& stats,
+                       int64_t free_disk_space);
+
+  const raw_ptr<PrefService> local_state_;
+  const base::FilePath cache_dir_;
+  const FreeDiskSpaceGetter free_disk_space_getter_;
+  const ProfileCountGetter profile_count_getter_;
+  const CacheStatsGetter cache_stats_getter_;
+
+  HttpCacheSizePolicy policy_;
+  base::RepeatingTimer update_timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<HttpCacheSizeManager> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_BROWSER_NET_HTTP_CACHE_SIZE_MANAGER_H_
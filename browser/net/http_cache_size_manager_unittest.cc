@@ -0,0 +1,203 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/net/http_cache_size_manager.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/functional/bind.h"
+#include "base/synchronization/lock.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "base/thread_annotations.h"
+#include "components/prefs/testing_pref_service.h"
+#include "radium/browser/net/http_cache_size_policy.h"
+#include "radium/common/pref_names.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int64_t kMB = 1024 * 1024;
+
+constexpr base::FilePath::CharType kMountPoint[] =
+    FILE_PATH_LITERAL("/mnt/cache");
+constexpr base::FilePath::CharType kCacheDir[] =
+    FILE_PATH_LITERAL("/mnt/cache/radium");
+
+// The volumes of a fake filesystem, keyed by mount point. Queried from the
+// thread pool.
+class FakeFileSystem {
+ public:
+  void SetFreeDiskSpace(const base::FilePath& mount_point, int64_t bytes) {
+    base::AutoLock lock(lock_);
+    free_disk_space_[mount_point] = bytes;
+  }
+
+  void Unmount(const base::FilePath& mount_point) {
+    base::AutoLock lock(lock_);
+    free_disk_space_.erase(mount_point);
+  }
+
+  // Returns the free space of the volume holding |path|, or -1 if there is
+  // none, like base::SysInfo::AmountOfFreeDiskSpace().
+  int64_t GetFreeDiskSpace(const base::FilePath& path) {
+    base::AutoLock lock(lock_);
+    for (base::FilePath current = path;; current = current.DirName()) {
+      auto it = free_disk_space_.find(current);
+      if (it != free_disk_space_.end()) {
+        return it->second;
+      }
+      if (current == current.DirName()) {
+        return -1;
+      }
+    }
+  }
+
+ private:
+  base::Lock lock_;
+  std::map<base::FilePath, int64_t> free_disk_space_ GUARDED_BY(lock_);
+};
+
+}  // namespace
+
+class HttpCacheSizeManagerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    HttpCacheSizeManager::RegisterPrefs(local_state_.registry());
+    file_system_.SetFreeDiskSpace(base::FilePath(kMountPoint), 1000 * kMB);
+    manager_ = CreateManager();
+    manager_->Start();
+  }
+
+  std::unique_ptr<HttpCacheSizeManager> CreateManager() {
+    return std::make_unique<HttpCacheSizeManager>(
+        &local_state_, base::FilePath(kCacheDir),
+        base::BindRepeating(&FakeFileSystem::GetFreeDiskSpace,
+                            base::Unretained(&file_system_)),
+        base::BindRepeating(
+            [](const size_t* profile_count) { return *profile_count; },
+            &profile_count_),
+        base::BindRepeating(
+            [](const HttpCacheSizePolicy::CacheStats* stats,
+               base::OnceCallback<void(
+                   const HttpCacheSizePolicy::CacheStats&)> callback) {
+              std::move(callback).Run(*stats);
+            },
+            &cache_stats_));
+  }
+
+  // Adds lookups to the cache stats and waits for the next update.
+  void RunPeriod(int64_t hits, int64_t misses) {
+    cache_stats_.hits += hits;
+    cache_stats_.misses += misses;
+    task_environment_.FastForwardBy(HttpCacheSizeManager::kUpdateInterval);
+    // Let the free disk space come back from the thread pool.
+    task_environment_.RunUntilIdle();
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::HistogramTester histogram_tester_;
+  TestingPrefServiceSimple local_state_;
+  FakeFileSystem file_system_;
+  size_t profile_count_ = 1;
+  HttpCacheSizePolicy::CacheStats cache_stats_;
+  std::unique_ptr<HttpCacheSizeManager> manager_;
+};
+
+TEST_F(HttpCacheSizeManagerTest, LeavesSizeToNetworkServiceUntilFirstUpdate) {
+  EXPECT_EQ(0, manager_->GetProfileBudget());
+
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+  histogram_tester_.ExpectUniqueSample("Radium.HttpCache.ProfileBudget", 100,
+                                       1);
+  histogram_tester_.ExpectTotalCount("Radium.HttpCache.HitRate", 0);
+}
+
+TEST_F(HttpCacheSizeManagerTest, FollowsFreeDiskSpaceAndProfileCount) {
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+
+  file_system_.SetFreeDiskSpace(base::FilePath(kMountPoint), 2000 * kMB);
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(200 * kMB, manager_->GetProfileBudget());
+
+  profile_count_ = 4;
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(50 * kMB, manager_->GetProfileBudget());
+}
+
+TEST_F(HttpCacheSizeManagerTest, KeepsBudgetWhenDiskIsUnavailable) {
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+
+  file_system_.Unmount(base::FilePath(kMountPoint));
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+}
+
+TEST_F(HttpCacheSizeManagerTest, RecordsHitRateDelta) {
+  // Baseline.
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+
+  // A 25% hit rate shrinks the budget to 75 MB. There is nothing to compare
+  // the hit rate with yet.
+  RunPeriod(/*hits=*/250, /*misses=*/750);
+  EXPECT_EQ(75 * kMB, manager_->GetProfileBudget());
+  histogram_tester_.ExpectUniqueSample("Radium.HttpCache.HitRate", 25, 1);
+
+  // This period ran at 75 MB after one at 100 MB.
+  RunPeriod(/*hits=*/500, /*misses=*/500);
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+  histogram_tester_.ExpectUniqueSample(
+      "Radium.HttpCache.HitRateDelta.BudgetDecreased", 25, 1);
+
+  // 100 MB after 75 MB.
+  RunPeriod(/*hits=*/400, /*misses=*/600);
+  histogram_tester_.ExpectUniqueSample(
+      "Radium.HttpCache.HitRateDelta.BudgetIncreased", -10, 1);
+
+  // 90 MB after 100 MB, then 90 MB again.
+  RunPeriod(/*hits=*/400, /*misses=*/600);
+  RunPeriod(/*hits=*/400, /*misses=*/600);
+  histogram_tester_.ExpectBucketCount(
+      "Radium.HttpCache.HitRateDelta.BudgetDecreased", 0, 1);
+  histogram_tester_.ExpectUniqueSample(
+      "Radium.HttpCache.HitRateDelta.BudgetUnchanged", 0, 1);
+  histogram_tester_.ExpectTotalCount("Radium.HttpCache.HitRate", 5);
+}
+
+TEST_F(HttpCacheSizeManagerTest, PersistsBudget) {
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(100 * kMB,
+            local_state_.GetInteger(prefs::kHttpCacheProfileBudget));
+
+  // The next session starts with the budget of the previous one.
+  manager_.reset();
+  manager_ = CreateManager();
+  EXPECT_EQ(100 * kMB, manager_->GetProfileBudget());
+}
+
+// The first update of a session has no hit rate of its own yet, and keeps the
+// budget scaled with the hit rate of the previous session.
+TEST_F(HttpCacheSizeManagerTest, PersistsBudgetHitRate) {
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  RunPeriod(/*hits=*/250, /*misses=*/750);
+  EXPECT_EQ(75 * kMB, manager_->GetProfileBudget());
+  EXPECT_EQ(0.25, local_state_.GetDouble(prefs::kHttpCacheBudgetHitRate));
+
+  manager_.reset();
+  manager_ = CreateManager();
+  manager_->Start();
+  RunPeriod(/*hits=*/0, /*misses=*/0);
+  EXPECT_EQ(75 * kMB, manager_->GetProfileBudget());
+}
@@ -0,0 +1,112 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/net/http_cache_size_policy.h"
+
+#include <algorithm>
+
+#include "base/check_op.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/strcat.h"
+
+namespace {
+
+constexpr char kHitRateHistogram[] = "Radium.HttpCache.HitRate";
+constexpr char kHitRateDeltaHistogram[] = "Radium.HttpCache.HitRateDelta";
+constexpr char kProfileBudgetHistogram[] = "Radium.HttpCache.ProfileBudget";
+
+const char* GetBudgetChangeSuffix(int64_t before, int64_t after) {
+  if (after > before) {
+    return ".BudgetIncreased";
+  }
+  if (after < before) {
+    return ".BudgetDecreased";
+  }
+  return ".BudgetUnchanged";
+}
+
+}  // namespace
+
+HttpCacheSizePolicy::HttpCacheSizePolicy(
+    int64_t profile_budget,
+    std::optional<double> budget_hit_rate)
+    : budget_hit_rate_(budget_hit_rate),
+      profile_budget_(profile_budget),
+      previous_profile_budget_(profile_budget) {}
+
+HttpCacheSizePolicy::~HttpCacheSizePolicy() = default;
+
+// static
+int64_t HttpCacheSizePolicy::ComputeProfileBudget(
+    int64_t free_disk_space,
+    size_t profile_count,
+    std::optional<double> hit_rate) {
+  DCHECK_GE(free_disk_space, 0);
+  double budget = free_disk_space * kFreeDiskSpaceShare /
+                  std::max<size_t>(profile_count, 1);
+  if (hit_rate) {
+    budget *= 0.5 + std::clamp(*hit_rate, 0.0, 1.0);
+  }
+  return std::clamp(base::ClampRound<int64_t>(budget), kMinProfileBudget,
+                    kMaxProfileBudget);
+}
+
+void HttpCacheSizePolicy::Update(int64_t free_disk_space,
+                                 size_t profile_count,
+                                 const CacheStats& stats) {
+  std::optional<double> hit_rate;
+  if (last_stats_) {
+    const int64_t hits = stats.hits - last_stats_->hits;
+    const int64_t lookups = hits + stats.misses - last_stats_->misses;
+    if (hits >= 0 && lookups >= kMinLookups) {
+      hit_rate = static_cast<double>(hits) / lookups;
+    }
+  }
+  last_stats_ = stats;
+
+  // Whether the budget shrank for the period that just ended and the caches
+  // then hit less than during the period before.
+  const bool shrink_lowered_hit_rate =
+      hit_rate && last_hit_rate_ &&
+      profile_budget_ < previous_profile_budget_ &&
+      *hit_rate < *last_hit_rate_;
+  const int64_t budget_before_shrink = previous_profile_budget_;
+
+  if (hit_rate) {
+    base::UmaHistogramPercentage(kHitRateHistogram,
+                                 base::ClampRound(*hit_rate * 100));
+    if (last_hit_rate_) {
+      // The budget of the period that just ended against the one before
+      // tells whether the last change paid off.
+      base::UmaHistogramSparse(
+          base::StrCat(
+              {kHitRateDeltaHistogram,
+               GetBudgetChangeSuffix(previous_profile_budget_,
+                                     profile_budget_)}),
+          base::ClampRound((*hit_rate - *last_hit_rate_) * 100));
+    }
+  }
+  last_hit_rate_ = hit_rate;
+  if (hit_rate) {
+    budget_hit_rate_ = hit_rate;
+  }
+
+  previous_profile_budget_ = profile_budget_;
+  if (free_disk_space >= 0) {
+    profile_budget_ =
+        ComputeProfileBudget(free_disk_space, profile_count, budget_hit_rate_);
+    if (shrink_lowered_hit_rate) {
+      // Still within what the disk allows now.
+      profile_budget_ = std::max(
+          profile_budget_,
+          std::min(budget_before_shrink,
+                   ComputeProfileBudget(free_disk_space, profile_count,
+                                        std::nullopt)));
+    }
+    base::UmaHistogramMemoryLargeMB(
+        kProfileBudgetHistogram,
+        base::saturated_cast<int>(profile_budget_ / (1024 * 1024)));
+  }
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_NET_HTTP_CACHE_SIZE_POLICY_H_
+#define RADIUM_BROWSER_NET_HTTP_CACHE_SIZE_POLICY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+
+// Computes the HTTP disk cache budget of each profile from the free space on
+// the volume holding the caches, the number of loaded profiles and the hit
+// rate of the caches since the previous update.
+//
+// The hit rate is the one of all profiles together: the network service
+// records HttpCache.Pattern for all of its contexts in one histogram. So all
+// profiles get the same budget, scaled by how well the caches do on average.
+//
+// A smaller cache hits less, which would shrink it further at the next
+// update. When the last shrink was followed by a lower hit rate, the budget
+// goes back to what it was before that shrink rather than shrinking again.
+//
+// Every update records the hit rate of the period that just ended, and how it
+// moved from the period before, split by whether the budget grew, shrank or
+// stayed the same between the two.
+class HttpCacheSizePolicy {
+ public:
+  // Cumulative counts of HTTP cache lookups.
+  struct CacheStats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+  };
+
+  // Bounds of the budget of one profile.
+  static constexpr int64_t kMinProfileBudget = 20 * 1024 * 1024;
+  static constexpr int64_t kMaxProfileBudget = 320 * 1024 * 1024;
+  // Share of the free disk space that the caches of all profiles may take.
+  static constexpr double kFreeDiskSpaceShare = 0.1;
+  // Lookups a period needs before its hit rate is taken into account.
+  static constexpr int64_t kMinLookups = 100;
+
+  // |profile_budget| is the budget the caches were created with, 0 if they
+  // were left to the network service default. |budget_hit_rate| is the hit
+  // rate it was scaled with, if any. It keeps scaling the budget until a
+  // period has enough lookups to measure a new one.
+  HttpCacheSizePolicy(int64_t profile_budget,
+                      std::optional<double> budget_hit_rate);
+  HttpCacheSizePolicy(const HttpCacheSizePolicy&) = delete;
+  HttpCacheSizePolicy& operator=(const HttpCacheSizePolicy&) = delete;
+  ~HttpCacheSizePolicy();
+
+  // Returns the budget of one of |profile_count| profiles sharing
+  // |free_disk_space| bytes. A |hit_rate| in [0, 1] scales it by 0.5 to 1.5:
+  // caches that are rarely hit give space back, caches that pay off get more.
+  static int64_t ComputeProfileBudget(int64_t free_disk_space,
+                                      size_t profile_count,
+                                      std::optional<double> hit_rate);
+
+  // Computes profile_budget() for the current inputs. |stats| are cumulative;
+  // the hit rate is the one since the previous call. A negative
+  // |free_disk_space| means it could not be measured, and keeps the budget.
+  void Update(int64_t free_disk_space,
+              size_t profile_count,
+              const CacheStats& stats);
+
+  int64_t profile_budget() const { return profile_budget_; }
+  std::optional<double> budget_hit_rate() const { return budget_hit_rate_; }
+  std::optional<double> last_hit_rate() const { return last_hit_rate_; }
+
+ private:
+  std::optional<CacheStats> last_stats_;
+  // Hit rate of the period that just ended, if it had enough lookups.
+  std::optional<double> last_hit_rate_;
+  // Latest measured hit rate, which profile_budget_ is scaled with. Unlike
+  // |last_hit_rate_|, it survives periods with few lookups and sessions.
+  std::optional<double> budget_hit_rate_;
+
+  // Budget during the period that just ended, and during the one before.
+  int64_t profile_budget_;
+  int64_t previous_profile_budget_;
+};
+
+#endif  // RADIUM_BROWSER_NET_HTTP_CACHE_SIZE_POLICY_H_
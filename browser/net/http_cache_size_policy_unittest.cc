@@ -0,0 +1,99 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/net/http_cache_size_policy.h"
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int64_t kMB = 1024 * 1024;
+constexpr int64_t kGB = 1024 * kMB;
+
+}  // namespace
+
+TEST(HttpCacheSizePolicyTest, SplitsFreeDiskSpaceBetweenProfiles) {
+  EXPECT_EQ(100 * kMB, HttpCacheSizePolicy::ComputeProfileBudget(
+                           1000 * kMB, 1, std::nullopt));
+  EXPECT_EQ(50 * kMB, HttpCacheSizePolicy::ComputeProfileBudget(
+                          1000 * kMB, 2, std::nullopt));
+  // Profiles that are not loaded yet don't count.
+  EXPECT_EQ(100 * kMB, HttpCacheSizePolicy::ComputeProfileBudget(
+                           1000 * kMB, 0, std::nullopt));
+}
+
+TEST(HttpCacheSizePolicyTest, ClampsBudget) {
+  EXPECT_EQ(HttpCacheSizePolicy::kMinProfileBudget,
+            HttpCacheSizePolicy::ComputeProfileBudget(0, 1, std::nullopt));
+  EXPECT_EQ(HttpCacheSizePolicy::kMinProfileBudget,
+            HttpCacheSizePolicy::ComputeProfileBudget(1 * kGB, 20, 0.0));
+  EXPECT_EQ(HttpCacheSizePolicy::kMaxProfileBudget,
+            HttpCacheSizePolicy::ComputeProfileBudget(100 * kGB, 1, 1.0));
+}
+
+TEST(HttpCacheSizePolicyTest, ScalesBudgetWithHitRate) {
+  EXPECT_EQ(50 * kMB,
+            HttpCacheSizePolicy::ComputeProfileBudget(1000 * kMB, 1, 0.0));
+  EXPECT_EQ(100 * kMB,
+            HttpCacheSizePolicy::ComputeProfileBudget(1000 * kMB, 1, 0.5));
+  EXPECT_EQ(150 * kMB,
+            HttpCacheSizePolicy::ComputeProfileBudget(1000 * kMB, 1, 1.0));
+}
+
+TEST(HttpCacheSizePolicyTest, IgnoresHitRateOfFewLookups) {
+  HttpCacheSizePolicy policy(0, std::nullopt);
+  policy.Update(1000 * kMB, 1, {.hits = 0, .misses = 0});
+  EXPECT_FALSE(policy.last_hit_rate());
+
+  policy.Update(1000 * kMB, 1,
+                {.hits = HttpCacheSizePolicy::kMinLookups - 1, .misses = 0});
+  EXPECT_FALSE(policy.last_hit_rate());
+  EXPECT_FALSE(policy.budget_hit_rate());
+  EXPECT_EQ(100 * kMB, policy.profile_budget());
+}
+
+// A period with few lookups says nothing about the hit rate, so the budget
+// stays scaled with the last one that was measured.
+TEST(HttpCacheSizePolicyTest, KeepsBudgetHitRateThroughFewLookups) {
+  HttpCacheSizePolicy policy(0, std::nullopt);
+  policy.Update(1000 * kMB, 1, {.hits = 0, .misses = 0});
+  policy.Update(1000 * kMB, 1, {.hits = 250, .misses = 750});
+  EXPECT_EQ(75 * kMB, policy.profile_budget());
+
+  policy.Update(1000 * kMB, 1, {.hits = 250, .misses = 751});
+  EXPECT_FALSE(policy.last_hit_rate());
+  EXPECT_EQ(0.25, policy.budget_hit_rate());
+  EXPECT_EQ(75 * kMB, policy.profile_budget());
+}
+
+// The first update of a session has no hit rate of its own yet.
+TEST(HttpCacheSizePolicyTest, StartsWithBudgetHitRate) {
+  HttpCacheSizePolicy policy(75 * kMB, 0.25);
+  policy.Update(1000 * kMB, 1, {.hits = 0, .misses = 0});
+  EXPECT_EQ(75 * kMB, policy.profile_budget());
+}
+
+TEST(HttpCacheSizePolicyTest, DoesNotShrinkAgainAfterLowerHitRate) {
+  HttpCacheSizePolicy policy(0, std::nullopt);
+  policy.Update(1000 * kMB, 1, {.hits = 0, .misses = 0});
+  policy.Update(1000 * kMB, 1, {.hits = 500, .misses = 500});
+  EXPECT_EQ(100 * kMB, policy.profile_budget());
+  policy.Update(1000 * kMB, 1, {.hits = 750, .misses = 1250});
+  EXPECT_EQ(75 * kMB, policy.profile_budget());
+
+  // The 75 MB period hit less than the 100 MB one: back to 100 MB rather than
+  // down to 60 MB.
+  policy.Update(1000 * kMB, 1, {.hits = 850, .misses = 2150});
+  EXPECT_EQ(0.1, policy.last_hit_rate());
+  EXPECT_EQ(100 * kMB, policy.profile_budget());
+
+  // But not beyond what the free disk space allows.
+  policy.Update(1000 * kMB, 1, {.hits = 1100, .misses = 2900});
+  policy.Update(500 * kMB, 1, {.hits = 1200, .misses = 3800});
+  EXPECT_EQ(50 * kMB, policy.profile_budget());
+}
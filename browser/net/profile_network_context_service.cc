@@ -22,6 +22,7 @@
 #include "base/metrics/field_trial_params.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/notreached.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
@@ -66,6 +67,8 @@
 #include "radium/browser/browser_process.h"
 #include "radium/browser/content_settings/cookie_settings_factory.h"
 #include "radium/browser/content_settings/host_content_settings_map_factory.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/net/http_cache_size_manager.h"
 #include "radium/browser/net/system_network_context_manager.h"
 #include "radium/browser/profiles/profile.h"
 #include "radium/browser/ui/crypto_module_delegate_nss.h"
@@ -1075,7 +1078,15 @@ void ProfileNetworkContextService::ConfigureNetworkContextParamsInternal(
     if (!disk_cache_dir.empty()) {
       base_cache_path = disk_cache_dir.Append(base_cache_path.BaseName());
     }
-    const int disk_cache_size = local_state->GetInteger(prefs::kDiskCacheSize);
+    int disk_cache_size = local_state->GetInteger(prefs::kDiskCacheSize);
+    HttpCacheSizeManager* http_cache_size_manager =
+        BrowserProcess::Get()->GetFeatures()->http_cache_size_manager();
+    if (disk_cache_size == 0 && http_cache_size_manager) {
+      // Contexts that are already running keep the size they were created
+      // with, as the network service cannot resize their cache.
+      disk_cache_size = base::saturated_cast<int>(
+          http_cache_size_manager->GetProfileBudget());
+    }
     network_context_params->http_cache_max_size = disk_cache_size;
     network_context_params->shared_dictionary_cache_max_size = disk_cache_size;
 
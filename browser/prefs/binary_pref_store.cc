@@ -0,0 +1,710 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/prefs/binary_pref_store.h"
+
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/functional/bind.h"
+#include "base/hash/hash.h"
+#include "base/json/json_file_value_serializer.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/numerics/byte_conversions.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "components/prefs/json_pref_store.h"
+#include "radium/browser/prefs/scheduled_pref_store.h"
+#include "radium/common/radium_switches.h"
+
+namespace {
+
+constexpr std::string_view kHeader = "RPB1";
+
+// Same delay as the ImportantFileWriter used by JsonPrefStore.
+constexpr base::TimeDelta kCommitInterval = base::Seconds(10);
+
+// Small logs are not worth compacting.
+constexpr size_t kMinCompactionSize = 64 * 1024;
+
+// Limits the nesting of decoded values, so that a damaged file cannot
+// overflow the stack.
+constexpr int kMaxDepth = 100;
+
+enum class ValueTag : uint8_t {
+  kNone = 0,
+  kBool = 1,
+  kInt = 2,
+  kDouble = 3,
+  kString = 4,
+  kBinary = 5,
+  kDict = 6,
+  kList = 7,
+};
+
+void AppendBytes(base::span<const uint8_t> bytes, std::string* output) {
+  output->append(bytes.begin(), bytes.end());
+}
+
+void AppendU32(size_t value, std::string* output) {
+  AppendBytes(base::U32ToLittleEndian(base::checked_cast<uint32_t>(value)),
+              output);
+}
+
+void AppendString(std::string_view value, std::string* output) {
+  AppendU32(value.size(), output);
+  output->append(value);
+}
+
+void AppendValue(const base::Value& value, std::string* output) {
+  switch (value.type()) {
+    case base::Value::Type::NONE:
+      output->push_back(static_cast<char>(ValueTag::kNone));
+      break;
+    case base::Value::Type::BOOLEAN:
+      output->push_back(static_cast<char>(ValueTag::kBool));
+      output->push_back(value.GetBool() ? 1 : 0);
+      break;
+    case base::Value::Type::INTEGER:
+      output->push_back(static_cast<char>(ValueTag::kInt));
+      AppendBytes(base::I32ToLittleEndian(value.GetInt()), output);
+      break;
+    case base::Value::Type::DOUBLE:
+      output->push_back(static_cast<char>(ValueTag::kDouble));
+      AppendBytes(base::DoubleToLittleEndian(value.GetDouble()), output);
+      break;
+    case base::Value::Type::STRING:
+      output->push_back(static_cast<char>(ValueTag::kString));
+      AppendString(value.GetString(), output);
+      break;
+    case base::Value::Type::BINARY:
+      output->push_back(static_cast<char>(ValueTag::kBinary));
+      AppendU32(value.GetBlob().size(), output);
+      AppendBytes(value.GetBlob(), output);
+      break;
+    case base::Value::Type::DICT:
+      output->push_back(static_cast<char>(ValueTag::kDict));
+      AppendU32(value.GetDict().size(), output);
+      for (const auto [key, item] : value.GetDict()) {
+        AppendString(key, output);
+        AppendValue(item, output);
+      }
+      break;
+    case base::Value::Type::LIST:
+      output->push_back(static_cast<char>(ValueTag::kList));
+      AppendU32(value.GetList().size(), output);
+      for (const base::Value& item : value.GetList()) {
+        AppendValue(item, output);
+      }
+      break;
+  }
+}
+
+// Reads the encoding written by the Append*() functions above. Every read
+// fails once the end of the data has been reached.
+class Reader {
+ public:
+  explicit Reader(base::span<const uint8_t> data) : data_(data) {}
+
+  bool empty() const { return data_.empty(); }
+
+  bool ReadBytes(size_t size, base::span<const uint8_t>* bytes) {
+    if (data_.size() < size) {
+      return false;
+    }
+    *bytes = data_.first(size);
+    data_ = data_.subspan(size);
+    return true;
+  }
+
+  bool ReadU8(uint8_t* value) {
+    base::span<const uint8_t> bytes;
+    if (!ReadBytes(1u, &bytes)) {
+      return false;
+    }
+    *value = bytes[0];
+    return true;
+  }
+
+  bool ReadU32(uint32_t* value) {
+    base::span<const uint8_t> bytes;
+    if (!ReadBytes(4u, &bytes)) {
+      return false;
+    }
+    *value = base::U32FromLittleEndian(bytes.first<4u>());
+    return true;
+  }
+
+  bool ReadString(std::string_view* value) {
+    uint32_t size;
+    base::span<const uint8_t> bytes;
+    if (!ReadU32(&size) || !ReadBytes(size, &bytes)) {
+      return false;
+    }
+    *value = base::as_string_view(bytes);
+    return true;
+  }
+
+  std::optional<base::Value> ReadValue(int depth = 0) {
+    uint8_t tag;
+    if (depth > kMaxDepth || !ReadU8(&tag)) {
+      return std::nullopt;
+    }
+
+    base::span<const uint8_t> bytes;
+    uint32_t size;
+    switch (static_cast<ValueTag>(tag)) {
+      case ValueTag::kNone:
+        return base::Value();
+      case ValueTag::kBool: {
+        uint8_t value;
+        if (!ReadU8(&value)) {
+          return std::nullopt;
+        }
+        return base::Value(value != 0);
+      }
+      case ValueTag::kInt:
+        if (!ReadBytes(4u, &bytes)) {
+          return std::nullopt;
+        }
+        return base::Value(base::I32FromLittleEndian(bytes.first<4u>()));
+      case ValueTag::kDouble:
+        if (!ReadBytes(8u, &bytes)) {
+          return std::nullopt;
+        }
+        return base::Value(base::DoubleFromLittleEndian(bytes.first<8u>()));
+      case ValueTag::kString: {
+        std::string_view value;
+        if (!ReadString(&value)) {
+          return std::nullopt;
+        }
+        return base::Value(value);
+      }
+      case ValueTag::kBinary:
+        if (!ReadU32(&size) || !ReadBytes(size, &bytes)) {
+          return std::nullopt;
+        }
+        return base::Value(bytes);
+      case ValueTag::kDict: {
+        if (!ReadU32(&size)) {
+          return std::nullopt;
+        }
+        base::Value::Dict dict;
+        for (uint32_t i = 0; i < size; ++i) {
+          std::string_view key;
+          if (!ReadString(&key)) {
+            return std::nullopt;
+          }
+          std::optional<base::Value> item = ReadValue(depth + 1);
+          if (!item) {
+            return std::nullopt;
+          }
+          dict.Set(key, std::move(*item));
+        }
+        return base::Value(std::move(dict));
+      }
+      case ValueTag::kList: {
+        if (!ReadU32(&size)) {
+          return std::nullopt;
+        }
+        base::Value::List list;
+        for (uint32_t i = 0; i < size; ++i) {
+          std::optional<base::Value> item = ReadValue(depth + 1);
+          if (!item) {
+            return std::nullopt;
+          }
+          list.Append(std::move(*item));
+        }
+        return base::Value(std::move(list));
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  base::span<const uint8_t> data_;
+};
+
+// Applies the record |payload| to |prefs|. Returns false if the payload is
+// malformed.
+bool ApplyRecord(base::span<const uint8_t> payload, base::Value::Dict* prefs) {
+  Reader reader(payload);
+  uint8_t op;
+  std::string_view key;
+  if (!reader.ReadU8(&op) || !reader.ReadString(&key)) {
+    return false;
+  }
+
+  switch (static_cast<BinaryPrefStore::RecordOp>(op)) {
+    case BinaryPrefStore::RecordOp::kSet:
+    case BinaryPrefStore::RecordOp::kSetTopLevel: {
+      std::optional<base::Value> value = reader.ReadValue();
+      if (!value || !reader.empty()) {
+        return false;
+      }
+      if (op == static_cast<uint8_t>(BinaryPrefStore::RecordOp::kSet)) {
+        prefs->SetByDottedPath(key, std::move(*value));
+      } else {
+        prefs->Set(key, std::move(*value));
+      }
+      return true;
+    }
+    case BinaryPrefStore::RecordOp::kRemove:
+      if (!reader.empty()) {
+        return false;
+      }
+      prefs->RemoveByDottedPath(key);
+      return true;
+  }
+  return false;
+}
+
+void AppendToFile(const base::FilePath& path, const std::string& data) {
+  TRACE_EVENT0("browser", "BinaryPrefStore::AppendToFile");
+  base::File file(path, base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  if (!file.IsValid() ||
+      !file.WriteAtCurrentPosAndCheck(base::as_byte_span(data))) {
+    LOG(ERROR) << "Failed to append to " << path;
+  }
+}
+
+void WriteSnapshot(const base::FilePath& path, const std::string& data) {
+  TRACE_EVENT0("browser", "BinaryPrefStore::WriteSnapshot");
+  if (!base::ImportantFileWriter::WriteFileAtomically(path, data)) {
+    LOG(ERROR) << "Failed to write " << path;
+  }
+}
+
+// Converts the binary file for |json_path| back to JSON, and removes it once
+// the JSON file has been written.
+void ExportToJson(const base::FilePath& json_path) {
+  const base::FilePath binary_path = BinaryPrefStore::GetBinaryPath(json_path);
+  if (!base::PathExists(binary_path)) {
+    return;
+  }
+
+  TRACE_EVENT0("browser", "BinaryPrefStore::ExportToJson");
+  BinaryPrefStore::ReadResult result =
+      BinaryPrefStore::ReadFromDisk(json_path);
+  if (result.error != PersistentPrefStore::PREF_READ_ERROR_NONE) {
+    return;
+  }
+
+  JSONFileValueSerializer serializer(json_path);
+  if (serializer.Serialize(result.prefs)) {
+    base::DeleteFile(binary_path);
+  }
+}
+
+}  // namespace
+
+BinaryPrefStore::ReadResult::ReadResult() = default;
+BinaryPrefStore::ReadResult::ReadResult(ReadResult&&) = default;
+BinaryPrefStore::ReadResult& BinaryPrefStore::ReadResult::operator=(
+    ReadResult&&) = default;
+BinaryPrefStore::ReadResult::~ReadResult() = default;
+
+// static
+base::FilePath BinaryPrefStore::GetBinaryPath(const base::FilePath& json_path) {
+  return json_path.AddExtension(FILE_PATH_LITERAL("rpb"));
+}
+
+BinaryPrefStore::BinaryPrefStore(
+    const base::FilePath& json_path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner)
+    : json_path_(json_path),
+      path_(GetBinaryPath(json_path)),
+      file_task_runner_(std::move(file_task_runner)) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+BinaryPrefStore::~BinaryPrefStore() {
+  CommitPendingWrite();
+}
+
+bool BinaryPrefStore::GetValue(std::string_view key,
+                               const base::Value** result) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::Value* value = prefs_.FindByDottedPath(key);
+  if (!value) {
+    return false;
+  }
+  if (result) {
+    *result = value;
+  }
+  return true;
+}
+
+base::Value::Dict BinaryPrefStore::GetValues() const {
+  return prefs_.Clone();
+}
+
+void BinaryPrefStore::AddObserver(PrefStore::Observer* observer) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  observers_.AddObserver(observer);
+}
+
+void BinaryPrefStore::RemoveObserver(PrefStore::Observer* observer) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  observers_.RemoveObserver(observer);
+}
+
+bool BinaryPrefStore::HasObservers() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return !observers_.empty();
+}
+
+bool BinaryPrefStore::IsInitializationComplete() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return initialized_;
+}
+
+bool BinaryPrefStore::GetMutableValue(std::string_view key,
+                                      base::Value** result) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::Value* value = prefs_.FindByDottedPath(key);
+  if (!value) {
+    return false;
+  }
+  if (result) {
+    *result = value;
+  }
+  return true;
+}
+
+void BinaryPrefStore::SetValue(std::string_view key,
+                               base::Value value,
+                               uint32_t flags) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::Value* old_value = prefs_.FindByDottedPath(key);
+  if (!old_value || value != *old_value) {
+    prefs_.SetByDottedPath(key, std::move(value));
+    ReportValueChanged(key, flags);
+  }
+}
+
+void BinaryPrefStore::SetValueSilently(std::string_view key,
+                                       base::Value value,
+                                       uint32_t flags) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::Value* old_value = prefs_.FindByDottedPath(key);
+  if (!old_value || value != *old_value) {
+    prefs_.SetByDottedPath(key, std::move(value));
+    QueueRecord(key, flags);
+  }
+}
+
+void BinaryPrefStore::RemoveValue(std::string_view key, uint32_t flags) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (prefs_.RemoveByDottedPath(key)) {
+    ReportValueChanged(key, flags);
+  }
+}
+
+void BinaryPrefStore::RemoveValuesByPrefixSilently(std::string_view prefix) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (prefs_.RemoveByDottedPath(prefix)) {
+    QueueRecord(prefix, DEFAULT_PREF_WRITE_FLAGS);
+  }
+}
+
+bool BinaryPrefStore::ReadOnly() const {
+  return false;
+}
+
+PersistentPrefStore::PrefReadError BinaryPrefStore::GetReadError() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return read_error_;
+}
+
+PersistentPrefStore::PrefReadError BinaryPrefStore::ReadPrefs() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  OnFileRead(ReadFromDisk(json_path_));
+  return read_error_;
+}
+
+void BinaryPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  error_delegate_.reset(error_delegate);
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&BinaryPrefStore::ReadFromDisk, json_path_),
+      base::BindOnce(&BinaryPrefStore::OnFileRead,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void BinaryPrefStore::CommitPendingWrite(
+    base::OnceClosure reply_callback,
+    base::OnceClosure synchronous_done_callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  WriteNow();
+
+  // The file task runner is sequenced, so these run after the write above.
+  if (reply_callback) {
+    file_task_runner_->PostTaskAndReply(FROM_HERE, base::DoNothing(),
+                                        std::move(reply_callback));
+  }
+  if (synchronous_done_callback) {
+    file_task_runner_->PostTask(FROM_HERE,
+                                std::move(synchronous_done_callback));
+  }
+}
+
+void BinaryPrefStore::SchedulePendingLossyWrites() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!pending_records_.empty()) {
+    ScheduleWrite();
+  }
+}
+
+void BinaryPrefStore::ReportValueChanged(std::string_view key,
+                                         uint32_t flags) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  NotifyValueChanged(key);
+  QueueRecord(key, flags);
+}
+
+void BinaryPrefStore::OnStoreDeletionFromDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  write_timer_.Stop();
+  pending_records_.clear();
+}
+
+bool BinaryPrefStore::HasReadErrorDelegate() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return !!error_delegate_;
+}
+
+// static
+void BinaryPrefStore::AppendRecord(RecordOp op,
+                                   std::string_view key,
+                                   const base::Value* value,
+                                   std::string* output) {
+  DCHECK_EQ(op == RecordOp::kRemove, !value);
+  std::string payload;
+  payload.push_back(static_cast<char>(op));
+  AppendString(key, &payload);
+  if (value) {
+    AppendValue(*value, &payload);
+  }
+
+  AppendU32(payload.size(), output);
+  AppendBytes(base::U32ToLittleEndian(
+                  base::PersistentHash(base::as_byte_span(payload))),
+              output);
+  output->append(payload);
+}
+
+// static
+std::string BinaryPrefStore::SerializeSnapshot(const base::Value::Dict& prefs) {
+  std::string output(kHeader);
+  for (const auto [key, value] : prefs) {
+    AppendRecord(RecordOp::kSetTopLevel, key, &value, &output);
+  }
+  return output;
+}
+
+// static
+std::optional<BinaryPrefStore::ReadResult> BinaryPrefStore::ParseFile(
+    base::span<const uint8_t> data) {
+  if (data.size() < kHeader.size() ||
+      base::as_string_view(data.first(kHeader.size())) != kHeader) {
+    return std::nullopt;
+  }
+
+  ReadResult result;
+  size_t offset = kHeader.size();
+  while (offset < data.size()) {
+    Reader reader(data.subspan(offset));
+    uint32_t size;
+    uint32_t hash;
+    base::span<const uint8_t> payload;
+    if (!reader.ReadU32(&size) || !reader.ReadU32(&hash) ||
+        !reader.ReadBytes(size, &payload) ||
+        base::PersistentHash(payload) != hash ||
+        !ApplyRecord(payload, &result.prefs)) {
+      break;
+    }
+    offset += 2 * sizeof(uint32_t) + size;
+  }
+
+  result.file_size = offset;
+  result.needs_compaction = offset != data.size();
+  return result;
+}
+
+// static
+BinaryPrefStore::ReadResult BinaryPrefStore::ReadFromDisk(
+    const base::FilePath& json_path) {
+  TRACE_EVENT0("browser", "BinaryPrefStore::ReadFromDisk");
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  const base::FilePath path = GetBinaryPath(json_path);
+
+  ReadResult result;
+  if (base::PathExists(path)) {
+    base::MemoryMappedFile file;
+    std::optional<ReadResult> parsed;
+    if (file.Initialize(path)) {
+      parsed = ParseFile(file.bytes());
+    }
+    if (parsed) {
+      result = std::move(*parsed);
+      base::UmaHistogramTimes("Radium.Prefs.BinaryStore.ReadTime",
+                              base::TimeTicks::Now() - start_time);
+    } else {
+      // Start over with empty prefs, like JsonPrefStore does for a file it
+      // cannot parse.
+      LOG(ERROR) << "Corrupted pref file " << path;
+      result.error = PersistentPrefStore::PREF_READ_ERROR_FILE_OTHER;
+      result.needs_compaction = true;
+    }
+    return result;
+  }
+
+  // First run with the binary store, import the JSON file.
+  if (!base::PathExists(json_path)) {
+    result.error = PersistentPrefStore::PREF_READ_ERROR_NO_FILE;
+    return result;
+  }
+
+  JSONFileValueDeserializer deserializer(json_path);
+  std::unique_ptr<base::Value> value =
+      deserializer.Deserialize(nullptr, nullptr);
+  if (value && value->is_dict()) {
+    result.prefs = std::move(*value).TakeDict();
+  } else {
+    result.error = value ? PersistentPrefStore::PREF_READ_ERROR_JSON_TYPE
+                         : PersistentPrefStore::PREF_READ_ERROR_JSON_PARSE;
+  }
+  result.needs_compaction = true;
+  return result;
+}
+
+void BinaryPrefStore::OnFileRead(ReadResult result) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  read_error_ = result.error;
+  prefs_ = std::move(result.prefs);
+  file_size_ = result.file_size;
+  compacted_file_size_ = result.file_size;
+  needs_compaction_ = result.needs_compaction;
+  initialized_ = true;
+
+  if (error_delegate_ && read_error_ != PREF_READ_ERROR_NONE &&
+      read_error_ != PREF_READ_ERROR_NO_FILE) {
+    error_delegate_->OnError(read_error_);
+  }
+
+  if (needs_compaction_) {
+    ScheduleWrite();
+  }
+
+  for (PrefStore::Observer& observer : observers_) {
+    observer.OnInitializationCompleted(true);
+  }
+}
+
+void BinaryPrefStore::QueueRecord(std::string_view key, uint32_t flags) {
+  const base::Value* value = prefs_.FindByDottedPath(key);
+  AppendRecord(value ? RecordOp::kSet : RecordOp::kRemove, key, value,
+               &pending_records_);
+  if (!(flags & LOSSY_PREF_WRITE_FLAG)) {
+    ScheduleWrite();
+  }
+}
+
+void BinaryPrefStore::ScheduleWrite() {
+  if (!write_timer_.IsRunning()) {
+    // Unretained is safe because the timer is owned by this object.
+    write_timer_.Start(
+        FROM_HERE, kCommitInterval,
+        base::BindOnce(&BinaryPrefStore::WriteNow, base::Unretained(this)));
+  }
+}
+
+void BinaryPrefStore::WriteNow() {
+  write_timer_.Stop();
+  if (!initialized_) {
+    // Records queued before the read completes are kept until the first write
+    // after it.
+    return;
+  }
+
+  const size_t new_file_size = file_size_ + pending_records_.size();
+  if (needs_compaction_ || (new_file_size > kMinCompactionSize &&
+                            new_file_size > 2 * compacted_file_size_)) {
+    std::string snapshot = SerializeSnapshot(prefs_);
+    base::UmaHistogramMemoryKB("Radium.Prefs.BinaryStore.CompactedSize",
+                               snapshot.size() / 1024);
+    pending_records_.clear();
+    needs_compaction_ = false;
+    file_size_ = snapshot.size();
+    compacted_file_size_ = snapshot.size();
+    base::UmaHistogramCounts10M("Radium.Prefs.BinaryStore.BytesWritten",
+                                snapshot.size());
+    file_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&WriteSnapshot, path_, std::move(snapshot)));
+    return;
+  }
+
+  if (pending_records_.empty()) {
+    return;
+  }
+
+  std::string data;
+  if (file_size_ == 0) {
+    data = kHeader;
+  }
+  data.append(pending_records_);
+  pending_records_.clear();
+  file_size_ += data.size();
+  base::UmaHistogramCounts10M("Radium.Prefs.BinaryStore.BytesWritten",
+                              data.size());
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&AppendToFile, path_, std::move(data)));
+}
+
+void BinaryPrefStore::NotifyValueChanged(std::string_view key) {
+  for (PrefStore::Observer& observer : observers_) {
+    observer.OnPrefValueChanged(key);
+  }
+}
+
+scoped_refptr<PersistentPrefStore> CreatePersistentPrefStore(
+    const base::FilePath& json_path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    bool read_async) {
+  if (!file_task_runner) {
+    file_task_runner = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+  }
+
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kBinaryPrefStore)) {
+    return base::MakeRefCounted<ScheduledPrefStore>(
+        base::MakeRefCounted<BinaryPrefStore>(json_path,
+                                              std::move(file_task_runner)),
+        base::FilePath());
+  }
+
+  // The JsonPrefStore reads on |file_task_runner| when reading asynchronously,
+  // so the export is sequenced before the read. A synchronous read blocks the
+  // calling thread anyway.
+  if (read_async) {
+    file_task_runner->PostTask(FROM_HERE,
+                               base::BindOnce(&ExportToJson, json_path));
+  } else {
+    ExportToJson(json_path);
+  }
+  return base::MakeRefCounted<ScheduledPrefStore>(
+      base::MakeRefCounted<JsonPrefStore>(json_path, nullptr,
+                                          std::move(file_task_runner)),
+      json_path);
+}
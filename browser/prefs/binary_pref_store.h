@@ -0,0 +1,185 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_PREFS_BINARY_PREF_STORE_H_
+#define RADIUM_BROWSER_PREFS_BINARY_PREF_STORE_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/observer_list.h"
+#include "base/sequence_checker.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
+#include "components/prefs/persistent_pref_store.h"
+#include "components/prefs/pref_store.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+// A PersistentPrefStore that keeps preferences in a compact binary log instead
+// of a JSON file. Like JsonPrefStore it serves the preferences from a
+// base::Value::Dict in memory. The file is only memory mapped while the log is
+// replayed into that dictionary on read. Every change is appended to the file
+// as a single record instead of rewriting the whole file. Once the log has
+// grown to twice the size of its live content it is compacted into a snapshot
+// with one record per top-level preference.
+//
+// File format, all integers little endian:
+//   header:  "RPB1"
+//   record:  uint32 payload size, uint32 PersistentHash(payload), payload
+//   payload: uint8 op, uint32 key size, key, [value]
+// where op is one of RecordOp and value is an encoded base::Value (see
+// binary_pref_store.cc). A record with a bad size or hash ends the log; it is
+// the remainder of a write that was interrupted, and is dropped on the next
+// compaction.
+//
+// When the binary file does not exist yet the JSON file it replaces is
+// imported. Use CreatePersistentPrefStore() to pick the store, it also
+// converts back to JSON when the binary store is switched off.
+class BinaryPrefStore final : public PersistentPrefStore {
+ public:
+  enum class RecordOp : uint8_t {
+    // Sets the value at a dotted path.
+    kSet = 0,
+    // Removes the value at a dotted path.
+    kRemove = 1,
+    // Sets a top-level value, the key is not split at dots.
+    kSetTopLevel = 2,
+  };
+
+  struct ReadResult {
+    ReadResult();
+    ReadResult(ReadResult&&);
+    ReadResult& operator=(ReadResult&&);
+    ~ReadResult();
+
+    PrefReadError error = PREF_READ_ERROR_NONE;
+    base::Value::Dict prefs;
+    // Size of the valid part of the file.
+    size_t file_size = 0;
+    // True if the file must be rewritten: it was imported from JSON or ends
+    // with a partial record.
+    bool needs_compaction = false;
+  };
+
+  // Returns the binary file that replaces the JSON pref file |json_path|.
+  static base::FilePath GetBinaryPath(const base::FilePath& json_path);
+
+  // |json_path| is the JSON file that is imported when the binary file for it
+  // does not exist yet. All file IO happens on |file_task_runner|.
+  BinaryPrefStore(const base::FilePath& json_path,
+                  scoped_refptr<base::SequencedTaskRunner> file_task_runner);
+  BinaryPrefStore(const BinaryPrefStore&) = delete;
+  BinaryPrefStore& operator=(const BinaryPrefStore&) = delete;
+
+  // PrefStore:
+  bool GetValue(std::string_view key,
+                const base::Value** result) const override;
+  base::Value::Dict GetValues() const override;
+  void AddObserver(PrefStore::Observer* observer) override;
+  void RemoveObserver(PrefStore::Observer* observer) override;
+  bool HasObservers() const override;
+  bool IsInitializationComplete() const override;
+
+  // PersistentPrefStore:
+  bool GetMutableValue(std::string_view key, base::Value** result) override;
+  void SetValue(std::string_view key,
+                base::Value value,
+                uint32_t flags) override;
+  void SetValueSilently(std::string_view key,
+                        base::Value value,
+                        uint32_t flags) override;
+  void RemoveValue(std::string_view key, uint32_t flags) override;
+  void RemoveValuesByPrefixSilently(std::string_view prefix) override;
+  bool ReadOnly() const override;
+  PrefReadError GetReadError() const override;
+  PrefReadError ReadPrefs() override;
+  void ReadPrefsAsync(ReadErrorDelegate* error_delegate) override;
+  void CommitPendingWrite(
+      base::OnceClosure reply_callback = base::OnceClosure(),
+      base::OnceClosure synchronous_done_callback =
+          base::OnceClosure()) override;
+  void SchedulePendingLossyWrites() override;
+  void ReportValueChanged(std::string_view key, uint32_t flags) override;
+  void OnStoreDeletionFromDisk() override;
+  bool HasReadErrorDelegate() const override;
+
+  // Encoding helpers, public for the perf tests.
+  static void AppendRecord(RecordOp op,
+                           std::string_view key,
+                           const base::Value* value,
+                           std::string* output);
+  static std::string SerializeSnapshot(const base::Value::Dict& prefs);
+  // Replays the log in |data|. Returns nullopt if |data| is not a binary pref
+  // file.
+  static std::optional<ReadResult> ParseFile(base::span<const uint8_t> data);
+
+  // Blocking. Reads the binary file for |json_path|, importing |json_path| if
+  // there is no binary file yet.
+  static ReadResult ReadFromDisk(const base::FilePath& json_path);
+
+ private:
+  ~BinaryPrefStore() override;
+
+  void OnFileRead(ReadResult result);
+
+  // Queues a record for |key| that reflects its current value in |prefs_|.
+  void QueueRecord(std::string_view key, uint32_t flags);
+  void ScheduleWrite();
+  // Appends the queued records to the file, or compacts the file if it has
+  // grown too much.
+  void WriteNow();
+
+  void NotifyValueChanged(std::string_view key);
+
+  const base::FilePath json_path_;
+  const base::FilePath path_;
+  const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+
+  base::Value::Dict prefs_;
+
+  bool initialized_ = false;
+  PrefReadError read_error_ = PREF_READ_ERROR_NONE;
+  std::unique_ptr<ReadErrorDelegate> error_delegate_;
+
+  // Records not written to the file yet.
+  std::string pending_records_;
+  // Size of the file including the writes posted to |file_task_runner_|, and
+  // of the file right after the last compaction.
+  size_t file_size_ = 0;
+  size_t compacted_file_size_ = 0;
+  bool needs_compaction_ = false;
+
+  base::OneShotTimer write_timer_;
+
+  base::ObserverList<PrefStore::Observer, true> observers_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<BinaryPrefStore> weak_ptr_factory_{this};
+};
+
+// Returns the store for the JSON pref file |json_path|. This is a
+// BinaryPrefStore when switches::kBinaryPrefStore is present, and a
+// JsonPrefStore otherwise. If a binary file is left over from a run with the
+// switch, it is converted back to JSON before the JsonPrefStore reads it.
+// |file_task_runner| may be null, in which case a dedicated sequence is used.
+// |read_async| must match how the PrefService will read the store.
+// The store is wrapped in a ScheduledPrefStore: it only writes when it is
+// committed, so its PrefService must be added to the PrefCommitScheduler.
+scoped_refptr<PersistentPrefStore> CreatePersistentPrefStore(
+    const base::FilePath& json_path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    bool read_async);
+
+#endif  // RADIUM_BROWSER_PREFS_BINARY_PREF_STORE_H_
@@ -0,0 +1,258 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/prefs/binary_pref_store.h"
+
+#include <optional>
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "components/prefs/persistent_pref_store.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using RecordOp = BinaryPrefStore::RecordOp;
+
+std::optional<BinaryPrefStore::ReadResult> Parse(const std::string& data) {
+  return BinaryPrefStore::ParseFile(base::as_byte_span(data));
+}
+
+// A log with a snapshot of {"a": 1, "b": {"c": "x", "d": "y"}} followed by
+// changes that turn it into ExpectedPrefs().
+std::string CreateLog() {
+  std::string log = BinaryPrefStore::SerializeSnapshot(
+      base::Value::Dict().Set("a", 1).Set(
+          "b", base::Value::Dict().Set("c", "x").Set("d", "y")));
+  const base::Value two(2);
+  BinaryPrefStore::AppendRecord(RecordOp::kSet, "a", &two, &log);
+  BinaryPrefStore::AppendRecord(RecordOp::kRemove, "b.c", nullptr, &log);
+  const base::Value dotted(true);
+  BinaryPrefStore::AppendRecord(RecordOp::kSet, "e.f", &dotted, &log);
+  return log;
+}
+
+base::Value::Dict ExpectedPrefs() {
+  return base::Value::Dict()
+      .Set("a", 2)
+      .Set("b", base::Value::Dict().Set("d", "y"))
+      .Set("e", base::Value::Dict().Set("f", true));
+}
+
+// Appends a record that sets "g" to 3 to |log|, and returns its size.
+size_t AppendLastRecord(std::string* log) {
+  const size_t size_before = log->size();
+  const base::Value three(3);
+  BinaryPrefStore::AppendRecord(RecordOp::kSet, "g", &three, log);
+  return log->size() - size_before;
+}
+
+}  // namespace
+
+TEST(BinaryPrefStoreParseTest, ReplaysRecordsInOrder) {
+  const std::string log = CreateLog();
+  std::optional<BinaryPrefStore::ReadResult> result = Parse(log);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(ExpectedPrefs(), result->prefs);
+  EXPECT_EQ(log.size(), result->file_size);
+  EXPECT_FALSE(result->needs_compaction);
+}
+
+TEST(BinaryPrefStoreParseTest, RejectsOtherFiles) {
+  EXPECT_FALSE(Parse(""));
+  EXPECT_FALSE(Parse("RPB"));
+  EXPECT_FALSE(Parse("{\"a\": 1}"));
+
+  std::optional<BinaryPrefStore::ReadResult> result = Parse("RPB1");
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->prefs.empty());
+  EXPECT_FALSE(result->needs_compaction);
+}
+
+// A write that was interrupted leaves a partial record at the end of the log.
+TEST(BinaryPrefStoreParseTest, DropsTornRecord) {
+  const std::string log = CreateLog();
+  std::string full_log = log;
+  const size_t record_size = AppendLastRecord(&full_log);
+
+  // Cut inside the size, the hash and the payload.
+  for (size_t torn_size : {size_t{2}, size_t{6}, record_size - 1}) {
+    SCOPED_TRACE(torn_size);
+    std::optional<BinaryPrefStore::ReadResult> result =
+        Parse(full_log.substr(0, log.size() + torn_size));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(ExpectedPrefs(), result->prefs);
+    EXPECT_EQ(log.size(), result->file_size);
+    EXPECT_TRUE(result->needs_compaction);
+  }
+}
+
+TEST(BinaryPrefStoreParseTest, EndsLogAtBadChecksum) {
+  const std::string log = CreateLog();
+  std::string damaged_log = log;
+  AppendLastRecord(&damaged_log);
+  // Flip a bit of the value of the last record, then add a valid record. The
+  // log ends at the damaged record, so the valid one is dropped too.
+  damaged_log.back() ^= 1;
+  AppendLastRecord(&damaged_log);
+
+  std::optional<BinaryPrefStore::ReadResult> result = Parse(damaged_log);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(ExpectedPrefs(), result->prefs);
+  EXPECT_EQ(log.size(), result->file_size);
+  EXPECT_TRUE(result->needs_compaction);
+}
+
+class BinaryPrefStoreTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    json_path_ = temp_dir_.GetPath().AppendASCII("Preferences");
+  }
+
+  // Returns a store that was read synchronously, with its file IO on the
+  // main thread.
+  scoped_refptr<BinaryPrefStore> CreateStore(
+      PersistentPrefStore::PrefReadError expected_error =
+          PersistentPrefStore::PREF_READ_ERROR_NONE) {
+    auto store = base::MakeRefCounted<BinaryPrefStore>(
+        json_path_, task_environment_.GetMainThreadTaskRunner());
+    EXPECT_EQ(expected_error, store->ReadPrefs());
+    return store;
+  }
+
+  // Releases |store|, which writes what it has not written yet.
+  void DestroyStore(scoped_refptr<BinaryPrefStore> store) {
+    store.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  base::FilePath binary_path() const {
+    return BinaryPrefStore::GetBinaryPath(json_path_);
+  }
+
+  std::string ReadBinaryFile() {
+    std::string data;
+    EXPECT_TRUE(base::ReadFileToString(binary_path(), &data));
+    return data;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir temp_dir_;
+  base::FilePath json_path_;
+};
+
+TEST_F(BinaryPrefStoreTest, AppendsChanges) {
+  scoped_refptr<BinaryPrefStore> store =
+      CreateStore(PersistentPrefStore::PREF_READ_ERROR_NO_FILE);
+  store->SetValue("a.b", base::Value(1),
+                  WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  store->SetValue("c", base::Value("x"),
+                  WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  store->CommitPendingWrite();
+  task_environment_.RunUntilIdle();
+  const std::string first_write = ReadBinaryFile();
+
+  store->RemoveValue("c", WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  DestroyStore(std::move(store));
+
+  // Only the removal was appended.
+  const std::string data = ReadBinaryFile();
+  ASSERT_TRUE(data.starts_with(first_write));
+  std::string expected_record;
+  BinaryPrefStore::AppendRecord(RecordOp::kRemove, "c", nullptr,
+                                &expected_record);
+  EXPECT_EQ(expected_record, data.substr(first_write.size()));
+
+  store = CreateStore();
+  EXPECT_EQ(base::Value::Dict().Set("a", base::Value::Dict().Set("b", 1)),
+            store->GetValues());
+}
+
+TEST_F(BinaryPrefStoreTest, CommitsAfterDelay) {
+  scoped_refptr<BinaryPrefStore> store =
+      CreateStore(PersistentPrefStore::PREF_READ_ERROR_NO_FILE);
+  store->SetValue("a", base::Value(1),
+                  WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  task_environment_.FastForwardBy(base::Seconds(9));
+  EXPECT_FALSE(base::PathExists(binary_path()));
+
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_TRUE(base::PathExists(binary_path()));
+  DestroyStore(std::move(store));
+}
+
+TEST_F(BinaryPrefStoreTest, ImportsJson) {
+  ASSERT_TRUE(base::WriteFile(json_path_, R"({"a": 1, "b": {"c": "x"}})"));
+  const base::Value::Dict prefs =
+      base::Value::Dict().Set("a", 1).Set("b", base::Value::Dict().Set("c",
+                                                                       "x"));
+
+  scoped_refptr<BinaryPrefStore> store = CreateStore();
+  EXPECT_EQ(prefs, store->GetValues());
+  DestroyStore(std::move(store));
+
+  EXPECT_EQ(BinaryPrefStore::SerializeSnapshot(prefs), ReadBinaryFile());
+}
+
+// The records that survived a torn write are replayed, and the log is then
+// rewritten without the partial record.
+TEST_F(BinaryPrefStoreTest, ReplaysThenCompactsTornLog) {
+  std::string log = CreateLog();
+  const size_t record_size = AppendLastRecord(&log);
+  log.resize(log.size() - record_size / 2);
+  ASSERT_TRUE(base::WriteFile(binary_path(), log));
+
+  scoped_refptr<BinaryPrefStore> store = CreateStore();
+  EXPECT_EQ(ExpectedPrefs(), store->GetValues());
+  task_environment_.FastForwardBy(base::Seconds(10));
+  EXPECT_EQ(BinaryPrefStore::SerializeSnapshot(ExpectedPrefs()),
+            ReadBinaryFile());
+
+  // Later changes are appended to the compacted log.
+  store->SetValue("g", base::Value(3),
+                  WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  DestroyStore(std::move(store));
+  store = CreateStore();
+  EXPECT_EQ(ExpectedPrefs().Set("g", 3), store->GetValues());
+}
+
+TEST_F(BinaryPrefStoreTest, CompactsGrownLog) {
+  scoped_refptr<BinaryPrefStore> store =
+      CreateStore(PersistentPrefStore::PREF_READ_ERROR_NO_FILE);
+  // Each value is larger than half the size logs are compacted from.
+  for (char c : {'x', 'y', 'z'}) {
+    store->SetValue("a", base::Value(std::string(40 * 1024, c)),
+                    WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+    store->CommitPendingWrite();
+    task_environment_.RunUntilIdle();
+  }
+
+  // The second write compacted the log, the third appended to it.
+  const std::string snapshot = BinaryPrefStore::SerializeSnapshot(
+      base::Value::Dict().Set("a", std::string(40 * 1024, 'y')));
+  std::string record;
+  const base::Value value(std::string(40 * 1024, 'z'));
+  BinaryPrefStore::AppendRecord(RecordOp::kSet, "a", &value, &record);
+  EXPECT_EQ(snapshot + record, ReadBinaryFile());
+  DestroyStore(std::move(store));
+}
+
+TEST_F(BinaryPrefStoreTest, StartsOverWithCorruptedFile) {
+  ASSERT_TRUE(base::WriteFile(binary_path(), "not a pref file"));
+  scoped_refptr<BinaryPrefStore> store =
+      CreateStore(PersistentPrefStore::PREF_READ_ERROR_FILE_OTHER);
+  EXPECT_TRUE(store->GetValues().empty());
+  DestroyStore(std::move(store));
+
+  EXPECT_EQ(BinaryPrefStore::SerializeSnapshot(base::Value::Dict()),
+            ReadBinaryFile());
+}
@@ -0,0 +1,107 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/prefs/pref_commit_scheduler.h"
+
+#include "base/check.h"
+#include "base/containers/contains.h"
+#include "base/functional/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/trace_event/trace_event.h"
+#include "components/prefs/pref_service.h"
+
+PrefCommitScheduler::PrefCommitScheduler() = default;
+
+PrefCommitScheduler::~PrefCommitScheduler() {
+  for (PrefService* service : services_) {
+    service->RemovePrefObserverAllPrefs(this);
+  }
+}
+
+void PrefCommitScheduler::AddPrefService(PrefService* service) {
+  CHECK(service);
+  if (services_.insert(service).second) {
+    service->AddPrefObserverAllPrefs(this);
+  }
+}
+
+void PrefCommitScheduler::RemovePrefService(PrefService* service) {
+  if (!services_.erase(service)) {
+    return;
+  }
+
+  service->RemovePrefObserverAllPrefs(this);
+  dirty_services_.erase(service);
+  base::Erase(queue_, service);
+}
+
+void PrefCommitScheduler::CommitAllNow(
+    base::RepeatingCallback<base::OnceClosure()> get_done_callback) {
+  TRACE_EVENT1("browser", "PrefCommitScheduler::CommitAllNow", "count",
+               services_.size());
+  timer_.Stop();
+  dirty_services_.clear();
+  queue_.clear();
+
+  for (PrefService* service : services_) {
+    service->CommitPendingWrite(base::OnceClosure(), get_done_callback.Run());
+  }
+}
+
+size_t PrefCommitScheduler::GetQueueDepth() const {
+  return dirty_services_.size() + queue_.size();
+}
+
+void PrefCommitScheduler::OnPreferenceChanged(PrefService* service,
+                                              std::string_view pref_name) {
+  dirty_services_.insert(service);
+  if (!timer_.IsRunning()) {
+    timer_.Start(FROM_HERE, kCoalescingWindow,
+                 base::BindOnce(&PrefCommitScheduler::StartBatch,
+                                base::Unretained(this)));
+  }
+}
+
+void PrefCommitScheduler::StartBatch() {
+  TRACE_EVENT1("browser", "PrefCommitScheduler::StartBatch", "count",
+               dirty_services_.size());
+  if (queue_.empty() && commits_in_flight_ == 0) {
+    batch_start_time_ = base::TimeTicks::Now();
+  }
+
+  for (PrefService* service : dirty_services_) {
+    if (!base::Contains(queue_, service)) {
+      queue_.push_back(service);
+    }
+  }
+  dirty_services_.clear();
+  base::UmaHistogramCounts100("Radium.Prefs.CommitScheduler.QueueDepth",
+                              queue_.size());
+
+  while (!queue_.empty() && commits_in_flight_ < kMaxConcurrentCommits) {
+    CommitNext();
+  }
+}
+
+void PrefCommitScheduler::CommitNext() {
+  PrefService* service = queue_.front();
+  queue_.pop_front();
+  ++commits_in_flight_;
+  service->CommitPendingWrite(base::BindOnce(
+      &PrefCommitScheduler::OnCommitDone, weak_ptr_factory_.GetWeakPtr()));
+}
+
+void PrefCommitScheduler::OnCommitDone() {
+  DCHECK_GT(commits_in_flight_, 0u);
+  --commits_in_flight_;
+  if (!queue_.empty()) {
+    CommitNext();
+    return;
+  }
+
+  if (commits_in_flight_ == 0) {
+    base::UmaHistogramMediumTimes("Radium.Prefs.CommitScheduler.FlushLatency",
+                                  base::TimeTicks::Now() - batch_start_time_);
+  }
+}
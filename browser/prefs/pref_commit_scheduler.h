@@ -0,0 +1,79 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_PREFS_PREF_COMMIT_SCHEDULER_H_
+#define RADIUM_BROWSER_PREFS_PREF_COMMIT_SCHEDULER_H_
+
+#include <string_view>
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_set.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/prefs/pref_observer.h"
+
+class PrefService;
+
+// Commits the PrefServices of Local State and of every profile together.
+//
+// A pref store normally schedules its own write after a change, so with many
+// profiles the disk sees a separate write for every profile that changed. The
+// stores of CreatePersistentPrefStore() leave their writes to the scheduler
+// instead, see ScheduledPrefStore. The scheduler collects the PrefServices that
+// changed within kCoalescingWindow and commits them as one batch, with at most
+// kMaxConcurrentCommits commits in flight.
+class PrefCommitScheduler : public PrefObserver {
+ public:
+  // The commit interval of ImportantFileWriter, which the stores would use on
+  // their own. A change waits no longer for the disk than it did before.
+  static constexpr base::TimeDelta kCoalescingWindow = base::Seconds(10);
+  static constexpr size_t kMaxConcurrentCommits = 2;
+
+  PrefCommitScheduler();
+  PrefCommitScheduler(const PrefCommitScheduler&) = delete;
+  PrefCommitScheduler& operator=(const PrefCommitScheduler&) = delete;
+
+  ~PrefCommitScheduler() override;
+
+  // |service| must be removed before it is destroyed.
+  void AddPrefService(PrefService* service);
+  void RemovePrefService(PrefService* service);
+
+  // Commits all PrefServices at once, without the concurrency limit. Used when
+  // the session ends and the data must reach the disk as fast as possible.
+  // |get_done_callback| is run once per PrefService. The closure it returns
+  // runs on the file sequence of that PrefService once its write is done.
+  void CommitAllNow(
+      base::RepeatingCallback<base::OnceClosure()> get_done_callback);
+
+  // Returns the number of PrefServices waiting for a commit.
+  size_t GetQueueDepth() const;
+
+ private:
+  // PrefObserver:
+  void OnPreferenceChanged(PrefService* service,
+                           std::string_view pref_name) override;
+
+  void StartBatch();
+  void CommitNext();
+  void OnCommitDone();
+
+  base::flat_set<raw_ptr<PrefService>> services_;
+
+  // PrefServices changed since the last batch started.
+  base::flat_set<raw_ptr<PrefService>> dirty_services_;
+  // PrefServices of the current batch not committed yet.
+  base::circular_deque<raw_ptr<PrefService>> queue_;
+  size_t commits_in_flight_ = 0;
+  base::TimeTicks batch_start_time_;
+
+  base::OneShotTimer timer_;
+
+  base::WeakPtrFactory<PrefCommitScheduler> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_BROWSER_PREFS_PREF_COMMIT_SCHEDULER_H_
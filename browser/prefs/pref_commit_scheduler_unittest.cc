@@ -0,0 +1,175 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/prefs/pref_commit_scheduler.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/functional/bind.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "components/prefs/pref_service_factory.h"
+#include "components/prefs/testing_pref_store.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr char kPref[] = "test.pref";
+
+// Counts commits and holds their replies until the test finishes them.
+class DeferredCommitPrefStore : public TestingPrefStore {
+ public:
+  DeferredCommitPrefStore() = default;
+
+  // TestingPrefStore:
+  void CommitPendingWrite(
+      base::OnceClosure reply_callback,
+      base::OnceClosure synchronous_done_callback) override {
+    ++commit_count_;
+    if (synchronous_done_callback) {
+      std::move(synchronous_done_callback).Run();
+    }
+    if (reply_callback) {
+      pending_replies_.push_back(std::move(reply_callback));
+    }
+  }
+
+  int commit_count() const { return commit_count_; }
+  bool has_pending_commit() const { return !pending_replies_.empty(); }
+
+  void FinishCommit() {
+    base::OnceClosure reply = std::move(pending_replies_.front());
+    pending_replies_.pop_front();
+    std::move(reply).Run();
+  }
+
+ private:
+  ~DeferredCommitPrefStore() override = default;
+
+  int commit_count_ = 0;
+  base::circular_deque<base::OnceClosure> pending_replies_;
+};
+
+}  // namespace
+
+class PrefCommitSchedulerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 3; ++i) {
+      auto registry = base::MakeRefCounted<PrefRegistrySimple>();
+      registry->RegisterIntegerPref(kPref, 0);
+      stores_.push_back(base::MakeRefCounted<DeferredCommitPrefStore>());
+      PrefServiceFactory factory;
+      factory.set_user_prefs(stores_.back());
+      services_.push_back(factory.Create(registry));
+      scheduler_.AddPrefService(services_.back().get());
+    }
+  }
+
+  void TearDown() override {
+    for (const std::unique_ptr<PrefService>& service : services_) {
+      scheduler_.RemovePrefService(service.get());
+    }
+  }
+
+  int GetTotalCommitCount() const {
+    int count = 0;
+    for (const scoped_refptr<DeferredCommitPrefStore>& store : stores_) {
+      count += store->commit_count();
+    }
+    return count;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::vector<scoped_refptr<DeferredCommitPrefStore>> stores_;
+  std::vector<std::unique_ptr<PrefService>> services_;
+  PrefCommitScheduler scheduler_;
+};
+
+// Changes within the window of the first one are committed together, when
+// the window ends.
+TEST_F(PrefCommitSchedulerTest, BatchesChangesWithinWindow) {
+  base::HistogramTester histogram_tester;
+  services_[0]->SetInteger(kPref, 1);
+  task_environment_.FastForwardBy(base::Seconds(4));
+  services_[1]->SetInteger(kPref, 1);
+  services_[0]->SetInteger(kPref, 2);
+  EXPECT_EQ(2u, scheduler_.GetQueueDepth());
+
+  task_environment_.FastForwardBy(PrefCommitScheduler::kCoalescingWindow -
+                                  base::Seconds(4) - base::Milliseconds(1));
+  EXPECT_EQ(0, GetTotalCommitCount());
+
+  task_environment_.FastForwardBy(base::Milliseconds(1));
+  EXPECT_EQ(1, stores_[0]->commit_count());
+  EXPECT_EQ(1, stores_[1]->commit_count());
+  EXPECT_EQ(0, stores_[2]->commit_count());
+  EXPECT_EQ(0u, scheduler_.GetQueueDepth());
+  histogram_tester.ExpectUniqueSample("Radium.Prefs.CommitScheduler.QueueDepth",
+                                      2, 1);
+}
+
+TEST_F(PrefCommitSchedulerTest, LimitsConcurrentCommits) {
+  base::HistogramTester histogram_tester;
+  for (const std::unique_ptr<PrefService>& service : services_) {
+    service->SetInteger(kPref, 1);
+  }
+  task_environment_.FastForwardBy(PrefCommitScheduler::kCoalescingWindow);
+  EXPECT_EQ(2, GetTotalCommitCount());
+  EXPECT_EQ(1u, scheduler_.GetQueueDepth());
+
+  // The last service is committed once a commit is done.
+  for (const scoped_refptr<DeferredCommitPrefStore>& store : stores_) {
+    if (store->has_pending_commit()) {
+      store->FinishCommit();
+      break;
+    }
+  }
+  EXPECT_EQ(3, GetTotalCommitCount());
+  EXPECT_EQ(0u, scheduler_.GetQueueDepth());
+
+  for (const scoped_refptr<DeferredCommitPrefStore>& store : stores_) {
+    while (store->has_pending_commit()) {
+      store->FinishCommit();
+    }
+  }
+  histogram_tester.ExpectTotalCount(
+      "Radium.Prefs.CommitScheduler.FlushLatency", 1);
+}
+
+TEST_F(PrefCommitSchedulerTest, CommitAllNow) {
+  services_[0]->SetInteger(kPref, 1);
+
+  int done_count = 0;
+  scheduler_.CommitAllNow(base::BindLambdaForTesting([&] {
+    return base::OnceClosure(base::BindLambdaForTesting([&] { ++done_count; }));
+  }));
+  EXPECT_EQ(3, done_count);
+  for (const scoped_refptr<DeferredCommitPrefStore>& store : stores_) {
+    EXPECT_EQ(1, store->commit_count());
+  }
+
+  // The pending batch was committed with the others.
+  task_environment_.FastForwardBy(PrefCommitScheduler::kCoalescingWindow);
+  EXPECT_EQ(3, GetTotalCommitCount());
+}
+
+TEST_F(PrefCommitSchedulerTest, SkipsRemovedService) {
+  services_[0]->SetInteger(kPref, 1);
+  services_[1]->SetInteger(kPref, 1);
+  scheduler_.RemovePrefService(services_[0].get());
+  EXPECT_EQ(1u, scheduler_.GetQueueDepth());
+
+  task_environment_.FastForwardBy(PrefCommitScheduler::kCoalescingWindow);
+  EXPECT_EQ(0, stores_[0]->commit_count());
+  EXPECT_EQ(1, stores_[1]->commit_count());
+}
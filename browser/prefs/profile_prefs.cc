@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "components/certificate_transparency/pref_names.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
@@ -34,6 +35,13 @@ void RegisterProfilePrefs(user_prefs::PrefRegistrySyncable* registry,
   registry->RegisterBooleanPref(prefs::kIPv6ReachabilityOverrideEnabled, false);
   registry->RegisterBooleanPref(
       prefs::kAccessControlAllowMethodsInCORSPreflightSpecConformant, true);
+  registry->RegisterBooleanPref(prefs::kBackgroundContentsDiscardingEnabled,
+                                true);
+  registry->RegisterTimeDeltaPref(prefs::kBackgroundContentsFreezeDelay,
+                                  base::Minutes(5));
+  registry->RegisterBooleanPref(prefs::kBackgroundContentsFreezingEnabled,
+                                true);
+  registry->RegisterDictionaryPref(prefs::kBadgingLastBadgingTimes);
 }
 
 }  // namespace prefs
@@ -0,0 +1,146 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/prefs/scheduled_pref_store.h"
+
+#include <optional>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
+
+namespace {
+
+// Lossy writes are kept in memory until the store is committed.
+uint32_t ToLossy(uint32_t flags) {
+  return flags | WriteablePrefStore::LOSSY_PREF_WRITE_FLAG;
+}
+
+// Runs on the file sequence, after the write.
+void RecordJsonBytesWritten(const base::FilePath& json_path) {
+  std::optional<int64_t> size = base::GetFileSize(json_path);
+  if (size) {
+    base::UmaHistogramCounts10M("Radium.Prefs.JsonStore.BytesWritten",
+                                base::saturated_cast<int>(*size));
+  }
+}
+
+}  // namespace
+
+ScheduledPrefStore::ScheduledPrefStore(
+    scoped_refptr<PersistentPrefStore> store,
+    const base::FilePath& json_path)
+    : store_(std::move(store)), json_path_(json_path) {}
+
+ScheduledPrefStore::~ScheduledPrefStore() = default;
+
+bool ScheduledPrefStore::GetValue(std::string_view key,
+                                  const base::Value** result) const {
+  return store_->GetValue(key, result);
+}
+
+base::Value::Dict ScheduledPrefStore::GetValues() const {
+  return store_->GetValues();
+}
+
+void ScheduledPrefStore::AddObserver(PrefStore::Observer* observer) {
+  store_->AddObserver(observer);
+}
+
+void ScheduledPrefStore::RemoveObserver(PrefStore::Observer* observer) {
+  store_->RemoveObserver(observer);
+}
+
+bool ScheduledPrefStore::HasObservers() const {
+  return store_->HasObservers();
+}
+
+bool ScheduledPrefStore::IsInitializationComplete() const {
+  return store_->IsInitializationComplete();
+}
+
+bool ScheduledPrefStore::GetMutableValue(std::string_view key,
+                                         base::Value** result) {
+  return store_->GetMutableValue(key, result);
+}
+
+void ScheduledPrefStore::SetValue(std::string_view key,
+                                  base::Value value,
+                                  uint32_t flags) {
+  has_changes_ = true;
+  store_->SetValue(key, std::move(value), ToLossy(flags));
+}
+
+void ScheduledPrefStore::SetValueSilently(std::string_view key,
+                                          base::Value value,
+                                          uint32_t flags) {
+  has_changes_ = true;
+  store_->SetValueSilently(key, std::move(value), ToLossy(flags));
+}
+
+void ScheduledPrefStore::RemoveValue(std::string_view key, uint32_t flags) {
+  has_changes_ = true;
+  store_->RemoveValue(key, ToLossy(flags));
+}
+
+void ScheduledPrefStore::RemoveValuesByPrefixSilently(
+    std::string_view prefix) {
+  // Not a lossy write, but rare enough to let the store schedule it.
+  has_changes_ = true;
+  store_->RemoveValuesByPrefixSilently(prefix);
+}
+
+bool ScheduledPrefStore::ReadOnly() const {
+  return store_->ReadOnly();
+}
+
+PersistentPrefStore::PrefReadError ScheduledPrefStore::GetReadError() const {
+  return store_->GetReadError();
+}
+
+PersistentPrefStore::PrefReadError ScheduledPrefStore::ReadPrefs() {
+  return store_->ReadPrefs();
+}
+
+void ScheduledPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
+  store_->ReadPrefsAsync(error_delegate);
+}
+
+void ScheduledPrefStore::CommitPendingWrite(
+    base::OnceClosure reply_callback,
+    base::OnceClosure synchronous_done_callback) {
+  if (has_changes_ && !json_path_.empty()) {
+    base::OnceClosure record_bytes_written =
+        base::BindOnce(&RecordJsonBytesWritten, json_path_);
+    synchronous_done_callback =
+        synchronous_done_callback
+            ? std::move(record_bytes_written)
+                  .Then(std::move(synchronous_done_callback))
+            : std::move(record_bytes_written);
+  }
+  has_changes_ = false;
+  store_->CommitPendingWrite(std::move(reply_callback),
+                             std::move(synchronous_done_callback));
+}
+
+void ScheduledPrefStore::SchedulePendingLossyWrites() {
+  store_->SchedulePendingLossyWrites();
+}
+
+void ScheduledPrefStore::ReportValueChanged(std::string_view key,
+                                            uint32_t flags) {
+  has_changes_ = true;
+  store_->ReportValueChanged(key, ToLossy(flags));
+}
+
+void ScheduledPrefStore::OnStoreDeletionFromDisk() {
+  has_changes_ = false;
+  store_->OnStoreDeletionFromDisk();
+}
+
+bool ScheduledPrefStore::HasReadErrorDelegate() const {
+  return store_->HasReadErrorDelegate();
+}
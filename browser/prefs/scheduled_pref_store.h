@@ -0,0 +1,73 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_PREFS_SCHEDULED_PREF_STORE_H_
+#define RADIUM_BROWSER_PREFS_SCHEDULED_PREF_STORE_H_
+
+#include <string_view>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/values.h"
+#include "components/prefs/persistent_pref_store.h"
+
+// Wraps the store of a PrefService that PrefCommitScheduler commits. Every
+// change is passed on as a lossy write, so the wrapped store does not start
+// its own commit timer and only writes when CommitPendingWrite() is called.
+// The scheduler then decides when the stores of all PrefServices are written.
+class ScheduledPrefStore final : public PersistentPrefStore {
+ public:
+  // |json_path| is the file of |store| if it is a JsonPrefStore, and empty
+  // otherwise. A JsonPrefStore rewrites its whole file on every commit, so
+  // the size of the file is recorded after each commit with changes.
+  ScheduledPrefStore(scoped_refptr<PersistentPrefStore> store,
+                     const base::FilePath& json_path);
+  ScheduledPrefStore(const ScheduledPrefStore&) = delete;
+  ScheduledPrefStore& operator=(const ScheduledPrefStore&) = delete;
+
+  // PrefStore:
+  bool GetValue(std::string_view key,
+                const base::Value** result) const override;
+  base::Value::Dict GetValues() const override;
+  void AddObserver(PrefStore::Observer* observer) override;
+  void RemoveObserver(PrefStore::Observer* observer) override;
+  bool HasObservers() const override;
+  bool IsInitializationComplete() const override;
+
+  // PersistentPrefStore:
+  bool GetMutableValue(std::string_view key, base::Value** result) override;
+  void SetValue(std::string_view key,
+                base::Value value,
+                uint32_t flags) override;
+  void SetValueSilently(std::string_view key,
+                        base::Value value,
+                        uint32_t flags) override;
+  void RemoveValue(std::string_view key, uint32_t flags) override;
+  void RemoveValuesByPrefixSilently(std::string_view prefix) override;
+  bool ReadOnly() const override;
+  PrefReadError GetReadError() const override;
+  PrefReadError ReadPrefs() override;
+  void ReadPrefsAsync(ReadErrorDelegate* error_delegate) override;
+  void CommitPendingWrite(
+      base::OnceClosure reply_callback = base::OnceClosure(),
+      base::OnceClosure synchronous_done_callback =
+          base::OnceClosure()) override;
+  void SchedulePendingLossyWrites() override;
+  void ReportValueChanged(std::string_view key, uint32_t flags) override;
+  void OnStoreDeletionFromDisk() override;
+  bool HasReadErrorDelegate() const override;
+
+ private:
+  // The wrapped store writes what is left when it is destroyed.
+  ~ScheduledPrefStore() override;
+
+  const scoped_refptr<PersistentPrefStore> store_;
+  const base::FilePath json_path_;
+
+  // Whether a change was passed on since the last commit.
+  bool has_changes_ = false;
+};
+
+#endif  // RADIUM_BROWSER_PREFS_SCHEDULED_PREF_STORE_H_
@@ -0,0 +1,90 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/prefs/scheduled_pref_store.h"
+
+#include <memory>
+#include <optional>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "components/prefs/json_pref_store.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "components/prefs/pref_service_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr char kPref[] = "test.pref";
+constexpr char kBytesWrittenHistogram[] =
+    "Radium.Prefs.JsonStore.BytesWritten";
+
+}  // namespace
+
+class ScheduledPrefStoreTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    json_path_ = temp_dir_.GetPath().AppendASCII("Preferences");
+
+    store_ = base::MakeRefCounted<ScheduledPrefStore>(
+        base::MakeRefCounted<JsonPrefStore>(
+            json_path_, nullptr, task_environment_.GetMainThreadTaskRunner()),
+        json_path_);
+    auto registry = base::MakeRefCounted<PrefRegistrySimple>();
+    registry->RegisterIntegerPref(kPref, 0);
+    PrefServiceFactory factory;
+    factory.set_user_prefs(store_);
+    service_ = factory.Create(registry);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir temp_dir_;
+  base::FilePath json_path_;
+  scoped_refptr<ScheduledPrefStore> store_;
+  std::unique_ptr<PrefService> service_;
+};
+
+// The JsonPrefStore does not write on its own timer.
+TEST_F(ScheduledPrefStoreTest, WritesOnlyWhenCommitted) {
+  base::HistogramTester histogram_tester;
+  service_->SetInteger(kPref, 1);
+  task_environment_.FastForwardBy(base::Minutes(1));
+  EXPECT_FALSE(base::PathExists(json_path_));
+
+  service_->CommitPendingWrite();
+  task_environment_.RunUntilIdle();
+  std::optional<int64_t> size = base::GetFileSize(json_path_);
+  ASSERT_TRUE(size);
+  histogram_tester.ExpectUniqueSample(kBytesWrittenHistogram,
+                                      static_cast<int>(*size), 1);
+}
+
+TEST_F(ScheduledPrefStoreTest, RecordsBytesWrittenOnlyForChanges) {
+  base::HistogramTester histogram_tester;
+  service_->CommitPendingWrite();
+  task_environment_.RunUntilIdle();
+  histogram_tester.ExpectTotalCount(kBytesWrittenHistogram, 0);
+
+  service_->SetInteger(kPref, 1);
+  service_->CommitPendingWrite();
+  service_->CommitPendingWrite();
+  task_environment_.RunUntilIdle();
+  histogram_tester.ExpectTotalCount(kBytesWrittenHistogram, 1);
+}
+
+// What is left is written when the PrefService goes away.
+TEST_F(ScheduledPrefStoreTest, WritesOnDestruction) {
+  service_->SetInteger(kPref, 1);
+  service_.reset();
+  store_.reset();
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(json_path_));
+}
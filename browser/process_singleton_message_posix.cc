@@ -0,0 +1,178 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/process_singleton_message_posix.h"
+
+#include "base/check_op.h"
+#include "base/containers/span.h"
+#include "base/numerics/byte_conversions.h"
+#include "base/numerics/checked_math.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_split.h"
+
+namespace internal {
+
+namespace {
+
+constexpr std::string_view kMagic = "RPSM";
+constexpr char kTokenDelimiter = '\0';
+
+void AppendBytes(base::span<const uint8_t> bytes, std::string* output) {
+  output->append(bytes.begin(), bytes.end());
+}
+
+void AppendU32(size_t value, std::string* output) {
+  AppendBytes(base::U32ToLittleEndian(base::checked_cast<uint32_t>(value)),
+              output);
+}
+
+uint32_t ReadU32(base::span<const uint8_t> data, size_t offset) {
+  return base::U32FromLittleEndian(data.subspan(offset).first<4u>());
+}
+
+}  // namespace
+
+ProcessSingletonMessage::ProcessSingletonMessage() = default;
+ProcessSingletonMessage::ProcessSingletonMessage(ProcessSingletonMessage&&) =
+    default;
+ProcessSingletonMessage& ProcessSingletonMessage::operator=(
+    ProcessSingletonMessage&&) = default;
+ProcessSingletonMessage::~ProcessSingletonMessage() = default;
+
+std::string EncodeBinaryProcessSingletonMessage(
+    std::string_view current_dir,
+    const std::vector<std::string>& argv) {
+  const size_t count = argv.size() + 1;
+  size_t string_size = current_dir.size();
+  for (const std::string& arg : argv) {
+    string_size += arg.size();
+  }
+  const size_t body_size = 4 + 4 * count + string_size;
+
+  std::string message;
+  message.reserve(kProcessSingletonHeaderSize + body_size);
+  message.append(kMagic);
+  AppendBytes(base::U16ToLittleEndian(kProcessSingletonMessageVersion),
+              &message);
+  AppendBytes(base::U16ToLittleEndian(0), &message);
+  AppendU32(body_size, &message);
+
+  AppendU32(count, &message);
+  size_t end_offset = current_dir.size();
+  AppendU32(end_offset, &message);
+  for (const std::string& arg : argv) {
+    end_offset += arg.size();
+    AppendU32(end_offset, &message);
+  }
+
+  message.append(current_dir);
+  for (const std::string& arg : argv) {
+    message.append(arg);
+  }
+  return message;
+}
+
+std::string EncodeTextProcessSingletonMessage(
+    std::string_view current_dir,
+    const std::vector<std::string>& argv) {
+  std::string message(kProcessSingletonStartToken);
+  message.push_back(kTokenDelimiter);
+  message.append(current_dir);
+  for (const std::string& arg : argv) {
+    message.push_back(kTokenDelimiter);
+    message.append(arg);
+  }
+  return message;
+}
+
+bool IsBinaryProcessSingletonMessage(base::span<const uint8_t> data) {
+  return data.size() >= kMagic.size() &&
+         base::as_string_view(data.first(kMagic.size())) == kMagic;
+}
+
+std::optional<size_t> GetBinaryProcessSingletonMessageSize(
+    base::span<const uint8_t> header) {
+  CHECK_GE(header.size(), kProcessSingletonHeaderSize);
+  if (!IsBinaryProcessSingletonMessage(header)) {
+    return std::nullopt;
+  }
+  // Newer versions are expected to use a different magic if they are not
+  // compatible with this one.
+  const uint16_t version = base::U16FromLittleEndian(header.subspan<4, 2>());
+  if (version < kProcessSingletonMessageVersion) {
+    return std::nullopt;
+  }
+  const uint32_t body_size = ReadU32(header, 8);
+  if (body_size < 4 || body_size > kMaxBinaryMessageBodySize) {
+    return std::nullopt;
+  }
+  return kProcessSingletonHeaderSize + body_size;
+}
+
+std::optional<ProcessSingletonMessage> DecodeBinaryProcessSingletonMessage(
+    base::span<const uint8_t> data) {
+  if (data.size() < kProcessSingletonHeaderSize ||
+      GetBinaryProcessSingletonMessageSize(data) != data.size()) {
+    return std::nullopt;
+  }
+
+  base::span<const uint8_t> body = data.subspan(kProcessSingletonHeaderSize);
+  const uint32_t count = ReadU32(body, 0);
+  // There is at least the current directory.
+  base::CheckedNumeric<size_t> offsets_size = count;
+  offsets_size *= 4;
+  offsets_size += 4;
+  if (count == 0 || !offsets_size.IsValid() ||
+      offsets_size.ValueOrDie() > body.size()) {
+    return std::nullopt;
+  }
+  base::span<const uint8_t> offsets =
+      body.subspan(4u, offsets_size.ValueOrDie() - 4);
+  std::string_view strings =
+      base::as_string_view(body.subspan(offsets_size.ValueOrDie()));
+
+  ProcessSingletonMessage message;
+  message.argv.reserve(count - 1);
+  size_t start = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    const size_t end = ReadU32(offsets, 4 * i);
+    if (end < start || end > strings.size()) {
+      return std::nullopt;
+    }
+    std::string_view value = strings.substr(start, end - start);
+    if (i == 0) {
+      message.current_dir = value;
+    } else {
+      message.argv.push_back(value);
+    }
+    start = end;
+  }
+  if (start != strings.size()) {
+    return std::nullopt;
+  }
+  return message;
+}
+
+std::optional<ProcessSingletonMessage> DecodeTextProcessSingletonMessage(
+    std::string_view data) {
+  // The shortest message is kProcessSingletonStartToken\0x\0x
+  if (data.size() < kProcessSingletonStartToken.size() + 4) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string_view> tokens =
+      base::SplitStringPiece(data, std::string_view(&kTokenDelimiter, 1),
+                             base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (tokens.size() < 3 || tokens[0] != kProcessSingletonStartToken) {
+    return std::nullopt;
+  }
+
+  ProcessSingletonMessage message;
+  message.current_dir = tokens[1];
+  // The remaining tokens are the command line argv array.
+  message.argv.assign(tokens.begin() + 2, tokens.end());
+  return message;
+}
+
+}  // namespace internal
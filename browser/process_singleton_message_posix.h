@@ -0,0 +1,84 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_PROCESS_SINGLETON_MESSAGE_POSIX_H_
+#define RADIUM_BROWSER_PROCESS_SINGLETON_MESSAGE_POSIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/span.h"
+
+// Encoding of the message a second browser process sends to the running one
+// over the ProcessSingleton socket.
+//
+// Binary format, all integers little endian:
+//   header: uint32 magic "RPSM", uint16 version, uint16 reserved (0),
+//           uint32 body size
+//   body:   uint32 count, uint32 end offset[count], string data
+// The first string is the current directory of the sending process, the
+// others are its argv. String i spans [end offset[i - 1], end offset[i]) of
+// the string data, with the end offset of string -1 being 0.
+//
+// The legacy text format is "START\0<current dir>\0<argv[0]>\0...<argv[n]>".
+// It is still accepted from older clients, but is limited to
+// kMaxTextMessageLength bytes.
+namespace internal {
+
+inline constexpr size_t kProcessSingletonHeaderSize = 12;
+inline constexpr uint16_t kProcessSingletonMessageVersion = 1;
+// Upper bound for the body of a binary message, to reject garbage before
+// allocating a buffer for it.
+inline constexpr size_t kMaxBinaryMessageBodySize = 16 * 1024 * 1024;
+inline constexpr size_t kMaxTextMessageLength = 32 * 1024;
+inline constexpr std::string_view kProcessSingletonStartToken = "START";
+
+// A decoded message. The strings point into the buffer it was decoded from.
+struct ProcessSingletonMessage {
+  ProcessSingletonMessage();
+  ProcessSingletonMessage(ProcessSingletonMessage&&);
+  ProcessSingletonMessage& operator=(ProcessSingletonMessage&&);
+  ~ProcessSingletonMessage();
+
+  std::string_view current_dir;
+  std::vector<std::string_view> argv;
+};
+
+// Returns the binary message for |current_dir| and |argv|.
+std::string EncodeBinaryProcessSingletonMessage(
+    std::string_view current_dir,
+    const std::vector<std::string>& argv);
+
+// Returns the legacy text message for |current_dir| and |argv|.
+std::string EncodeTextProcessSingletonMessage(
+    std::string_view current_dir,
+    const std::vector<std::string>& argv);
+
+// Returns true if |data| starts like a binary message. Needs at least four
+// bytes to tell.
+bool IsBinaryProcessSingletonMessage(base::span<const uint8_t> data);
+
+// Returns the total size of the binary message starting with |header|, or
+// nullopt if the header is invalid. |header| must hold at least
+// kProcessSingletonHeaderSize bytes.
+std::optional<size_t> GetBinaryProcessSingletonMessageSize(
+    base::span<const uint8_t> header);
+
+// Decodes a complete binary message without copying the strings. Returns
+// nullopt if |data| is malformed.
+std::optional<ProcessSingletonMessage> DecodeBinaryProcessSingletonMessage(
+    base::span<const uint8_t> data);
+
+// Decodes a message in the legacy text format, see above.
+std::optional<ProcessSingletonMessage> DecodeTextProcessSingletonMessage(
+    std::string_view data);
+
+}  // namespace internal
+
+#endif  // RADIUM_BROWSER_PROCESS_SINGLETON_MESSAGE_POSIX_H_
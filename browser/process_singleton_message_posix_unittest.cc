@@ -0,0 +1,165 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/process_singleton_message_posix.h"
+
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/numerics/byte_conversions.h"
+#include "base/numerics/safe_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace internal {
+
+namespace {
+
+constexpr std::string_view kCurrentDir = "/home/user";
+
+std::vector<std::string> CreateArgv() {
+  return {"/opt/radium/radium", "--flag", "", "/tmp/file.html"};
+}
+
+std::optional<ProcessSingletonMessage> DecodeBinary(std::string_view data) {
+  return DecodeBinaryProcessSingletonMessage(base::as_byte_span(data));
+}
+
+void ExpectMessage(const std::optional<ProcessSingletonMessage>& message) {
+  ASSERT_TRUE(message);
+  EXPECT_EQ(kCurrentDir, message->current_dir);
+  const std::vector<std::string> argv = CreateArgv();
+  EXPECT_EQ(std::vector<std::string_view>(argv.begin(), argv.end()),
+            message->argv);
+}
+
+// Overwrites the little endian uint32 at |offset| of |message|.
+void SetU32(size_t offset, size_t value, std::string* message) {
+  const std::array<uint8_t, 4u> bytes =
+      base::U32ToLittleEndian(base::checked_cast<uint32_t>(value));
+  message->replace(offset, bytes.size(), base::as_string_view(bytes));
+}
+
+}  // namespace
+
+TEST(ProcessSingletonMessageTest, RoundTripsBinaryMessage) {
+  const std::string message =
+      EncodeBinaryProcessSingletonMessage(kCurrentDir, CreateArgv());
+  EXPECT_TRUE(IsBinaryProcessSingletonMessage(base::as_byte_span(message)));
+  EXPECT_EQ(message.size(), GetBinaryProcessSingletonMessageSize(
+                                base::as_byte_span(message)));
+  ExpectMessage(DecodeBinary(message));
+}
+
+TEST(ProcessSingletonMessageTest, RejectsTruncatedMessage) {
+  const std::string message =
+      EncodeBinaryProcessSingletonMessage(kCurrentDir, CreateArgv());
+  // Cut inside the header, right after it and inside the body.
+  for (size_t size : {size_t{0}, size_t{4}, kProcessSingletonHeaderSize - 1,
+                      kProcessSingletonHeaderSize, message.size() - 1}) {
+    SCOPED_TRACE(size);
+    EXPECT_FALSE(DecodeBinary(message.substr(0, size)));
+  }
+  // Bytes past the announced body are not part of the message either.
+  EXPECT_FALSE(DecodeBinary(message + "x"));
+}
+
+TEST(ProcessSingletonMessageTest, RejectsBadHeader) {
+  const std::string message =
+      EncodeBinaryProcessSingletonMessage(kCurrentDir, CreateArgv());
+
+  std::string bad_magic = message;
+  bad_magic[3] = 'X';
+  EXPECT_FALSE(IsBinaryProcessSingletonMessage(base::as_byte_span(bad_magic)));
+  EXPECT_FALSE(GetBinaryProcessSingletonMessageSize(
+      base::as_byte_span(bad_magic)));
+  EXPECT_FALSE(DecodeBinary(bad_magic));
+
+  std::string old_version = message;
+  old_version[4] = 0;
+  EXPECT_FALSE(GetBinaryProcessSingletonMessageSize(
+      base::as_byte_span(old_version)));
+  EXPECT_FALSE(DecodeBinary(old_version));
+}
+
+// The size is rejected from the header alone, before a buffer is allocated
+// for the body.
+TEST(ProcessSingletonMessageTest, RejectsOversizedBody) {
+  std::string header =
+      EncodeBinaryProcessSingletonMessage(kCurrentDir, CreateArgv())
+          .substr(0, kProcessSingletonHeaderSize);
+  SetU32(8, kMaxBinaryMessageBodySize + 1, &header);
+  EXPECT_FALSE(
+      GetBinaryProcessSingletonMessageSize(base::as_byte_span(header)));
+
+  SetU32(8, kMaxBinaryMessageBodySize, &header);
+  EXPECT_EQ(kProcessSingletonHeaderSize + kMaxBinaryMessageBodySize,
+            GetBinaryProcessSingletonMessageSize(base::as_byte_span(header)));
+
+  // Too small to hold the string count.
+  SetU32(8, 3, &header);
+  EXPECT_FALSE(
+      GetBinaryProcessSingletonMessageSize(base::as_byte_span(header)));
+}
+
+TEST(ProcessSingletonMessageTest, RejectsBadStringTable) {
+  const std::string message =
+      EncodeBinaryProcessSingletonMessage(kCurrentDir, CreateArgv());
+  constexpr size_t kCountOffset = kProcessSingletonHeaderSize;
+  constexpr size_t kFirstEndOffset = kCountOffset + 4;
+
+  // No current directory.
+  std::string no_strings = message;
+  SetU32(kCountOffset, 0, &no_strings);
+  EXPECT_FALSE(DecodeBinary(no_strings));
+
+  // More offsets than the body holds.
+  for (uint32_t count : {uint32_t{1000}, uint32_t{0xFFFFFFFF}}) {
+    std::string bad_count = message;
+    SetU32(kCountOffset, count, &bad_count);
+    EXPECT_FALSE(DecodeBinary(bad_count));
+  }
+
+  // A string ending past the string data.
+  std::string past_end = message;
+  SetU32(kFirstEndOffset, 0xFFFF, &past_end);
+  EXPECT_FALSE(DecodeBinary(past_end));
+
+  // A string ending before it starts.
+  std::string backwards = message;
+  SetU32(kFirstEndOffset + 4, 0, &backwards);
+  EXPECT_FALSE(DecodeBinary(backwards));
+
+  // Bytes of string data no string covers.
+  std::string one_less = EncodeBinaryProcessSingletonMessage(
+      kCurrentDir, {"/opt/radium/radium"});
+  SetU32(kFirstEndOffset + 4, kCurrentDir.size() + 1, &one_less);
+  EXPECT_FALSE(DecodeBinary(one_less));
+}
+
+// Older clients still send the text format, which the binary magic tells
+// apart.
+TEST(ProcessSingletonMessageTest, DecodesTextFallback) {
+  const std::string message =
+      EncodeTextProcessSingletonMessage(kCurrentDir, CreateArgv());
+  EXPECT_FALSE(IsBinaryProcessSingletonMessage(base::as_byte_span(message)));
+  ExpectMessage(DecodeTextProcessSingletonMessage(message));
+}
+
+TEST(ProcessSingletonMessageTest, RejectsBadTextMessage) {
+  EXPECT_FALSE(DecodeTextProcessSingletonMessage(""));
+  EXPECT_FALSE(DecodeTextProcessSingletonMessage("START"));
+  EXPECT_FALSE(DecodeTextProcessSingletonMessage(std::string_view(
+      "START\0/home", 11)));
+  EXPECT_FALSE(DecodeTextProcessSingletonMessage(
+      EncodeTextProcessSingletonMessage(kCurrentDir, CreateArgv())
+          .replace(0, 5, "STOP!")));
+}
+
+}  // namespace internal
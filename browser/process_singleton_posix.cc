@@ -55,14 +55,18 @@
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "base/base_paths.h"
 #include "base/command_line.h"
+#include "base/containers/span.h"
 #include "base/containers/unique_ptr_adapters.h"
 #include "base/files/file_descriptor_watcher_posix.h"
 #include "base/files/file_path.h"
@@ -79,7 +83,6 @@
 #include "base/posix/safe_strerror.h"
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
-#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
@@ -95,6 +98,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "net/base/network_interfaces.h"
 #include "radium/browser/process_singleton_internal.h"
+#include "radium/browser/process_singleton_message_posix.h"
 #include "radium/common/process_singleton_lock_posix.h"
 #include "radium/common/radium_constants.h"
 #include "radium/grit/radium_strings.h"
@@ -137,11 +141,8 @@ constexpr int kTimeoutInSeconds = 20;
 // Number of retries to notify the browser. 20 retries over 20 seconds = 1 try
 // per second.
 constexpr int kRetryAttempts = 20;
-constexpr std::string_view kStartToken = "START";
 constexpr std::string_view kACKToken = "ACK";
 constexpr std::string_view kShutdownToken = "SHUTDOWN";
-constexpr char kTokenDelimiter = '\0';
-constexpr int kMaxMessageLength = 32 * 1024;
 constexpr int kMaxACKMessageLength = kShutdownToken.size() - 1;
 
 const base::FilePath::CharType kSingletonCookieFilename[] =
@@ -197,6 +198,15 @@ bool WriteToSocket(int fd, std::string_view message) {
   return true;
 }
 
+// Returns true if the other end of |fd| closed the connection and there is
+// nothing left to read. A peer that closes without reading all that was sent
+// resets the connection.
+bool IsClosedByPeer(int fd) {
+  char c;
+  ssize_t rv = HANDLE_EINTR(recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT));
+  return rv == 0 || (rv < 0 && (errno == ECONNRESET || errno == EPIPE));
+}
+
 struct timeval TimeDeltaToTimeVal(const base::TimeDelta& delta) {
   struct timeval result;
   result.tv_sec = delta.InSeconds();
@@ -543,8 +553,7 @@ class ProcessSingleton::LinuxWatcher
                  int fd)
         : parent_(parent),
           ui_task_runner_(ui_task_runner),
-          fd_(fd),
-          bytes_read_(0) {
+          fd_(fd) {
       DCHECK_CURRENTLY_ON(BrowserThread::IO);
       // Wait for reads.
       fd_watch_controller_ = base::FileDescriptorWatcher::WatchReadable(
@@ -567,6 +576,9 @@ class ProcessSingleton::LinuxWatcher
    private:
     void OnSocketCanReadWithoutBlocking();
 
+    // Returns how many bytes are still missing from the message in |buffer_|.
+    size_t GetBytesToRead() const;
+
     void CleanupAndDeleteSelf() {
       DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
@@ -587,12 +599,20 @@ class ProcessSingleton::LinuxWatcher
     // The file descriptor we're reading.
     const int fd_;
 
-    // Store the message in this buffer.
-    char buf_[kMaxMessageLength];
+    // Stores the message, which is decoded in place once complete.
+    std::vector<uint8_t> buffer_;
 
-    // Tracks the number of bytes we've read in case we're getting partial
-    // reads.
-    size_t bytes_read_;
+    enum class Format {
+      // Not enough has been read yet to tell.
+      kUnknown,
+      // See process_singleton_message_posix.h.
+      kBinary,
+      kText,
+    };
+    Format format_ = Format::kUnknown;
+
+    // The size of a binary message, known once its header has been read.
+    size_t message_size_ = 0;
 
     base::OneShotTimer timer_;
   };
@@ -612,8 +632,8 @@ class ProcessSingleton::LinuxWatcher
   // This method determines if we should use the same process and if we should,
   // opens a new browser tab.  This runs on the UI thread.
   // |reader| is for sending back ACK message.
-  void HandleMessage(const std::string& current_dir,
-                     const std::vector<std::string>& argv,
+  // The strings of |message| point into the buffer of |reader|.
+  void HandleMessage(internal::ProcessSingletonMessage message,
                      SocketReader* reader);
 
   // Called when the ProcessSingleton that owns this class is about to be
@@ -671,14 +691,16 @@ void ProcessSingleton::LinuxWatcher::StartListening(int socket) {
 }
 
 void ProcessSingleton::LinuxWatcher::HandleMessage(
-    const std::string& current_dir,
-    const std::vector<std::string>& argv,
+    internal::ProcessSingletonMessage message,
     SocketReader* reader) {
   DCHECK(ui_task_runner_->BelongsToCurrentThread());
   DCHECK(reader);
 
-  if (parent_ && parent_->notification_callback_.Run(
-                     base::CommandLine(argv), base::FilePath(current_dir))) {
+  if (parent_ &&
+      parent_->notification_callback_.Run(
+          base::CommandLine(base::CommandLine::StringVector(
+              message.argv.begin(), message.argv.end())),
+          base::FilePath(message.current_dir))) {
     // Send back "ACK" message to prevent the client process from starting up.
     reader->FinishWithACK(kACKToken);
   } else {
@@ -705,9 +727,13 @@ void ProcessSingleton::LinuxWatcher::RemoveSocketReader(SocketReader* reader) {
 void ProcessSingleton::LinuxWatcher::SocketReader::
     OnSocketCanReadWithoutBlocking() {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  while (bytes_read_ < sizeof(buf_)) {
+  for (size_t bytes_to_read = GetBytesToRead(); bytes_to_read > 0;
+       bytes_to_read = GetBytesToRead()) {
+    const size_t bytes_read = buffer_.size();
+    buffer_.resize(bytes_read + bytes_to_read);
     ssize_t rv =
-        HANDLE_EINTR(read(fd_, buf_ + bytes_read_, sizeof(buf_) - bytes_read_));
+        HANDLE_EINTR(read(fd_, buffer_.data() + bytes_read, bytes_to_read));
+    buffer_.resize(bytes_read + std::max<ssize_t>(rv, 0));
     if (rv < 0) {
       if (errno != EAGAIN && errno != EWOULDBLOCK) {
         PLOG(ERROR) << "read() failed";
@@ -721,27 +747,35 @@ void ProcessSingleton::LinuxWatcher::SocketReader::
     } else if (!rv) {
       // No more data to read.  It's time to process the message.
       break;
-    } else {
-      bytes_read_ += rv;
     }
-  }
 
-  // Validate the message.  The shortest message is kStartToken\0x\0x
-  constexpr size_t kMinMessageLength = kStartToken.size() + 4;
-  if (bytes_read_ < kMinMessageLength) {
-    buf_[bytes_read_] = 0;
-    LOG(ERROR) << "Invalid socket message (wrong length):" << buf_;
-    CleanupAndDeleteSelf();
-    return;
+    if (format_ == Format::kUnknown &&
+        buffer_.size() >= internal::kProcessSingletonHeaderSize) {
+      if (!internal::IsBinaryProcessSingletonMessage(buffer_)) {
+        format_ = Format::kText;
+        continue;
+      }
+      std::optional<size_t> message_size =
+          internal::GetBinaryProcessSingletonMessageSize(buffer_);
+      if (!message_size) {
+        LOG(ERROR) << "Invalid socket message header";
+        CleanupAndDeleteSelf();
+        return;
+      }
+      format_ = Format::kBinary;
+      message_size_ = *message_size;
+      buffer_.reserve(message_size_);
+    }
   }
 
-  std::string str(buf_, bytes_read_);
-  std::vector<std::string> tokens =
-      base::SplitString(str, std::string(1, kTokenDelimiter),
-                        base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
-
-  if (tokens.size() < 3 || tokens[0] != kStartToken) {
-    LOG(ERROR) << "Wrong message format: " << str;
+  // A message too short to hold a header can only be a text message.
+  std::optional<internal::ProcessSingletonMessage> message =
+      format_ == Format::kBinary
+          ? internal::DecodeBinaryProcessSingletonMessage(buffer_)
+          : internal::DecodeTextProcessSingletonMessage(
+                base::as_string_view(base::as_byte_span(buffer_)));
+  if (!message) {
+    LOG(ERROR) << "Invalid socket message of " << buffer_.size() << " bytes";
     CleanupAndDeleteSelf();
     return;
   }
@@ -750,22 +784,29 @@ void ProcessSingleton::LinuxWatcher::SocketReader::
   // terminated unexpectedly.
   timer_.Stop();
 
-  std::string current_dir = tokens[1];
-  // Remove the first two tokens.  The remaining tokens should be the command
-  // line argv array.
-  tokens.erase(tokens.begin());
-  tokens.erase(tokens.begin());
-
-  // Return to the UI thread to handle opening a new browser tab.
+  // Return to the UI thread to handle opening a new browser tab. |buffer_|
+  // outlives the task, this SocketReader is only deleted after it ran.
   ui_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&ProcessSingleton::LinuxWatcher::HandleMessage,
-                                parent_, current_dir, tokens, this));
+                                parent_, std::move(*message), this));
   fd_watch_controller_.reset();
 
   // LinuxWatcher::HandleMessage() is in charge of destroying this SocketReader
   // object by invoking SocketReader::FinishWithACK().
 }
 
+size_t ProcessSingleton::LinuxWatcher::SocketReader::GetBytesToRead() const {
+  switch (format_) {
+    case Format::kUnknown:
+      return internal::kProcessSingletonHeaderSize - buffer_.size();
+    case Format::kBinary:
+      return message_size_ - buffer_.size();
+    case Format::kText:
+      // Longer text messages are truncated, like they always were.
+      return internal::kMaxTextMessageLength - buffer_.size();
+  }
+}
+
 void ProcessSingleton::LinuxWatcher::SocketReader::FinishWithACK(
     std::string_view message) {
   if (!message.empty()) {
@@ -900,53 +941,64 @@ ProcessSingleton::NotifyResult ProcessSingleton::NotifyOtherProcessWithTimeout(
     return PROCESS_NOTIFIED;
   }
 #endif
-  timeval socket_timeout = TimeDeltaToTimeVal(timeout);
-  setsockopt(socket.fd(), SOL_SOCKET, SO_SNDTIMEO, &socket_timeout,
-             sizeof(socket_timeout));
-
-  // Found another process, prepare our command line
-  // format is "START\0<current dir>\0<argv[0]>\0...\0<argv[n]>".
-  std::string to_send(kStartToken);
-  to_send.push_back(kTokenDelimiter);
-
   base::FilePath current_dir;
   if (!base::PathService::Get(base::DIR_CURRENT, &current_dir)) {
     return PROCESS_NONE;
   }
-  to_send.append(current_dir.value());
 
-  const std::vector<std::string>& argv = cmd_line.argv();
-  for (auto it = argv.begin(); it != argv.end(); ++it) {
-    to_send.push_back(kTokenDelimiter);
-    to_send.append(*it);
-  }
+  // Found another process, send it our current directory and command line.
+  // Browsers that predate the binary format close the connection when they
+  // get a binary message, possibly before all of it was written. Those are
+  // sent the text format on a new connection.
+  std::string to_send = internal::EncodeBinaryProcessSingletonMessage(
+      current_dir.value(), cmd_line.argv());
+  bool sent_text = false;
+  bool closed_by_peer = false;
+  bool written = false;
+  char buf[kMaxACKMessageLength + 1];
+  ssize_t len = 0;
+  while (true) {
+    timeval socket_timeout = TimeDeltaToTimeVal(timeout);
+    setsockopt(socket.fd(), SOL_SOCKET, SO_SNDTIMEO, &socket_timeout,
+               sizeof(socket_timeout));
+
+    // Send the message
+    written = WriteToSocket(socket.fd(), to_send);
+    if (written) {
+      if (shutdown(socket.fd(), SHUT_WR) < 0) {
+        PLOG(ERROR) << "shutdown() failed";
+      }
 
-  // Send the message
-  if (!WriteToSocket(socket.fd(), to_send)) {
-    // Try to kill the other process, because it might have been dead.
-    if (!kill_unresponsive || !KillProcessByLockPath(true)) {
-      return PROFILE_IN_USE;
+      // Read ACK message from the other process. It might be blocked for a
+      // certain timeout, to make sure the other process has enough time to
+      // return ACK.
+      len = ReadFromSocket(socket.fd(), buf, kMaxACKMessageLength, timeout);
+    }
+    if (sent_text || (written && len != 0) || !IsClosedByPeer(socket.fd())) {
+      break;
     }
-    internal::SendRemoteHungProcessTerminateReasonHistogram(
-        SOCKET_WRITE_FAILED);
-    return PROCESS_NONE;
-  }
 
-  if (shutdown(socket.fd(), SHUT_WR) < 0) {
-    PLOG(ERROR) << "shutdown() failed";
+    closed_by_peer = true;
+    socket.Reset();
+    if (!ConnectSocket(&socket, socket_path_, cookie_path_)) {
+      break;
+    }
+    to_send = internal::EncodeTextProcessSingletonMessage(current_dir.value(),
+                                                          cmd_line.argv());
+    sent_text = true;
   }
 
-  // Read ACK message from the other process. It might be blocked for a certain
-  // timeout, to make sure the other process has enough time to return ACK.
-  char buf[kMaxACKMessageLength + 1];
-  ssize_t len = ReadFromSocket(socket.fd(), buf, kMaxACKMessageLength, timeout);
-
-  // Failed to read ACK, the other process might have been frozen.
-  if (len <= 0) {
-    if (!kill_unresponsive || !KillProcessByLockPath(true)) {
+  if (!written || len <= 0) {
+    // A browser that closed the connection on the binary message is not hung,
+    // it predates that format. It may also reject the text message, which it
+    // limits to 32KB. Killing it would lose its windows.
+    if (closed_by_peer || !kill_unresponsive || !KillProcessByLockPath(true)) {
       return PROFILE_IN_USE;
     }
-    internal::SendRemoteHungProcessTerminateReasonHistogram(SOCKET_READ_FAILED);
+    // Either writing failed, or the other process might have been frozen and
+    // did not send an ACK.
+    internal::SendRemoteHungProcessTerminateReasonHistogram(
+        written ? SOCKET_READ_FAILED : SOCKET_WRITE_FAILED);
     return PROCESS_NONE;
   }
 
@@ -7,8 +7,11 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/location.h"
+#include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/no_destructor.h"
 #include "base/task/thread_pool.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
 #include "components/keyed_service/core/dependency_manager.h"
@@ -16,7 +19,6 @@
 #include "components/keyed_service/core/simple_factory_key.h"
 #include "components/keyed_service/core/simple_key_map.h"
 #include "components/prefs/in_memory_pref_store.h"
-#include "components/prefs/json_pref_store.h"
 #include "components/prefs/pref_service_factory.h"
 #include "components/profile_metrics/browser_profile_type.h"
 #include "components/sync_preferences/pref_service_syncable.h"
@@ -25,6 +27,8 @@
 #include "content/browser/webui/web_ui_data_source_impl.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_ui.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/prefs/binary_pref_store.h"
 #include "radium/browser/prefs/profile_prefs.h"
 #include "radium/browser/profiles/profiles_state.h"
 #include "radium/browser/profiles/radium_browser_main_extra_parts_profiles.h"
@@ -70,8 +74,9 @@ void Profile::CreateProfilePrefService(base::PassKey<RadiumBrowserMainParts>,
           {base::TaskShutdownBehavior::BLOCK_SHUTDOWN, base::MayBlock()});
 
   PrefServiceFactory pref_service_factory;
-  pref_service_factory.set_user_prefs(base::MakeRefCounted<JsonPrefStore>(
-      path.Append(FILE_PATH_LITERAL("Preferences")), nullptr, io_task_runner));
+  pref_service_factory.set_user_prefs(CreatePersistentPrefStore(
+      path.Append(FILE_PATH_LITERAL("Preferences")), io_task_runner,
+      /*read_async=*/false));
 
   pref_service_factory.set_async(false);
   data->prefs_ = pref_service_factory.Create(pref_registry);
@@ -131,6 +136,23 @@ Profile::Profile(const base::FilePath& path,
 
   profile_metrics::SetBrowserProfileType(
       this, profile_metrics::BrowserProfileType::kRegular);
+  Init(create_mode);
+}
+
+Profile::Profile(Profile* original_profile, const std::string& otr_profile_id)
+    : is_off_the_record_(true),
+      path_(original_profile->GetPath()),
+      io_task_runner_(original_profile->GetIOTaskRunner()),
+      delegate_(nullptr),
+      original_profile_(original_profile),
+      otr_profile_id_(otr_profile_id) {
+  profile_metrics::SetBrowserProfileType(
+      this, profile_metrics::BrowserProfileType::kOtherOffTheRecordProfile);
+  // The preferences are in memory, there is nothing to wait for.
+  Init(CreateMode::kSynchronous);
+}
+
+void Profile::Init(CreateMode create_mode) {
   if (delegate_) {
     delegate_->OnProfileCreationStarted(this, create_mode);
   }
@@ -139,16 +161,20 @@ Profile::Profile(const base::FilePath& path,
   bool async_prefs = create_mode == CreateMode::kAsynchronous;
 
 #if BUILDFLAG(IS_ANDROID)
-  StartupData* startup_data = StartupData::Get();
-  DCHECK(startup_data && startup_data->key_);
-  TakePrefsFromStartupData();
-  async_prefs = false;
-#else
-  LoadPrefsForNormalStartup(async_prefs);
+  if (!is_off_the_record_) {
+    StartupData* startup_data = StartupData::Get();
+    DCHECK(startup_data && startup_data->key_);
+    TakePrefsFromStartupData();
+    async_prefs = false;
+  }
 #endif
+  if (!prefs_) {
+    LoadPrefsForNormalStartup(async_prefs);
+  }
 
   // Register on BrowserContext.
   user_prefs::UserPrefs::Set(this, prefs_.get());
+  BrowserProcess::Get()->pref_commit_scheduler()->AddPrefService(prefs_.get());
 
   SimpleKeyMap::GetInstance()->Associate(this, key_.get());
 
@@ -172,6 +198,14 @@ Profile::Profile(const base::FilePath& path,
 }
 
 Profile::~Profile() {
+  // The off-the-record profiles may use the keyed services of this profile.
+  otr_profiles_.clear();
+
+  if (BrowserProcess::Get()) {
+    BrowserProcess::Get()->pref_commit_scheduler()->RemovePrefService(
+        prefs_.get());
+  }
+
   NotifyWillBeDestroyed();
 
   // The SimpleDependencyManager should always be passed after the
@@ -230,19 +264,49 @@ bool Profile::IsSystemProfile() const {
 }
 
 Profile* Profile::GetOriginalProfile() {
-  return this;
+  return original_profile_ ? original_profile_.get() : this;
 }
 
 const Profile* Profile::GetOriginalProfile() const {
-  return this;
+  return original_profile_ ? original_profile_.get() : this;
+}
+
+Profile* Profile::CreateOffTheRecordProfile(const std::string& otr_profile_id) {
+  TRACE_EVENT0("browser", "Profile::CreateOffTheRecordProfile");
+  CHECK(!is_off_the_record_);
+  CHECK(!otr_profiles_.contains(otr_profile_id));
+  auto otr_profile = base::WrapUnique(new Profile(this, otr_profile_id));
+  Profile* result = otr_profile.get();
+  otr_profiles_[otr_profile_id] = std::move(otr_profile);
+  return result;
+}
+
+Profile* Profile::GetOffTheRecordProfile(const std::string& otr_profile_id) {
+  auto it = otr_profiles_.find(otr_profile_id);
+  return it == otr_profiles_.end() ? nullptr : it->second.get();
+}
+
+std::vector<Profile*> Profile::GetAllOffTheRecordProfiles() {
+  std::vector<Profile*> otr_profiles;
+  otr_profiles.reserve(otr_profiles_.size());
+  for (const auto& [id, otr_profile] : otr_profiles_) {
+    otr_profiles.push_back(otr_profile.get());
+  }
+  return otr_profiles;
+}
+
+void Profile::DestroyOffTheRecordProfile(Profile* otr_profile) {
+  TRACE_EVENT0("browser", "Profile::DestroyOffTheRecordProfile");
+  CHECK_EQ(otr_profile->GetOriginalProfile(), this);
+  otr_profiles_.erase(otr_profile->otr_profile_id());
 }
 
 bool Profile::ShouldRestoreOldSessionCookies() const {
-  return true;
+  return !is_off_the_record_;
 }
 
 bool Profile::ShouldPersistSessionCookies() const {
-  return true;
+  return !is_off_the_record_;
 }
 
 scoped_refptr<base::SequencedTaskRunner> Profile::GetIOTaskRunner() {
@@ -334,7 +398,7 @@ void Profile::TakePrefsFromStartupData() {
 
 void Profile::LoadPrefsForNormalStartup(bool async_prefs) {
   const base::FilePath& path = GetPath();
-  key_ = std::make_unique<SimpleFactoryKey>(path, false);
+  key_ = std::make_unique<SimpleFactoryKey>(path, is_off_the_record_);
 
   auto pref_registry = base::MakeRefCounted<user_prefs::PrefRegistrySyncable>();
   prefs::RegisterProfilePrefs(pref_registry.get(), "");
@@ -344,9 +408,9 @@ void Profile::LoadPrefsForNormalStartup(bool async_prefs) {
     pref_service_factory.set_user_prefs(
         base::MakeRefCounted<InMemoryPrefStore>());
   } else {
-    pref_service_factory.set_user_prefs(base::MakeRefCounted<JsonPrefStore>(
-        path_.Append(FILE_PATH_LITERAL("Preferences")), nullptr,
-        io_task_runner_));
+    pref_service_factory.set_user_prefs(CreatePersistentPrefStore(
+        path_.Append(FILE_PATH_LITERAL("Preferences")), io_task_runner_,
+        async_prefs));
   }
 
   pref_service_factory.set_async(async_prefs);
@@ -362,6 +426,19 @@ void Profile::OnPrefsLoaded(CreateMode create_mode, bool success) {
     return;
   }
 
+  // Build the services that are created together with the profile now that
+  // their prefs are available, so that they are ready before the first window
+  // asks for them. They are built in dependency order on the UI thread.
+  {
+    TRACE_EVENT0("browser", "Profile::CreateBrowserContextServices");
+    const base::TimeTicks start_time = base::TimeTicks::Now();
+    BrowserContextDependencyManager::GetInstance()
+        ->CreateBrowserContextServices(this);
+    services_creation_time_ = base::TimeTicks::Now() - start_time;
+    base::UmaHistogramTimes("Radium.Profile.CreateServicesTime",
+                            services_creation_time_);
+  }
+
   if (delegate_) {
     delegate_->OnProfileCreationFinished(this, create_mode, success, true);
   }
@@ -5,7 +5,13 @@
 #ifndef RADIUM_BROWSER_PROFILES_PROFILE_H_
 #define RADIUM_BROWSER_PROFILES_PROFILE_H_
 
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "base/files/file_path.h"
+#include "base/time/time.h"
 #include "base/types/pass_key.h"
 #include "content/public/browser/browser_context.h"
 
@@ -108,11 +114,35 @@ class Profile : public content::BrowserContext {
   // profile is not OffTheRecord.
   const Profile* GetOriginalProfile() const;
 
+  // Creates an off-the-record profile of this profile, identified by
+  // |otr_profile_id| among its off-the-record profiles. It keeps all of its
+  // state in memory and is destroyed by DestroyOffTheRecordProfile(), or
+  // together with this profile at the latest.
+  Profile* CreateOffTheRecordProfile(const std::string& otr_profile_id);
+
+  // Returns the off-the-record profile of this profile with |otr_profile_id|,
+  // or null.
+  Profile* GetOffTheRecordProfile(const std::string& otr_profile_id);
+
+  std::vector<Profile*> GetAllOffTheRecordProfiles();
+
+  void DestroyOffTheRecordProfile(Profile* otr_profile);
+
+  // Returns the id of an off-the-record profile among the off-the-record
+  // profiles of its original profile. Empty for other profiles.
+  const std::string& otr_profile_id() const { return otr_profile_id_; }
+
   bool ShouldRestoreOldSessionCookies() const;
   bool ShouldPersistSessionCookies() const;
 
   scoped_refptr<base::SequencedTaskRunner> GetIOTaskRunner();
 
+  // Returns how long it took to build the keyed services that are created
+  // together with the profile.
+  base::TimeDelta services_creation_time() const {
+    return services_creation_time_;
+  }
+
   // content::BrowserContext:
   std::unique_ptr<content::ZoomLevelDelegate> CreateZoomLevelDelegate(
       const base::FilePath& partition_path) override;
@@ -143,6 +173,13 @@ class Profile : public content::BrowserContext {
                    CreateMode create_mode,
                    scoped_refptr<base::SequencedTaskRunner> io_task_runner);
 
+  // Creates an off-the-record profile of |original_profile|.
+  Profile(Profile* original_profile, const std::string& otr_profile_id);
+
+  // Loads the preferences and builds the keyed services, synchronously or
+  // not depending on |create_mode|.
+  void Init(CreateMode create_mode);
+
 #if BUILDFLAG(IS_ANDROID)
   // Takes the ownership of the pre-created PrefService and other objects if
   // they have been created.
@@ -169,6 +206,16 @@ class Profile : public content::BrowserContext {
   std::unique_ptr<SimpleFactoryKey> key_;
 
   raw_ptr<Profile::Delegate> delegate_;
+
+  // Set for off-the-record profiles, which are owned by their original
+  // profile.
+  const raw_ptr<Profile> original_profile_ = nullptr;
+  const std::string otr_profile_id_;
+
+  // The off-the-record profiles of this profile, by id.
+  std::map<std::string, std::unique_ptr<Profile>> otr_profiles_;
+
+  base::TimeDelta services_creation_time_;
 };
 
 #endif  // RADIUM_BROWSER_PROFILES_PROFILE_H_
@@ -0,0 +1,21 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_PROFILES_PROFILE_KEEP_ALIVE_TYPES_H_
+#define RADIUM_BROWSER_PROFILES_PROFILE_KEEP_ALIVE_TYPES_H_
+
+// The reasons a Profile is kept loaded. Once a Profile had at least one
+// keep-alive and all of them are gone, the ProfileManager unloads it.
+enum class ProfileKeepAliveOrigin {
+  // A Browser of the profile is in the BrowserList.
+  kBrowserWindow = 0,
+
+  // An off-the-record profile of the profile is used as a DevTools browser
+  // context.
+  kDevToolsBrowserContext = 1,
+
+  kMaxValue = kDevToolsBrowserContext,
+};
+
+#endif  // RADIUM_BROWSER_PROFILES_PROFILE_KEEP_ALIVE_TYPES_H_
@@ -5,17 +5,24 @@
 #include "radium/browser/profiles/profile_manager.h"
 
 #include "absl/cleanup/cleanup.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/path_service.h"
+#include "base/process/process_metrics.h"
 #include "base/trace_event/trace_event.h"
 #include "chrome/browser/profiles/profiles_state.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
 #include "radium/browser/browser_process.h"
 #include "radium/browser/global_features.h"
 #include "radium/browser/profiles/profile.h"
 #include "radium/common/pref_names.h"
 #include "radium/common/radium_constants.h"
+#include "radium/common/radium_features.h"
 #include "radium/common/radium_paths.h"
 
 namespace {
@@ -26,6 +33,28 @@ void RunCallbacks(std::vector<base::OnceCallback<void(Profile*)>>& callbacks,
   }
 }
 
+// Returns true while a renderer that has hosted content of |profile| is still
+// alive. The BrowserContext must outlive those.
+bool HasLiveRenderProcessHosts(const Profile* profile) {
+  for (content::RenderProcessHost::iterator it =
+           content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (host->GetBrowserContext() == profile && !host->HostHasNotBeenUsed()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// How many times UnloadProfile() waits for the renderers of a profile before
+// leaving it loaded for the rest of the session.
+constexpr int kMaxUnloadAttempts = 10;
+
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
 }  // namespace
 
 ProfileManager::ProfileInfo::ProfileInfo() = default;
@@ -163,8 +192,10 @@ Profile* ProfileManager::GetProfileByPath(const base::FilePath& path) const {
 
 void ProfileManager::SetProfileAsLastUsed(Profile* last_active) {
   // Only keep track of profiles that we are managing; tests may create others.
-  // Also never consider the SystemProfile as "active".
-  if (profiles_info_.find(last_active->GetPath()) != profiles_info_.end() &&
+  // Off-the-record profiles share the path of their original profile but are
+  // not managed here. Also never consider the SystemProfile as "active".
+  if (!last_active->IsOffTheRecord() &&
+      profiles_info_.find(last_active->GetPath()) != profiles_info_.end() &&
       !last_active->IsSystemProfile()) {
     base::FilePath profile_path_base = last_active->GetBaseName();
     if (profile_path_base != GetLastUsedProfileBaseName()) {
@@ -217,6 +248,10 @@ void ProfileManager::OnProfileCreationFinished(Profile* profile,
     profiles_info_.erase(iter);
   }
 
+  if (success) {
+    RecordResidentProfileCount();
+  }
+
   // Invoke INITIALIZED for all profiles.
   // Profile might be null, meaning that the creation failed.
   RunCallbacks(init_callbacks, profile);
@@ -235,7 +270,11 @@ Profile* ProfileManager::CreateAndInitializeProfile(
   auto iter_result = profiles_info_.insert(
       {profile_ptr->GetPath(), std::make_unique<ProfileInfo>()});
   CHECK(iter_result.second);
-  iter_result.first->second->profile = std::move(profile);
+  ProfileInfo* info = iter_result.first->second.get();
+  info->profile = std::move(profile);
+  // Synchronous creation is done by the time the factory returns.
+  info->created_ = true;
+  RecordResidentProfileCount();
   return profile_ptr;
 }
 
@@ -247,3 +286,110 @@ bool ProfileManager::CanCreateProfileAtPath(const base::FilePath& path) const {
 
   return true;
 }
+
+void ProfileManager::AddKeepAlive(const Profile* profile,
+                                  ProfileKeepAliveOrigin origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Off-the-record profiles share the path of their original profile, which
+  // owns them and outlives them.
+  if (profile->GetOriginalProfile() != profile) {
+    return;
+  }
+  auto iter = profiles_info_.find(profile->GetPath());
+  if (iter == profiles_info_.end()) {
+    // Not a profile managed by the ProfileManager, e.g. in tests.
+    return;
+  }
+
+  ProfileInfo* info = iter->second.get();
+  ++info->keep_alives[origin];
+  info->had_keep_alive = true;
+  info->unload_attempts = 0;
+  info->unload_timer.Stop();
+}
+
+void ProfileManager::RemoveKeepAlive(const Profile* profile,
+                                     ProfileKeepAliveOrigin origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (profile->GetOriginalProfile() != profile) {
+    return;
+  }
+  auto iter = profiles_info_.find(profile->GetPath());
+  if (iter == profiles_info_.end()) {
+    return;
+  }
+
+  ProfileInfo* info = iter->second.get();
+  auto keep_alive = info->keep_alives.find(origin);
+  CHECK(keep_alive != info->keep_alives.end());
+  DCHECK_GT(keep_alive->second, 0);
+  if (--keep_alive->second == 0) {
+    info->keep_alives.erase(keep_alive);
+  }
+
+  if (info->keep_alives.empty()) {
+    ScheduleProfileUnload(info);
+  }
+}
+
+void ProfileManager::ScheduleProfileUnload(ProfileInfo* info) {
+  if (!base::FeatureList::IsEnabled(features::kUnloadProfiles) ||
+      !info->had_keep_alive || BrowserProcess::Get()->IsShuttingDown()) {
+    return;
+  }
+
+  // Unloading is not urgent. Let it yield to anything the user is waiting for.
+  info->unload_timer.Stop();
+  info->unload_timer.SetTaskRunner(
+      content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT}));
+  // Unretained is safe because the timer is owned by this object.
+  info->unload_timer.Start(
+      FROM_HERE, features::kUnloadProfilesGracePeriod.Get(),
+      base::BindOnce(&ProfileManager::UnloadProfile, base::Unretained(this),
+                     info->profile->GetPath()));
+}
+
+void ProfileManager::UnloadProfile(const base::FilePath& path) {
+  TRACE_EVENT0("browser", "ProfileManager::UnloadProfile");
+  auto iter = profiles_info_.find(path);
+  if (iter == profiles_info_.end()) {
+    return;
+  }
+
+  ProfileInfo* info = iter->second.get();
+  if (!info->created_ || !info->keep_alives.empty()) {
+    return;
+  }
+
+  if (HasLiveRenderProcessHosts(info->profile.get())) {
+    // Closed tabs may still be running unload handlers. Check again later,
+    // unless a renderer outlived all the previous attempts.
+    if (++info->unload_attempts < kMaxUnloadAttempts) {
+      ScheduleProfileUnload(info);
+    } else {
+      LOG(WARNING) << "Keeping profile " << path << " loaded: its renderers "
+                   << "did not exit";
+    }
+    return;
+  }
+
+  const size_t malloc_usage_before = GetMallocUsage();
+
+  // This also destroys the timer that is running this task, which is fine.
+  std::unique_ptr<ProfileInfo> unloaded_info = std::move(iter->second);
+  profiles_info_.erase(iter);
+  unloaded_info.reset();
+
+  const size_t malloc_usage_after = GetMallocUsage();
+  if (malloc_usage_before > malloc_usage_after) {
+    base::UmaHistogramMemoryKB(
+        "Radium.Profile.Unload.ReclaimedMemory",
+        (malloc_usage_before - malloc_usage_after) / 1024);
+  }
+  RecordResidentProfileCount();
+}
+
+void ProfileManager::RecordResidentProfileCount() const {
+  base::UmaHistogramCounts100("Radium.Profile.ResidentCount",
+                              profiles_info_.size());
+}
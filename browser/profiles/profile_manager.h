@@ -10,7 +10,11 @@
 
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
+#include "base/timer/timer.h"
 #include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_keep_alive_types.h"
+
+class ScopedProfileKeepAlive;
 
 class ProfileManager : public Profile::Delegate {
  public:
@@ -97,6 +101,8 @@ class ProfileManager : public Profile::Delegate {
   std::unique_ptr<Profile> CreateProfileAsyncHelper(const base::FilePath& path);
 
  private:
+  friend class ScopedProfileKeepAlive;
+
   // This class contains information about profiles which are being loaded or
   // were loaded.
   struct ProfileInfo {
@@ -115,6 +121,19 @@ class ProfileManager : public Profile::Delegate {
     std::vector<ProfileLoadedCallback> created_callbacks;
 
     bool created_ = false;
+
+    // Number of ScopedProfileKeepAlive per origin. Origins without keep-alive
+    // are not in the map.
+    std::map<ProfileKeepAliveOrigin, int> keep_alives;
+    // Only profiles that were kept alive once are unloaded when they lose
+    // their last keep-alive.
+    bool had_keep_alive = false;
+    // Runs UnloadProfile() once the grace period after the last keep-alive
+    // went away has elapsed.
+    base::OneShotTimer unload_timer;
+    // Number of times UnloadProfile() found a live renderer since the last
+    // keep-alive went away.
+    int unload_attempts = 0;
   };
 
   explicit ProfileManager(const base::FilePath& user_data_dir);
@@ -137,6 +156,23 @@ class ProfileManager : public Profile::Delegate {
   // Whether a new profile can be created at |path|.
   bool CanCreateProfileAtPath(const base::FilePath& path) const;
 
+  // Called by ScopedProfileKeepAlive. Off-the-record profiles are not kept
+  // alive on their own: they live as long as their original profile lets them.
+  void AddKeepAlive(const Profile* profile, ProfileKeepAliveOrigin origin);
+  void RemoveKeepAlive(const Profile* profile, ProfileKeepAliveOrigin origin);
+
+  // Starts the grace period after which the profile of |info| is unloaded,
+  // unless it is kept alive again in the meantime.
+  void ScheduleProfileUnload(ProfileInfo* info);
+
+  // Destroys the profile at |path| if nothing keeps it alive anymore. The
+  // keyed services are torn down by the Profile's destructor. A profile whose
+  // renderers are still alive is checked again after another grace period, a
+  // bounded number of times.
+  void UnloadProfile(const base::FilePath& path);
+
+  void RecordResidentProfileCount() const;
+
   // The path to the user data directory (DIR_USER_DATA).
   const base::FilePath user_data_dir_;
 
@@ -0,0 +1,125 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/profiles/profile_manager.h"
+
+#include <memory>
+
+#include "base/containers/contains.h"
+#include "base/files/file_path.h"
+#include "base/run_loop.h"
+#include "base/test/run_until.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/test/test_future.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/scoped_profile_keep_alive.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_window.h"
+#include "radium/browser/ui/gallery/gallery_window_factory.h"
+#include "radium/browser/ui/ui_features.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager_factory.h"
+#include "radium/common/radium_features.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+class ProfileManagerBrowserTest : public RadiumBrowserTest {
+ public:
+  ProfileManagerBrowserTest() {
+    feature_list_.InitWithFeaturesAndParameters(
+        {{features::kUnloadProfiles, {{"grace_period", "0s"}}},
+         {features::kPreloadTopChromeWebUI,
+          {{features::kPreloadTopChromeWebUIModeName,
+            features::kPreloadTopChromeWebUIModePreloadOnWarmupName}}}},
+        {});
+  }
+
+ protected:
+  ProfileManager* profile_manager() {
+    return BrowserProcess::Get()->GetFeatures()->profile_manager();
+  }
+
+  base::FilePath GetProfilePath(const char* base_name) {
+    return profile_manager()->user_data_dir().AppendASCII(base_name);
+  }
+
+  Profile* CreateProfile(const base::FilePath& path) {
+    base::test::TestFuture<Profile*> profile;
+    profile_manager()->CreateProfileAsync(path, profile.GetCallback());
+    return profile.Get();
+  }
+
+  bool WaitForUnload(const base::FilePath& path) {
+    return base::test::RunUntil(
+        [&] { return !profile_manager()->GetProfileByPath(path); });
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(ProfileManagerBrowserTest, LoadsProfileSynchronously) {
+  const base::FilePath path = GetProfilePath("Sync");
+  Profile* profile = profile_manager()->GetProfile(path, /*create=*/true);
+  ASSERT_TRUE(profile);
+  EXPECT_TRUE(
+      base::Contains(profile_manager()->GetLoadedProfiles(), profile));
+
+  // Later asynchronous requests get the loaded profile right away.
+  EXPECT_EQ(profile, CreateProfile(path));
+}
+
+IN_PROC_BROWSER_TEST_F(ProfileManagerBrowserTest,
+                       UnloadsProfileAfterLastKeepAlive) {
+  const base::FilePath path = GetProfilePath("KeepAlive");
+  Profile* profile = CreateProfile(path);
+  ASSERT_TRUE(profile);
+
+  auto keep_alive = std::make_unique<ScopedProfileKeepAlive>(
+      profile, ProfileKeepAliveOrigin::kBrowserWindow);
+  auto devtools_keep_alive = std::make_unique<ScopedProfileKeepAlive>(
+      profile, ProfileKeepAliveOrigin::kDevToolsBrowserContext);
+  keep_alive.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(profile, profile_manager()->GetProfileByPath(path));
+
+  devtools_keep_alive.reset();
+  EXPECT_TRUE(WaitForUnload(path));
+}
+
+// Profiles that were never kept alive, like the one loaded at startup before
+// its window opens, stay loaded.
+IN_PROC_BROWSER_TEST_F(ProfileManagerBrowserTest, KeepsProfileNeverKeptAlive) {
+  const base::FilePath path = GetProfilePath("NeverKeptAlive");
+  Profile* profile = CreateProfile(path);
+  ASSERT_TRUE(profile);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(profile, profile_manager()->GetProfileByPath(path));
+}
+
+// The preloaded WebUIs of the window's profile must not keep it loaded.
+IN_PROC_BROWSER_TEST_F(ProfileManagerBrowserTest,
+                       UnloadsProfileAfterLastWindowCloses) {
+  const base::FilePath path = GetProfilePath("Window");
+  Profile* profile = CreateProfile(path);
+  ASSERT_TRUE(profile);
+
+  Browser* browser = CreateGalleryBrowser(profile);
+  ASSERT_TRUE(browser);
+  WebUIContentsPreloadManager* preload_manager =
+      WebUIContentsPreloadManagerFactory::GetForProfile(profile);
+  const GURL gallery_url(radium::kRadiumUIWebuiGalleryURL);
+  ASSERT_TRUE(base::test::RunUntil([&] {
+    return preload_manager->GetPreloadedWebContentsForTesting(gallery_url) !=
+           nullptr;
+  }));
+
+  browser->window()->Close();
+  EXPECT_TRUE(WaitForUnload(path));
+}
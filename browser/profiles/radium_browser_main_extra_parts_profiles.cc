@@ -7,6 +7,8 @@
 #include "radium/browser/content_settings/cookie_settings_factory.h"
 #include "radium/browser/content_settings/host_content_settings_map_factory.h"
 #include "radium/browser/net/profile_network_context_service_factory.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager_factory.h"
+#include "radium/browser/ui/webui/webui_data_source_registry_factory.h"
 
 #if !BUILDFLAG(IS_ANDROID)
 #include "radium/browser/badging/badge_manager_factory.h"
@@ -29,6 +31,8 @@ void RadiumBrowserMainExtraPartsProfiles::
 #if !BUILDFLAG(IS_ANDROID)
   ThemeServiceFactory::GetInstance();
 #endif
+  WebUIContentsPreloadManagerFactory::GetInstance();
+  WebUIDataSourceRegistryFactory::GetInstance();
 }
 
 void RadiumBrowserMainExtraPartsProfiles::PreProfileInit() {
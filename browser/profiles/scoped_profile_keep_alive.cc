@@ -0,0 +1,37 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/profiles/scoped_profile_keep_alive.h"
+
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/profiles/profile_manager.h"
+
+namespace {
+
+ProfileManager* GetProfileManager() {
+  BrowserProcess* browser_process = BrowserProcess::Get();
+  if (!browser_process || !browser_process->GetFeatures()) {
+    return nullptr;
+  }
+  return browser_process->GetFeatures()->profile_manager();
+}
+
+}  // namespace
+
+ScopedProfileKeepAlive::ScopedProfileKeepAlive(const Profile* profile,
+                                               ProfileKeepAliveOrigin origin)
+    : profile_(profile), origin_(origin) {
+  if (ProfileManager* profile_manager = GetProfileManager()) {
+    profile_manager->AddKeepAlive(profile_, origin_);
+  }
+}
+
+ScopedProfileKeepAlive::~ScopedProfileKeepAlive() {
+  // The ProfileManager is gone during teardown, and so is every profile it
+  // could unload.
+  if (ProfileManager* profile_manager = GetProfileManager()) {
+    profile_manager->RemoveKeepAlive(profile_, origin_);
+  }
+}
@@ -0,0 +1,31 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_PROFILES_SCOPED_PROFILE_KEEP_ALIVE_H_
+#define RADIUM_BROWSER_PROFILES_SCOPED_PROFILE_KEEP_ALIVE_H_
+
+#include "base/memory/raw_ptr.h"
+#include "radium/browser/profiles/profile_keep_alive_types.h"
+
+class Profile;
+
+// Keeps |profile| loaded for as long as this object lives. See
+// ProfileKeepAliveOrigin.
+class ScopedProfileKeepAlive {
+ public:
+  ScopedProfileKeepAlive(const Profile* profile, ProfileKeepAliveOrigin origin);
+  ScopedProfileKeepAlive(const ScopedProfileKeepAlive&) = delete;
+  ScopedProfileKeepAlive& operator=(const ScopedProfileKeepAlive&) = delete;
+
+  ~ScopedProfileKeepAlive();
+
+  const Profile* profile() const { return profile_; }
+  ProfileKeepAliveOrigin origin() const { return origin_; }
+
+ private:
+  const raw_ptr<const Profile> profile_;
+  const ProfileKeepAliveOrigin origin_;
+};
+
+#endif  // RADIUM_BROWSER_PROFILES_SCOPED_PROFILE_KEEP_ALIVE_H_
@@ -7,6 +7,8 @@
 #include "content/public/browser/web_ui_browser_interface_broker_registry.h"
 #include "content/public/browser/web_ui_controller_interface_binder.h"
 #include "radium/browser/badging/badge_manager.h"
+#include "radium/browser/ui/webui/histograms/histograms.mojom.h"
+#include "radium/browser/ui/webui/histograms/histograms_ui.h"
 #include "third_party/blink/public/mojom/badging/badging.mojom.h"
 
 #if !BUILDFLAG(IS_ANDROID)
@@ -30,6 +32,9 @@ void PopulateRadiumWebUIFrameBinders(
 
 void PopulateRadiumWebUIFrameInterfaceBrokers(
     content::WebUIBrowserInterfaceBrokerRegistry& registry) {
+  registry.ForWebUI<HistogramsUI>()
+      .Add<histograms::mojom::PageHandlerFactory>();
+
 #if !BUILDFLAG(IS_ANDROID)
   registry.ForWebUI<WebuiGalleryUI>()
       .Add<color_change_listener::mojom::PageHandler>();
@@ -4,26 +4,36 @@
 
 #include "radium/browser/radium_browser_main_parts.h"
 
+#include <algorithm>
+
 #include "base/command_line.h"
 #include "base/debug/leak_annotations.h"
+#include "base/functional/bind.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/task/current_thread.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/threading/hang_watcher.h"
 #include "base/trace_event/trace_event.h"
 #include "components/color/color_mixers.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/network_service_instance.h"
 #include "radium/browser/browser_process.h"
 #include "radium/browser/buildflags.h"
 #include "radium/browser/global_features.h"
+#include "radium/browser/metrics/startup_milestones.h"
 #include "radium/browser/profiles/profile_manager.h"
 #include "radium/browser/profiles/profiles_state.h"
 #include "radium/browser/radium_browser_main_extra_parts.h"
 #include "radium/browser/ui/color/radium_color_mixers.h"
 #include "radium/browser/ui/startup/startup_browser_creator.h"
 #include "radium/browser/ui/webui/radium_web_ui_configs.h"
+#include "radium/common/profiler/thread_profiler.h"
 #include "radium/common/radium_paths.h"
 #include "radium/common/radium_result_codes.h"
 #include "ui/color/color_provider_manager.h"
@@ -41,6 +51,14 @@
 #include "ui/aura/env.h"
 #endif
 
+#if !BUILDFLAG(IS_ANDROID)
+#include "components/keep_alive_registry/keep_alive_types.h"
+#include "components/keep_alive_registry/scoped_keep_alive.h"
+#include "radium/browser/high_dpi_resource_pak_loader.h"
+#include "radium/browser/radium_resource_bundle_helper.h"
+#include "ui/display/screen.h"
+#endif
+
 #if BUILDFLAG(ENABLE_PROCESS_SINGLETON)
 #include "radium/browser/radium_process_singleton.h"
 
@@ -51,6 +69,7 @@
 
 namespace {
 
+#if BUILDFLAG(IS_ANDROID)
 StartupProfileInfo CreateInitialProfile(
     const base::FilePath& cur_dir,
     const base::CommandLine& parsed_command_line) {
@@ -66,11 +85,13 @@ StartupProfileInfo CreateInitialProfile(
   profile_info.mode = StartupProfileMode::kBrowserWindow;
   return profile_info;
 }
+#endif  // BUILDFLAG(IS_ANDROID)
 
 #if BUILDFLAG(ENABLE_PROCESS_SINGLETON)
 void ProcessSingletonNotificationCallbackImpl(
     base::CommandLine command_line,
-    const base::FilePath& current_directory) {
+    const base::FilePath& current_directory,
+    base::TimeTicks notification_time) {
   // Drop the request if the browser process is already shutting down.
   if (!BrowserProcess::Get() || BrowserProcess::Get()->IsShuttingDown()) {
     return;
@@ -83,23 +104,8 @@ void ProcessSingletonNotificationCallbackImpl(
   base::nix::ExtractXdgActivationTokenFromCmdLine(command_line);
 #endif
 
-  //   StartupProfilePathInfo startup_profile_path_info =
-  //       GetStartupProfilePath(current_directory, command_line,
-  //                             /*ignore_profile_picker=*/false);
-  //   DCHECK_NE(startup_profile_path_info.reason,
-  //   StartupProfileModeReason::kError); base::UmaHistogramEnumeration(
-  //       "ProfilePicker.StartupMode.NotificationCallback",
-  //       StartupProfileModeFromReason(startup_profile_path_info.reason));
-  //   base::UmaHistogramEnumeration(
-  //       "ProfilePicker.StartupReason.NotificationCallback",
-  //       startup_profile_path_info.reason);
-
-  //   StartupBrowserCreator::ProcessCommandLineAlreadyRunning(
-  //       command_line, current_directory, startup_profile_path_info);
-
-  LOG(ERROR) << "Another process wants to start command_line: "
-             << command_line.GetCommandLineString() << ", "
-             << "current_directory: " << current_directory;
+  StartupBrowserCreator::ProcessCommandLineAlreadyRunning(
+      command_line, current_directory, notification_time);
 }
 #endif  // BUILDFLAG(ENABLE_PROCESS_SINGLETON)
 
@@ -157,9 +163,13 @@ bool RadiumBrowserMainParts::ProcessSingletonNotificationCallback(
   // cross-apartment shell objects (via IVirtualDesktopManager). That is not
   // allowed within a SendMessage handler, which this function is a part of.
   // So, we post a task to asynchronously finish the command line processing.
+  // This also lets the other process be acknowledged, and exit, before any
+  // profile is loaded or window is created for it.
   return base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
-      FROM_HERE, base::BindOnce(&ProcessSingletonNotificationCallbackImpl,
-                                std::move(command_line), current_directory));
+      FROM_HERE,
+      base::BindOnce(&ProcessSingletonNotificationCallbackImpl,
+                     std::move(command_line), current_directory,
+                     base::TimeTicks::Now()));
 }
 #endif  // BUILDFLAG(ENABLE_PROCESS_SINGLETON)
 
@@ -262,6 +272,12 @@ int RadiumBrowserMainParts::PreCreateThreads() {
 }
 
 void RadiumBrowserMainParts::PostCreateThreads() {
+  main_thread_profiler_ = ThreadProfiler::CreateAndStartOnCurrentThread(
+      ThreadProfiler::Thread::kBrowserMain);
+  content::GetIOThreadTaskRunner({})->PostTask(
+      FROM_HERE, base::BindOnce(&ThreadProfiler::StartOnChildThread,
+                                ThreadProfiler::Thread::kBrowserIO));
+
 #if BUILDFLAG(ENABLE_PROCESS_SINGLETON)
   RadiumProcessSingleton::GetInstance()->StartWatching();
 #endif
@@ -354,6 +370,9 @@ void RadiumBrowserMainParts::PostMainMessageLoopRun() {
   RadiumProcessSingleton::GetInstance()->Cleanup();
 #endif
 
+  high_dpi_resource_pak_loader_.reset();
+  main_thread_profiler_.reset();
+
   browser_process_->PostDestroyThreads();
 
   browser_process_->StartTearDown();
@@ -395,6 +414,8 @@ void RadiumBrowserMainParts::PostBrowserStart() {
 }
 
 int RadiumBrowserMainParts::PreMainMessageLoopRunImpl() {
+  startup_milestones::Record("PreMainMessageLoopRun");
+
 #if BUILDFLAG(IS_WIN)
   // Windows parental controls calls can be slow, so we do an early init here
   // that calculates this value off of the UI thread.
@@ -410,41 +431,126 @@ int RadiumBrowserMainParts::PreMainMessageLoopRunImpl() {
   CHECK(aura::Env::GetInstance());
 #endif  // defined(USE_AURA)
 
+#if !BUILDFLAG(IS_ANDROID)
+  // Check the displays before the first window asks for images.
+  if (!IsHighDpiResourcePakLoaded()) {
+    high_dpi_resource_pak_loader_ = std::make_unique<HighDpiResourcePakLoader>(
+        display::Screen::GetScreen(),
+        base::BindOnce(&LoadHighDpiResourcePak));
+  }
+#endif  // !BUILDFLAG(IS_ANDROID)
+
   // Desktop construction occurs here, (required before profile creation).
   PreProfileInit();
 
+#if !BUILDFLAG(IS_ANDROID)
+  // Start loading the initial profile as early as possible. Its preferences
+  // are read on the profile's IO task runner while the UI thread finishes the
+  // rest of startup below, and the first window is opened from
+  // OnInitialProfileLoaded() once they have arrived.
+  StartInitialProfileLoad();
+  // The profile can fail to load synchronously, e.g. when its directory
+  // cannot be created. Don't run the main message loop then.
+  if (result_code_ != content::RESULT_CODE_NORMAL_EXIT) {
+    return result_code_;
+  }
+#endif  // !BUILDFLAG(IS_ANDROID)
+
   // Needs to be done before PostProfileInit, to allow connecting DevTools
   // before WebUI for the CrOS login that can be called inside PostProfileInit
   BrowserProcess::Get()->CreateDevToolsProtocolHandler();
 
+#if BUILDFLAG(IS_ANDROID)
   StartupProfileInfo profile_info = CreateInitialProfile(
       base::FilePath(), *base::CommandLine::ForCurrentProcess());
+  PostProfileInit(profile_info.profile, /*is_initial_profile=*/true);
+#endif  // BUILDFLAG(IS_ANDROID)
 
   RegisterRadiumWebUIConfigs();
 
+#if !BUILDFLAG(IS_ANDROID)
+  // Launch the network service now, so that starting its process overlaps
+  // with the initial profile's preferences being read.
+  content::GetNetworkService();
+
+  // The first window is only opened once the initial profile has loaded, so
+  // the RunLoop for MainMessageLoopRun() is always needed. Transfer ownership
+  // of the browser's lifetime to the BrowserProcess.
+  DCHECK(!GetMainRunLoopInstance());
+  GetMainRunLoopInstance() = std::make_unique<base::RunLoop>();
+  browser_process_->SetQuitClosure(
+      GetMainRunLoopInstance()->QuitWhenIdleClosure());
+  ui_ready_time_ = base::TimeTicks::Now();
+  startup_milestones::Record("UIReady");
+#else
   PreBrowserStart();
+  Shell::Initialize(std::make_unique<ShellPlatformDelegate>());
+  PostBrowserStart();
+#endif  // !BUILDFLAG(IS_ANDROID)
+
+  return result_code_;
+}
 
 #if !BUILDFLAG(IS_ANDROID)
-  // We are in regular browser boot sequence. Open initial tabs and enter the
-  // main message loop.
-  std::vector<Profile*> last_opened_profiles;
+void RadiumBrowserMainParts::StartInitialProfileLoad() {
+  ProfileManager* profile_manager =
+      BrowserProcess::Get()->GetFeatures()->profile_manager();
+
+  // Nothing else keeps the browser alive until the first window is shown.
+  initial_profile_keep_alive_ = std::make_unique<ScopedKeepAlive>(
+      KeepAliveOrigin::BROWSER, KeepAliveRestartOption::DISABLED);
+  initial_profile_load_start_time_ = base::TimeTicks::Now();
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
+      "startup", "RadiumBrowserMainParts::LoadInitialProfile", this);
+
+  profile_manager->CreateProfileAsync(
+      profiles::GetDefaultProfileDir(profile_manager->user_data_dir()),
+      base::BindOnce(&RadiumBrowserMainParts::OnInitialProfileLoaded,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
 
-  if (browser_creator_->Start(*base::CommandLine::ForCurrentProcess(),
-                              base::FilePath(), profile_info,
-                              last_opened_profiles)) {
-    // Create the RunLoop for MainMessageLoopRun() to use and transfer
-    // ownership of the browser's lifetime to the BrowserProcess.
-    DCHECK(!GetMainRunLoopInstance());
-    GetMainRunLoopInstance() = std::make_unique<base::RunLoop>();
-    browser_process_->SetQuitClosure(
-        GetMainRunLoopInstance()->QuitWhenIdleClosure());
+void RadiumBrowserMainParts::OnInitialProfileLoaded(Profile* profile) {
+  TRACE_EVENT_NESTABLE_ASYNC_END0(
+      "startup", "RadiumBrowserMainParts::LoadInitialProfile", this);
+  TRACE_EVENT0("startup", "RadiumBrowserMainParts::OnInitialProfileLoaded");
+
+  if (!profile) {
+    LOG(ERROR) << "Cannot load the initial profile.";
+    // Without a profile there is no browser to show. When this runs before
+    // the main message loop, PreMainMessageLoopRun() returns this code.
+    result_code_ = RADIUM_RESULT_CODE_MISSING_DATA;
+    // This may run synchronously from CreateProfileAsync(), before the main
+    // message loop is running, so quit the browser from a task.
+    base::SequencedTaskRunner::GetCurrentDefault()->DeleteSoon(
+        FROM_HERE, std::move(initial_profile_keep_alive_));
+    browser_creator_.reset();
+    return;
   }
+
+  startup_milestones::Record("InitialProfileLoaded");
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::UmaHistogramMediumTimes("Radium.Startup.InitialProfileLoadTime",
+                                now - initial_profile_load_start_time_);
+  // How long the UI thread had nothing to do but wait for the profile. Zero
+  // when the preferences were read before the rest of startup finished.
+  base::UmaHistogramMediumTimes(
+      "Radium.Startup.InitialProfileWaitTime",
+      std::max(now - ui_ready_time_, base::TimeDelta()));
+
+  PostProfileInit(profile, /*is_initial_profile=*/true);
+  PreBrowserStart();
+
+  // We are in regular browser boot sequence. Open initial tabs.
+  StartupProfileInfo profile_info{profile, StartupProfileMode::kBrowserWindow};
+  std::vector<Profile*> last_opened_profiles;
+  browser_creator_->Start(*base::CommandLine::ForCurrentProcess(),
+                          base::FilePath(), profile_info, last_opened_profiles);
   browser_creator_.reset();
-#else
-  Shell::Initialize(std::make_unique<ShellPlatformDelegate>());
-#endif  // !BUILDFLAG(IS_ANDROID)
 
   PostBrowserStart();
 
-  return result_code_;
+  // From here on the browser is kept alive by its windows. If none was opened
+  // this quits the browser.
+  initial_profile_keep_alive_.reset();
 }
+#endif  // !BUILDFLAG(IS_ANDROID)
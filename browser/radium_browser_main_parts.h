@@ -6,14 +6,19 @@
 #define RADIUM_BROWSER_RADIUM_BROWSER_MAIN_PARTS_H_
 
 #include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/browser_main_parts.h"
 #include "content/public/common/result_codes.h"
 #include "radium/browser/buildflags.h"
 
 class BrowserProcess;
+class HighDpiResourcePakLoader;
 class RadiumBrowserMainExtraParts;
 class RadiumFeatureListCreator;
+class ScopedKeepAlive;
 class StartupBrowserCreator;
+class ThreadProfiler;
 class Profile;
 
 namespace base {
@@ -94,6 +99,28 @@ class RadiumBrowserMainParts : public content::BrowserMainParts {
 #endif  // !BUILDFLAG(IS_ANDROID)
 
   base::FilePath user_data_dir_;
+
+ private:
+#if !BUILDFLAG(IS_ANDROID)
+  // Starts loading the initial profile asynchronously. The first window is
+  // opened from OnInitialProfileLoaded().
+  void StartInitialProfileLoad();
+  void OnInitialProfileLoaded(Profile* profile);
+
+  // Keeps the browser alive while the initial profile is loading.
+  std::unique_ptr<ScopedKeepAlive> initial_profile_keep_alive_;
+  base::TimeTicks initial_profile_load_start_time_;
+  // The time at which startup only waits for the initial profile.
+  base::TimeTicks ui_ready_time_;
+
+  // Set while the 2x resource pak waits for a high DPI display.
+  std::unique_ptr<HighDpiResourcePakLoader> high_dpi_resource_pak_loader_;
+#endif  // !BUILDFLAG(IS_ANDROID)
+
+  // Samples the UI thread while features::kThreadProfiler is enabled.
+  std::unique_ptr<ThreadProfiler> main_thread_profiler_;
+
+  base::WeakPtrFactory<RadiumBrowserMainParts> weak_ptr_factory_{this};
 };
 
 #endif  // RADIUM_BROWSER_RADIUM_BROWSER_MAIN_PARTS_H_
@@ -35,6 +35,7 @@
 #include "radium/browser/themes/theme_service_factory.h"
 #include "radium/browser/ui/tab_contents/radium_web_contents_view_delegate.h"
 #include "radium/browser/ui/views/radium_browser_main_extra_parts_views.h"
+#include "radium/browser/ui/webui/webui_process_model.h"
 #include "radium/common/channel_info.h"
 #include "radium/common/logging_radium.h"
 #include "radium/common/pref_names.h"
@@ -52,6 +53,7 @@
 #include "components/crash/core/app/crash_switches.h"
 #include "components/crash/core/app/crashpad.h"
 #include "radium/browser/radium_browser_main_parts_linux.h"
+#include "radium/browser/shared_resource_paks_linux.h"
 #include "radium/browser/ui/views/radium_browser_main_extra_parts_views_linux.h"
 #elif BUILDFLAG(IS_MAC)
 #include "radium/browser/radium_browser_main_extra_parts_mac.h"
@@ -441,6 +443,8 @@ void RadiumContentBrowserClient::GetAdditionalMappedFilesForChildProcess(
   base::FilePath app_data_path;
   base::PathService::Get(base::DIR_ANDROID_APP_DATA, &app_data_path);
   DCHECK(!app_data_path.empty());
+#elif BUILDFLAG(IS_LINUX)
+  ShareResourcePaksWithChildProcess(mappings);
 #endif  // BUILDFLAG(IS_ANDROID)
 
 #if BUILDFLAG(IS_ANDROID) || BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
@@ -594,6 +598,12 @@ bool RadiumContentBrowserClient::IsShuttingDown() {
   return BrowserProcess::Get()->IsShuttingDown();
 }
 
+bool RadiumContentBrowserClient::ShouldUseProcessPerSite(
+    content::BrowserContext* browser_context,
+    const GURL& site_url) {
+  return WebUIProcessModel::ShouldUseProcessPerSite(browser_context, site_url);
+}
+
 #if BUILDFLAG(IS_MAC)
 bool RadiumContentBrowserClient::SetupEmbedderSandboxParameters(
     sandbox::mojom::Sandbox sandbox_type,
@@ -86,6 +86,8 @@ class RadiumContentBrowserClient : public content::ContentBrowserClient {
   bool IsClipboardPasteAllowed(
       content::RenderFrameHost* render_frame_host) override;
   bool IsShuttingDown() override;
+  bool ShouldUseProcessPerSite(content::BrowserContext* browser_context,
+                               const GURL& site_url) override;
 #if BUILDFLAG(IS_MAC)
   bool SetupEmbedderSandboxParameters(
       sandbox::mojom::Sandbox sandbox_type,
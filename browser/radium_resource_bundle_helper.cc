@@ -4,12 +4,18 @@
 
 #include "radium/browser/radium_resource_bundle_helper.h"
 
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/path_service.h"
+#include "base/synchronization/lock.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/trace_event/trace_event.h"
 #include "components/language/core/browser/pref_names.h"
 #include "components/prefs/pref_service.h"
 #include "radium/browser/metrics/radium_feature_list_creator.h"
+#include "radium/common/radium_content_client.h"
+#include "radium/common/radium_features.h"
 #include "radium/common/radium_paths.h"
 #include "ui/base/resource/resource_bundle.h"
 
@@ -17,8 +23,30 @@
 #include "ui/base/resource/resource_bundle_android.h"
 #endif
 
+#if BUILDFLAG(IS_LINUX)
+#include "radium/browser/shared_resource_paks_linux.h"
+#endif
+
 namespace {
 
+// Whether LoadHighDpiResourcePak() was called. Only accessed on the UI thread.
+bool g_high_dpi_resource_pak_loaded = false;
+
+#if !BUILDFLAG(IS_ANDROID) && !BUILDFLAG(IS_LINUX)
+base::FilePath GetResourcesPakFilePath(const std::string& pak_name) {
+  base::FilePath path;
+  if (base::PathService::Get(base::DIR_ASSETS, &path)) {
+    return path.AppendASCII(pak_name.c_str());
+  }
+  // Return just the name of the pak file.
+#if BUILDFLAG(IS_WIN)
+  return base::FilePath(base::ASCIIToWide(pak_name));
+#else
+  return base::FilePath(pak_name.c_str());
+#endif  // BUILDFLAG(IS_WIN)
+}
+#endif  // !BUILDFLAG(IS_ANDROID) && !BUILDFLAG(IS_LINUX)
+
 // Initializes the shared instance of ResourceBundle and returns the application
 // locale. An empty |actual_locale| value indicates failure.
 std::string InitResourceBundleAndDetermineLocale(PrefService* local_state) {
@@ -40,6 +68,7 @@ std::string InitResourceBundleAndDetermineLocale(PrefService* local_state) {
 
   TRACE_EVENT0("startup",
                "RadiumBrowserMainParts::InitResourceBundleAndDetermineLocale");
+  const base::ElapsedTimer resource_bundle_timer;
   // On a POSIX OS other than ChromeOS, the parameter that is passed to the
   // method InitSharedInstance is ignored.
   std::string actual_locale = ui::ResourceBundle::InitSharedInstanceWithLocale(
@@ -65,19 +94,10 @@ std::string InitResourceBundleAndDetermineLocale(PrefService* local_state) {
     // Avoid loading DFM native resources here, to keep startup lean. These
     // resources are loaded on-use, when an already-installed DFM loads.
 #else
-    auto GetResourcesPakFilePath = [](const std::string& pak_name) {
-      base::FilePath path;
-      if (base::PathService::Get(base::DIR_ASSETS, &path)) {
-        return path.AppendASCII(pak_name.c_str());
-      }
-      // Return just the name of the pak file.
-#if BUILDFLAG(IS_WIN)
-      return base::FilePath(base::ASCIIToWide(pak_name));
+#if BUILDFLAG(IS_LINUX)
+    // The paks are opened once and shared with the child processes.
+    LoadSharedResourcePaks();
 #else
-      return base::FilePath(pak_name.c_str());
-#endif  // BUILDFLAG(IS_WIN)
-    };
-
     // Always load the 1x data pack first as the 2x data pack contains both 1x
     // and 2x images. The 1x data pack only has 1x images, thus passes in an
     // accurate scale factor to gfx::ImageSkia::AddRepresentation.
@@ -86,15 +106,19 @@ std::string InitResourceBundleAndDetermineLocale(PrefService* local_state) {
           GetResourcesPakFilePath("radium_100_percent.pak"), ui::k100Percent);
     }
 
-    if (ui::IsScaleFactorSupported(ui::k200Percent)) {
-      ui::ResourceBundle::GetSharedInstance().AddOptionalDataPackFromPath(
-          GetResourcesPakFilePath("radium_200_percent.pak"), ui::k200Percent);
-    }
-
     ui::ResourceBundle::GetSharedInstance().AddDataPackFromPath(
         resources_pack_path, ui::kScaleFactorNone);
+#endif  // BUILDFLAG(IS_LINUX)
+
+    // Otherwise HighDpiResourcePakLoader loads the 2x data pack once a high
+    // DPI display shows up.
+    if (!base::FeatureList::IsEnabled(features::kDeferHighDpiResourcePak)) {
+      LoadHighDpiResourcePak();
+    }
 #endif  // BUILDFLAG(IS_ANDROID)
   }
+  base::UmaHistogramMicrosecondsTimes("Radium.Startup.ResourceBundleInitTime",
+                                      resource_bundle_timer.Elapsed());
 
   return actual_locale;
 }
@@ -110,3 +134,29 @@ std::string LoadLocalState(
   return InitResourceBundleAndDetermineLocale(
       radium_feature_list_creator->local_state());
 }
+
+void LoadHighDpiResourcePak() {
+  if (g_high_dpi_resource_pak_loaded) {
+    return;
+  }
+  g_high_dpi_resource_pak_loaded = true;
+#if !BUILDFLAG(IS_ANDROID)
+  if (!ui::IsScaleFactorSupported(ui::k200Percent)) {
+    return;
+  }
+  TRACE_EVENT0("browser", "LoadHighDpiResourcePak");
+  // Other threads may be reading the bundle through RadiumContentClient by
+  // now. Readers on the UI thread don't race with this.
+  base::AutoLock lock(RadiumContentClient::GetResourceBundleLock());
+#if BUILDFLAG(IS_LINUX)
+  LoadSharedHighDpiResourcePak();
+#else
+  ui::ResourceBundle::GetSharedInstance().AddOptionalDataPackFromPath(
+      GetResourcesPakFilePath("radium_200_percent.pak"), ui::k200Percent);
+#endif  // BUILDFLAG(IS_LINUX)
+#endif  // !BUILDFLAG(IS_ANDROID)
+}
+
+bool IsHighDpiResourcePakLoaded() {
+  return g_high_dpi_resource_pak_loaded;
+}
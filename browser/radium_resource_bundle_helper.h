@@ -14,4 +14,16 @@ class RadiumFeatureListCreator;
 std::string LoadLocalState(
     RadiumFeatureListCreator* radium_feature_list_creator);
 
+// Adds radium_200_percent.pak to the shared ResourceBundle, unless it was
+// added already. With features::kDeferHighDpiResourcePak, this is left to
+// HighDpiResourcePakLoader instead of being done by LoadLocalState(). Must be
+// called on the UI thread. The pak is added under
+// RadiumContentClient::GetResourceBundleLock(), so code that reads the bundle
+// off the UI thread once startup is over must go through RadiumContentClient
+// or hold that lock.
+void LoadHighDpiResourcePak();
+
+// Returns true once LoadHighDpiResourcePak() has been called.
+bool IsHighDpiResourcePakLoaded();
+
 #endif  // RADIUM_BROWSER_RADIUM_RESOURCE_BUNDLE_HELPER_H_
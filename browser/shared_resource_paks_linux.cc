@@ -0,0 +1,114 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/shared_resource_paks_linux.h"
+
+#include <array>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/path_service.h"
+#include "base/synchronization/lock.h"
+#include "content/public/browser/posix_file_descriptor_info.h"
+#include "radium/common/radium_descriptors_linux.h"
+#include "radium/common/radium_paths.h"
+#include "ui/base/resource/resource_bundle.h"
+#include "ui/base/resource/resource_scale_factor.h"
+
+namespace {
+
+struct SharedPak {
+  int descriptor;
+  ui::ResourceScaleFactor scale_factor;
+  // Set once the pak has been opened.
+  base::File file;
+};
+
+// Guards the files of the paks, which are opened on the main thread and
+// shared from the process launcher thread.
+base::Lock& GetSharedPaksLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+std::array<SharedPak, 3>& GetSharedPaks() {
+  static base::NoDestructor<std::array<SharedPak, 3>> paks({{
+      {kRadium100PercentPakDescriptor, ui::k100Percent},
+      {kRadium200PercentPakDescriptor, ui::k200Percent},
+      {kRadiumResourcesPakDescriptor, ui::kScaleFactorNone},
+  }});
+  return *paks;
+}
+
+base::FilePath GetPakPath(int descriptor) {
+  base::FilePath path;
+  if (descriptor == kRadiumResourcesPakDescriptor) {
+    base::PathService::Get(radium::FILE_RESOURCES_PACK, &path);
+    return path;
+  }
+  const char* pak_name = descriptor == kRadium100PercentPakDescriptor
+                             ? "radium_100_percent.pak"
+                             : "radium_200_percent.pak";
+  if (base::PathService::Get(base::DIR_ASSETS, &path)) {
+    return path.AppendASCII(pak_name);
+  }
+  // Return just the name of the pak file.
+  return base::FilePath(pak_name);
+}
+
+void LoadSharedResourcePak(SharedPak& pak) {
+  if (pak.scale_factor != ui::kScaleFactorNone &&
+      !ui::IsScaleFactorSupported(pak.scale_factor)) {
+    return;
+  }
+  const base::FilePath path = GetPakPath(pak.descriptor);
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
+    // The 2x pack is optional.
+    LOG_IF(ERROR, pak.descriptor != kRadium200PercentPakDescriptor)
+        << "Failed to open data pack " << path;
+    return;
+  }
+  ui::ResourceBundle::GetSharedInstance().AddDataPackFromFileRegion(
+      file.Duplicate(), base::MemoryMappedFile::Region::kWholeFile,
+      pak.scale_factor);
+  base::AutoLock lock(GetSharedPaksLock());
+  pak.file = std::move(file);
+}
+
+}  // namespace
+
+void LoadSharedResourcePaks() {
+  // Always load the 1x data pack first as the 2x data pack contains both 1x
+  // and 2x images. The 1x data pack only has 1x images, thus passes in an
+  // accurate scale factor to gfx::ImageSkia::AddRepresentation.
+  for (SharedPak& pak : GetSharedPaks()) {
+    if (pak.descriptor != kRadium200PercentPakDescriptor) {
+      LoadSharedResourcePak(pak);
+    }
+  }
+}
+
+void LoadSharedHighDpiResourcePak() {
+  for (SharedPak& pak : GetSharedPaks()) {
+    if (pak.descriptor == kRadium200PercentPakDescriptor) {
+      LoadSharedResourcePak(pak);
+    }
+  }
+}
+
+void ShareResourcePaksWithChildProcess(
+    content::PosixFileDescriptorInfo* mappings) {
+  base::AutoLock lock(GetSharedPaksLock());
+  for (const SharedPak& pak : GetSharedPaks()) {
+    if (pak.file.IsValid()) {
+      mappings->ShareWithRegion(pak.descriptor, pak.file.GetPlatformFile(),
+                                base::MemoryMappedFile::Region::kWholeFile);
+    }
+  }
+}
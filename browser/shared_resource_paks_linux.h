@@ -0,0 +1,37 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_SHARED_RESOURCE_PAKS_LINUX_H_
+#define RADIUM_BROWSER_SHARED_RESOURCE_PAKS_LINUX_H_
+
+namespace content {
+class PosixFileDescriptorInfo;
+}
+
+// The browser opens radium_100_percent.pak, radium_200_percent.pak and
+// resources.pak once, and passes their descriptors to the child processes
+// that load the ResourceBundle. The children map them with
+// AddDataPackFromFileRegion() instead of resolving and opening the paths
+// again, which also keeps them on the files the browser started with if the
+// installation is updated underneath it.
+//
+// Children forked by the zygote inherit the zygote's mappings and don't use
+// the descriptors.
+
+// Opens radium_100_percent.pak and resources.pak and adds them to the shared
+// ResourceBundle. Must be called on the main thread before the first child
+// process is launched.
+void LoadSharedResourcePaks();
+
+// Opens radium_200_percent.pak and adds it to the shared ResourceBundle. It is
+// only shared with the child processes launched afterwards. Must be called on
+// the main thread, at most once.
+void LoadSharedHighDpiResourcePak();
+
+// Shares the paks opened by LoadSharedResourcePaks() with a child process.
+// Can be called on any thread.
+void ShareResourcePaksWithChildProcess(
+    content::PosixFileDescriptorInfo* mappings);
+
+#endif  // RADIUM_BROWSER_SHARED_RESOURCE_PAKS_LINUX_H_
@@ -39,6 +39,10 @@ class WebContentsCollection::ForwardingWebContentsObserver
     observer_->DidStartLoading(web_contents());
   }
 
+  void OnVisibilityChanged(content::Visibility visibility) override {
+    observer_->OnVisibilityChanged(web_contents(), visibility);
+  }
+
   // The observer that callbacks should forward to, annotating the
   // web contents they were fired in.
   raw_ptr<WebContentsCollection::Observer> observer_;
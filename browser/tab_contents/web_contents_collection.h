@@ -32,6 +32,8 @@ class WebContentsCollection {
         content::WebContents* web_contents,
         content::NavigationHandle* navigation_handle) {}
     virtual void DidStartLoading(content::WebContents* web_contents) {}
+    virtual void OnVisibilityChanged(content::WebContents* web_contents,
+                                     content::Visibility visibility) {}
 
    protected:
     virtual ~Observer() = default;
@@ -17,9 +17,13 @@
 #include "content/public/browser/web_contents_delegate.h"
 #include "content/public/browser/web_contents_user_data.h"
 #include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_keep_alive_types.h"
+#include "radium/browser/profiles/scoped_profile_keep_alive.h"
 #include "radium/browser/ui/browser_list.h"
 #include "radium/browser/ui/browser_observer.h"
 #include "radium/browser/ui/browser_window.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager_factory.h"
 
 namespace {
 
@@ -49,12 +53,21 @@ class TabImpl : public content::WebContentsUserData<TabImpl> {
 
 // static
 Browser* Browser::Create(CreateParams params) {
-  return new Browser(std::move(params));
+  Browser* browser = new Browser(std::move(params));
+  // Now that the profile has a window, warm up the WebUIs it is likely to
+  // open next.
+  WebUIContentsPreloadManagerFactory::GetForProfile(browser->profile())
+      ->Warmup();
+  return browser;
 }
 
 Browser::Browser(CreateParams params)
-    : profile_(params.profile), unload_controller_(this) {
+    : profile_(params.profile),
+      unload_controller_(this),
+      lifecycle_controller_(this) {
   window_ = params.new_window(base::WrapUnique(this));
+  profile_keep_alive_ = std::make_unique<ScopedProfileKeepAlive>(
+      profile_, ProfileKeepAliveOrigin::kBrowserWindow);
   // This is the last line of statement. It is expected that this is fully
   // constructed when the observer is used
   BrowserList::AddBrowser(this);
@@ -64,6 +77,15 @@ Browser::~Browser() {
   // This is the first statement. It is expected that this is still a complete
   // object when the observer uses it.
   BrowserList::RemoveBrowser(this);
+  // The profile may be unloaded once it has no browser left, which its
+  // preloaded WebUIs would prevent.
+  if (std::ranges::none_of(*BrowserList::GetInstance(), [this](Browser* b) {
+        return b->profile() == profile_;
+      })) {
+    WebUIContentsPreloadManagerFactory::GetForProfile(profile_)
+        ->ReleaseContents();
+  }
+  profile_keep_alive_.reset();
 }
 
 void Browser::RegisterKeepAlive() {
@@ -124,6 +146,32 @@ std::unique_ptr<content::WebContents> Browser::RemoveWebContents(
   return value;
 }
 
+std::unique_ptr<content::WebContents> Browser::ReplaceWebContents(
+    content::WebContents* old_contents,
+    std::unique_ptr<content::WebContents> new_contents) {
+  auto iter = std::ranges::find_if(tabs_, [old_contents](auto& contents) {
+    return old_contents == contents.get();
+  });
+
+  if (iter == tabs_.end()) {
+    return nullptr;
+  }
+
+  old_contents->SetDelegate(nullptr);
+  std::unique_ptr<content::WebContents> value = std::move(*iter);
+  tabs_.erase(iter);
+
+  new_contents->SetDelegate(this);
+  content::WebContents* new_contents_ptr = new_contents.get();
+  tabs_.insert(std::move(new_contents));
+
+  observers_.Notify(&BrowserObserver::OnWebContentsAdded, new_contents_ptr);
+  observers_.Notify(&BrowserObserver::OnWebContentsReplaced, value.get(),
+                    new_contents_ptr);
+  observers_.Notify(&BrowserObserver::OnWebContentsRemoved, value.get());
+  return value;
+}
+
 bool Browser::TryToCloseWindow(
     bool skip_beforeunload,
     const base::RepeatingCallback<void(bool)>& on_close_confirmed) {
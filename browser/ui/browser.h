@@ -12,10 +12,12 @@
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_delegate.h"
 #include "radium/browser/ui/unload_controller.h"
+#include "radium/browser/ui/web_contents_lifecycle_controller.h"
 
 class BrowserObserver;
 class BrowserWindow;
 class ScopedKeepAlive;
+class ScopedProfileKeepAlive;
 
 class Browser : public content::WebContentsDelegate,
                 public base::SupportsUserData {
@@ -69,6 +71,12 @@ class Browser : public content::WebContentsDelegate,
   std::unique_ptr<content::WebContents> RemoveWebContents(
       content::WebContents* web_contents);
 
+  // Swaps |old_contents| for |new_contents| and returns |old_contents|, or
+  // null if |old_contents| does not belong to this browser.
+  std::unique_ptr<content::WebContents> ReplaceWebContents(
+      content::WebContents* old_contents,
+      std::unique_ptr<content::WebContents> new_contents);
+
   // Begins the process of confirming whether the associated browser can be
   // closed. If there are no tabs with beforeunload handlers it will immediately
   // return false. If |skip_beforeunload| is true, all beforeunload
@@ -136,6 +144,9 @@ class Browser : public content::WebContentsDelegate,
 
   std::unique_ptr<ScopedKeepAlive> keep_alive_;
 
+  // Keeps |profile_| loaded while this browser is in the BrowserList.
+  std::unique_ptr<ScopedProfileKeepAlive> profile_keep_alive_;
+
   // Tells if the browser should skip warning the user when closing the window.
   bool force_skip_warning_user_on_close_ = false;
 
@@ -144,6 +155,10 @@ class Browser : public content::WebContentsDelegate,
   raw_ptr<BrowserWindow> window_ = nullptr;
 
   UnloadController unload_controller_;
+
+  // Freezes and discards the WebContents of this browser while they are in
+  // the background.
+  WebContentsLifecycleController lifecycle_controller_;
 };
 
 #endif  // RADIUM_BROWSER_UI_BROWSER_H_
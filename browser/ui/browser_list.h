@@ -38,6 +38,9 @@ class BrowserList {
   const_iterator begin() const { return browsers_.begin(); }
   const_iterator end() const { return browsers_.end(); }
 
+  const_reverse_iterator rbegin() const { return browsers_.rbegin(); }
+  const_reverse_iterator rend() const { return browsers_.rend(); }
+
   bool empty() const { return browsers_.empty(); }
   size_t size() const { return browsers_.size(); }
 
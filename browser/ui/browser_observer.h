@@ -18,6 +18,11 @@ class BrowserObserver : public base::CheckedObserver {
  public:
   virtual void OnWebContentsAdded(content::WebContents*) {}
   virtual void OnWebContentsRemoved(content::WebContents*) {}
+  // Called when |old_contents| is swapped for |new_contents|, e.g. because it
+  // was discarded. Sent between OnWebContentsAdded(new_contents) and
+  // OnWebContentsRemoved(old_contents).
+  virtual void OnWebContentsReplaced(content::WebContents* old_contents,
+                                     content::WebContents* new_contents) {}
   virtual void OnWebContentsEmpty() {}
 };
 
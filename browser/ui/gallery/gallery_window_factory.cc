@@ -13,24 +13,29 @@
 #include "components/keep_alive_registry/scoped_keep_alive.h"
 #include "radium/browser/browser_process.h"
 #include "radium/browser/global_features.h"
+#include "radium/browser/metrics/startup_milestones.h"
 #include "radium/browser/profiles/profile.h"
 #include "radium/browser/profiles/profile_manager.h"
 #include "radium/browser/ui/browser.h"
 #include "radium/browser/ui/views/gallery/gallery_view.h"
 
+base::FilePath GetGalleryProfilePath() {
+  return BrowserProcess::Get()
+      ->GetFeatures()
+      ->profile_manager()
+      ->user_data_dir()
+      .AppendASCII(base::MD5String("W"));
+}
+
 void ShowGalleryView() {
   ProfileManager* profile_manager =
       BrowserProcess::Get()->GetFeatures()->profile_manager();
-  base::FilePath path =
-      profile_manager->user_data_dir().AppendASCII(base::MD5String("W"));
+  base::FilePath path = GetGalleryProfilePath();
   Profile* profile = profile_manager->GetProfile(path);
   auto keep_alive = std::make_unique<ScopedKeepAlive>(
       KeepAliveOrigin::BROWSER, KeepAliveRestartOption::DISABLED);
   auto fn = [](std::unique_ptr<ScopedKeepAlive>, Profile* profile) {
-    Browser::CreateParams params;
-    params.profile = profile;
-    params.new_window = &GalleryView::Show;
-    Browser::Create(std::move(params))->window()->Show();
+    CreateGalleryBrowser(profile);
   };
 
   if (profile) {
@@ -41,3 +46,13 @@ void ShowGalleryView() {
   profile_manager->CreateProfileAsync(
       path, base::BindOnce(fn, std::move(keep_alive)));
 }
+
+Browser* CreateGalleryBrowser(Profile* profile) {
+  Browser::CreateParams params;
+  params.profile = profile;
+  params.new_window = &GalleryView::Show;
+  Browser* browser = Browser::Create(std::move(params));
+  browser->window()->Show();
+  startup_milestones::Record("FirstWindowShown");
+  return browser;
+}
@@ -5,6 +5,18 @@
 #ifndef RADIUM_BROWSER_UI_GALLERY_GALLERY_WINDOW_FACTORY_H_
 #define RADIUM_BROWSER_UI_GALLERY_GALLERY_WINDOW_FACTORY_H_
 
+#include "base/files/file_path.h"
+
+class Browser;
+class Profile;
+
+// Returns the path of the profile the gallery windows are shown for.
+base::FilePath GetGalleryProfilePath();
+
+// Shows a gallery window for the gallery profile, loading it if needed.
 void ShowGalleryView();
 
+// Creates and shows a gallery window for |profile|.
+Browser* CreateGalleryBrowser(Profile* profile);
+
 #endif  // RADIUM_BROWSER_UI_GALLERY_GALLERY_WINDOW_FACTORY_H_
@@ -18,6 +18,10 @@ class SigninWindow {
   ~SigninWindow();
 
   static void Show(Profile* profile, base::OnceClosure finish_callback);
+
+  // Closes the sign-in window, if one is shown, without running its
+  // |finish_callback|.
+  static void CloseForTesting();
 };
 
 #endif  // RADIUM_BROWSER_UI_SIGNIN_SIGNIN_WINDOW_H_
@@ -4,10 +4,169 @@
 
 #include "radium/browser/ui/startup/startup_browser_creator.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
+#include "components/keep_alive_registry/keep_alive_types.h"
+#include "components/keep_alive_registry/scoped_keep_alive.h"
+#include "components/startup_metric_utils/common/startup_metric_utils.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/web_contents.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/metrics/startup_milestones.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_list.h"
+#include "radium/browser/ui/browser_window.h"
 #include "radium/browser/ui/gallery/gallery_window_factory.h"
 #include "radium/browser/ui/signin/signin_window.h"
+#include "radium/common/radium_switches.h"
+#include "radium/common/webui_url_constants.h"
+#include "ui/base/page_transition_types.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace {
+
+bool g_skip_signin_for_testing = false;
+
+// Whether the user confirmed the sign-in window in this session.
+bool g_signed_in = false;
+
+// Relaunches that were received before the user confirmed the sign-in window.
+std::vector<base::OnceClosure>& GetPendingRelaunches() {
+  static base::NoDestructor<std::vector<base::OnceClosure>> pending_relaunches;
+  return *pending_relaunches;
+}
+
+void OnSignedIn() {
+  g_signed_in = true;
+  ShowGalleryView();
+  std::vector<base::OnceClosure> pending_relaunches =
+      std::move(GetPendingRelaunches());
+  for (base::OnceClosure& relaunch : pending_relaunches) {
+    std::move(relaunch).Run();
+  }
+}
+
+// Windows only host radium:// WebUIs, anything else on the command line is
+// dropped.
+std::vector<GURL> GetURLsFromCommandLine(const base::CommandLine& cmd_line) {
+  std::vector<GURL> urls;
+  for (const base::CommandLine::StringType& arg : cmd_line.GetArgs()) {
+    const std::string spec = base::FilePath(arg).AsUTF8Unsafe();
+    GURL url(spec);
+    if (!url.is_valid() || !url.SchemeIs(radium::kRadiumUIScheme)) {
+      LOG(WARNING) << "Ignoring unsupported URL " << spec;
+      continue;
+    }
+    urls.push_back(std::move(url));
+  }
+  return urls;
+}
+
+// Returns the most recently opened window of |profile|.
+Browser* FindBrowser(Profile* profile) {
+  const BrowserList* browser_list = BrowserList::GetInstance();
+  for (auto it = browser_list->rbegin(); it != browser_list->rend(); ++it) {
+    Browser* browser = *it;
+    if (browser->profile() == profile && browser->window()) {
+      return browser;
+    }
+  }
+  return nullptr;
+}
+
+// Returns the WebContents that shows |url|'s WebUI in the most recently
+// opened window of |profile| that has one, and sets |browser| to that window.
+content::WebContents* FindWebContents(Profile* profile,
+                                      const GURL& url,
+                                      Browser** browser) {
+  const BrowserList* browser_list = BrowserList::GetInstance();
+  for (auto it = browser_list->rbegin(); it != browser_list->rend(); ++it) {
+    if ((*it)->profile() != profile || !(*it)->window()) {
+      continue;
+    }
+    for (const auto& web_contents : (*it)->tabs()) {
+      if (url::IsSameOriginWith(web_contents->GetVisibleURL(), url)) {
+        *browser = *it;
+        return web_contents.get();
+      }
+    }
+  }
+  return nullptr;
+}
+
+void ShowURL(content::WebContents* web_contents, const GURL& url) {
+  if (web_contents->GetVisibleURL() != url) {
+    content::NavigationController::LoadURLParams params(url);
+    params.transition_type = ui::PAGE_TRANSITION_AUTO_TOPLEVEL;
+    web_contents->GetController().LoadURLWithParams(params);
+  }
+}
+
+void OpenURLsForProfile(std::unique_ptr<ScopedKeepAlive> keep_alive,
+                        const std::vector<GURL>& urls,
+                        base::TimeTicks notification_time,
+                        Profile* profile) {
+  TRACE_EVENT0("startup", "StartupBrowserCreator::OpenURLsForProfile");
+  if (!profile || BrowserProcess::Get()->IsShuttingDown()) {
+    return;
+  }
+
+  if (urls.empty()) {
+    Browser* browser = FindBrowser(profile);
+    if (browser) {
+      browser->window()->Show();
+    } else {
+      CreateGalleryBrowser(profile);
+    }
+  }
+
+  for (const GURL& url : urls) {
+    Browser* browser = nullptr;
+    content::WebContents* web_contents =
+        FindWebContents(profile, url, &browser);
+    if (!web_contents) {
+      // A new gallery window has a single WebContents.
+      browser = CreateGalleryBrowser(profile);
+      if (browser->tabs().empty()) {
+        continue;
+      }
+      web_contents = browser->tabs().begin()->get();
+    }
+    ShowURL(web_contents, url);
+    browser->window()->Show();
+  }
+
+  base::UmaHistogramMediumTimes("Radium.ProcessSingleton.RelaunchToWindow",
+                                base::TimeTicks::Now() - notification_time);
+}
+
+void OpenURLs(const base::FilePath& profile_path,
+              const std::vector<GURL>& urls,
+              base::TimeTicks notification_time) {
+  // The last window may be closing while the profile loads.
+  auto keep_alive = std::make_unique<ScopedKeepAlive>(
+      KeepAliveOrigin::BROWSER, KeepAliveRestartOption::DISABLED);
+  // Runs synchronously if the profile is already loaded.
+  BrowserProcess::Get()->GetFeatures()->profile_manager()->CreateProfileAsync(
+      profile_path, base::BindOnce(&OpenURLsForProfile, std::move(keep_alive),
+                                   urls, notification_time));
+}
+
+}  // namespace
 
 StartupBrowserCreator::StartupBrowserCreator() = default;
 StartupBrowserCreator::~StartupBrowserCreator() = default;
@@ -16,6 +175,57 @@ bool StartupBrowserCreator::Start(const base::CommandLine& cmd_line,
                                   const base::FilePath& cur_dir,
                                   StartupProfileInfo profile_info,
                                   const Profiles& last_opened_profiles) {
-  SigninWindow::Show(profile_info.profile, base::BindOnce(&ShowGalleryView));
+  if (g_skip_signin_for_testing) {
+    OnSignedIn();
+    return true;
+  }
+
+  SigninWindow::Show(profile_info.profile, base::BindOnce(&OnSignedIn));
+  // The gallery window only follows once the user confirms, so this is the
+  // last point of startup that does not depend on the user.
+  startup_milestones::Record("SigninWindowShown");
+  base::UmaHistogramLongTimes(
+      "Radium.Startup.ColdStartToSigninWindow",
+      base::TimeTicks::Now() -
+          startup_metric_utils::GetCommon().MainEntryPointTicks());
   return true;
 }
+
+// static
+void StartupBrowserCreator::ProcessCommandLineAlreadyRunning(
+    const base::CommandLine& cmd_line,
+    const base::FilePath& cur_dir,
+    base::TimeTicks notification_time) {
+  TRACE_EVENT0("startup",
+               "StartupBrowserCreator::ProcessCommandLineAlreadyRunning");
+  ProfileManager* profile_manager =
+      BrowserProcess::Get()->GetFeatures()->profile_manager();
+
+  base::FilePath profile_path = GetGalleryProfilePath();
+  if (cmd_line.HasSwitch(switches::kProfileDirectory)) {
+    base::FilePath path = profile_manager->user_data_dir().Append(
+        cmd_line.GetSwitchValuePath(switches::kProfileDirectory));
+    if (profile_manager->IsAllowedProfilePath(path)) {
+      profile_path = path;
+    } else {
+      LOG(WARNING) << "Ignoring invalid profile directory " << path;
+    }
+  }
+
+  // Windows of a session only open once the user confirmed the sign-in
+  // window, which holds back relaunches too. Those are not kept alive, so the
+  // browser still exits if the user closes the sign-in window instead.
+  base::OnceClosure relaunch =
+      base::BindOnce(&OpenURLs, profile_path, GetURLsFromCommandLine(cmd_line),
+                     notification_time);
+  if (g_signed_in || g_skip_signin_for_testing) {
+    std::move(relaunch).Run();
+  } else {
+    GetPendingRelaunches().push_back(std::move(relaunch));
+  }
+}
+
+// static
+void StartupBrowserCreator::SetSkipSigninForTesting(bool skip_signin) {
+  g_skip_signin_for_testing = skip_signin;
+}
@@ -5,8 +5,11 @@
 #ifndef RADIUM_BROWSER_UI_STARTUP_STARTUP_BROWSER_CREATOR_H_
 #define RADIUM_BROWSER_UI_STARTUP_STARTUP_BROWSER_CREATOR_H_
 
+#include <vector>
+
 #include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
 
 class Browser;
 class GURL;
@@ -52,6 +55,22 @@ class StartupBrowserCreator {
              const base::FilePath& cur_dir,
              StartupProfileInfo profile_info,
              const Profiles& last_opened_profiles);
+
+  // Handles |cmd_line| forwarded by another browser process through the
+  // ProcessSingleton. Each radium:// URL it carries is opened in a window of
+  // the profile that already shows the same WebUI, or in a new window. Without
+  // URLs a window of the profile is brought to the front. Like the windows
+  // of Start(), these only open once the user confirmed the sign-in window.
+  // |notification_time| is when the message of the other process was
+  // received.
+  static void ProcessCommandLineAlreadyRunning(
+      const base::CommandLine& cmd_line,
+      const base::FilePath& cur_dir,
+      base::TimeTicks notification_time);
+
+  // Makes Start() open the gallery window, and relaunches their windows, right
+  // away instead of waiting for the user to confirm the sign-in window.
+  static void SetSkipSigninForTesting(bool skip_signin);
 };
 
 #endif  // RADIUM_BROWSER_UI_STARTUP_STARTUP_BROWSER_CREATOR_H_
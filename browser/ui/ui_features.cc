@@ -393,6 +393,18 @@ BASE_FEATURE(kWebUITabStripContextMenuAfterTap,
 #endif
 );
 
+// Lets the WebUIs of one radium:// host share a renderer process, and can keep
+// a spare renderer warm for the next WebUI.
+BASE_FEATURE(kWebUIProcessModel,
+             "WebUIProcessModel",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
+const base::FeatureParam<bool> kWebUIProcessModelProcessPerSite{
+    &kWebUIProcessModel, "process-per-site", true};
+
+const base::FeatureParam<bool> kWebUIProcessModelKeepSpareRenderer{
+    &kWebUIProcessModel, "keep-spare-renderer", false};
+
 #if BUILDFLAG(IS_MAC)
 BASE_FEATURE(kViewsFirstRunDialog,
              "ViewsFirstRunDialog",
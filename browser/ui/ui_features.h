@@ -239,6 +239,13 @@ BASE_DECLARE_FEATURE(kWebUITabStrip);
 // tap gesture on the WebUI Tab Strip.
 BASE_DECLARE_FEATURE(kWebUITabStripContextMenuAfterTap);
 
+// Process model for the trusted radium:// WebUIs, see WebUIProcessModel.
+BASE_DECLARE_FEATURE(kWebUIProcessModel);
+// Whether all WebUIs of the same host share one renderer process.
+extern const base::FeatureParam<bool> kWebUIProcessModelProcessPerSite;
+// Whether a spare renderer is kept warm for the next WebUI.
+extern const base::FeatureParam<bool> kWebUIProcessModelKeepSpareRenderer;
+
 // Cocoa to views migration.
 #if BUILDFLAG(IS_MAC)
 BASE_DECLARE_FEATURE(kViewsFirstRunDialog);
@@ -0,0 +1,162 @@
+// Copyright 2025 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/views/dragging/cached_window_finder.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_list.h"
+#include "radium/browser/ui/browser_window.h"
+#include "ui/gfx/geometry/point.h"
+
+namespace {
+
+views::Widget* GetBrowserWidget(Browser* browser) {
+  return browser->window() ? browser->window()->GetWidget() : nullptr;
+}
+
+bool IsWindowVisible(views::Widget* widget) {
+  return widget->IsVisible() && !widget->IsMinimized();
+}
+
+}  // namespace
+
+CachedWindowFinder::CachedWindowFinder()
+    : CachedWindowFinder(std::make_unique<WindowFinder>()) {}
+
+CachedWindowFinder::CachedWindowFinder(
+    std::unique_ptr<WindowFinder> platform_finder)
+    : platform_finder_(std::move(platform_finder)) {
+  BrowserList::AddObserver(this);
+}
+
+CachedWindowFinder::~CachedWindowFinder() {
+  BrowserList::RemoveObserver(this);
+}
+
+gfx::NativeWindow CachedWindowFinder::GetLocalProcessWindowAtPoint(
+    const gfx::Point& screen_point,
+    const std::set<gfx::NativeWindow>& ignore) {
+  if (!valid_) {
+    Rebuild();
+  }
+
+  std::vector<gfx::NativeWindow> candidates;
+  for (const Window& window : windows_) {
+    if (window.visible && window.bounds.Contains(screen_point) &&
+        !ignore.contains(window.native_window)) {
+      candidates.push_back(window.native_window);
+    }
+  }
+
+  if (candidates.empty()) {
+    return gfx::NativeWindow();
+  }
+  if (candidates.size() == 1) {
+    return candidates.front();
+  }
+
+  auto it = topmost_cache_.find(candidates);
+  if (it != topmost_cache_.end()) {
+    return it->second;
+  }
+
+  TRACE_EVENT0("views", "CachedWindowFinder::QueryPlatform");
+  gfx::NativeWindow topmost =
+      platform_finder_->GetLocalProcessWindowAtPoint(screen_point, ignore);
+  // Only remember answers that are about the overlapping windows, anything
+  // else is specific to |screen_point|.
+  if (std::ranges::find(candidates, topmost) != candidates.end()) {
+    topmost_cache_.emplace(std::move(candidates), topmost);
+  }
+  return topmost;
+}
+
+void CachedWindowFinder::InvalidateStackingOrder() {
+  topmost_cache_.clear();
+}
+
+void CachedWindowFinder::OnBrowserAdded(Browser* browser) {
+  Invalidate();
+}
+
+void CachedWindowFinder::OnBrowserRemoved(Browser* browser) {
+  Invalidate();
+}
+
+void CachedWindowFinder::OnWidgetActivationChanged(views::Widget* widget,
+                                                   bool active) {
+  // Activating a window usually raises it.
+  if (active) {
+    InvalidateStackingOrder();
+  }
+}
+
+void CachedWindowFinder::OnWidgetBoundsChanged(views::Widget* widget,
+                                               const gfx::Rect& new_bounds) {
+  auto it = FindWindow(widget);
+  if (it != windows_.end()) {
+    it->bounds = widget->GetWindowBoundsInScreen();
+  }
+}
+
+void CachedWindowFinder::OnWidgetDestroying(views::Widget* widget) {
+  widget_observations_.RemoveObservation(widget);
+  auto it = FindWindow(widget);
+  if (it != windows_.end()) {
+    windows_.erase(it);
+  }
+  Invalidate();
+}
+
+void CachedWindowFinder::OnWidgetShowStateChanged(views::Widget* widget) {
+  auto it = FindWindow(widget);
+  if (it != windows_.end()) {
+    it->visible = IsWindowVisible(widget);
+  }
+  // Restored and shown windows come back on top.
+  InvalidateStackingOrder();
+}
+
+void CachedWindowFinder::OnWidgetVisibilityChanged(views::Widget* widget,
+                                                   bool visible) {
+  OnWidgetShowStateChanged(widget);
+}
+
+void CachedWindowFinder::Rebuild() {
+  TRACE_EVENT0("views", "CachedWindowFinder::Rebuild");
+  std::set<views::Widget*> widgets;
+  for (Browser* browser : *BrowserList::GetInstance()) {
+    if (views::Widget* widget = GetBrowserWidget(browser)) {
+      widgets.insert(widget);
+    }
+  }
+
+  // Keep the windows that are still there, and add the new ones.
+  std::erase_if(windows_, [&widgets](const Window& window) {
+    return !widgets.erase(window.widget);
+  });
+  for (views::Widget* widget : widgets) {
+    windows_.push_back({widget, widget->GetNativeWindow(),
+                        widget->GetWindowBoundsInScreen(),
+                        IsWindowVisible(widget)});
+    widget_observations_.AddObservation(widget);
+  }
+  valid_ = true;
+}
+
+void CachedWindowFinder::Invalidate() {
+  valid_ = false;
+  // Native windows may be reused by new windows.
+  InvalidateStackingOrder();
+}
+
+std::vector<CachedWindowFinder::Window>::iterator
+CachedWindowFinder::FindWindow(views::Widget* widget) {
+  return std::ranges::find(windows_, widget, &Window::widget);
+}
@@ -0,0 +1,98 @@
+// Copyright 2025 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_VIEWS_DRAGGING_CACHED_WINDOW_FINDER_H_
+#define RADIUM_BROWSER_UI_VIEWS_DRAGGING_CACHED_WINDOW_FINDER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/scoped_multi_source_observation.h"
+#include "radium/browser/ui/browser_list_observer.h"
+#include "radium/browser/ui/window_finder.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/views/widget/widget.h"
+#include "ui/views/widget/widget_observer.h"
+
+// A WindowFinder that hit-tests against a cache of the bounds of the browser
+// windows instead of asking the platform on every call, which on X11 is a
+// stacking order query to the server for each mouse move of a drag.
+//
+// Views does not report changes of the stacking order, so the cache does not
+// guess it. A point covered by a single window is answered from the cache.
+// For a point covered by several windows the platform is asked once, and the
+// answer is remembered for that set of overlapping windows until something
+// that may restack them is seen: a window is activated, shown, hidden or
+// minimized, a browser is added or removed, or InvalidateStackingOrder() is
+// called by code that restacks windows itself.
+//
+// Other windows of the process and windows of other applications are not
+// cached, and are assumed not to cover the browser windows.
+class CachedWindowFinder : public WindowFinder,
+                           public BrowserListObserver,
+                           public views::WidgetObserver {
+ public:
+  CachedWindowFinder();
+  // Asks |platform_finder| for the topmost of overlapping windows.
+  explicit CachedWindowFinder(std::unique_ptr<WindowFinder> platform_finder);
+  CachedWindowFinder(const CachedWindowFinder&) = delete;
+  CachedWindowFinder& operator=(const CachedWindowFinder&) = delete;
+
+  ~CachedWindowFinder() override;
+
+  // WindowFinder:
+  gfx::NativeWindow GetLocalProcessWindowAtPoint(
+      const gfx::Point& screen_point,
+      const std::set<gfx::NativeWindow>& ignore) override;
+
+  // Forgets the topmost windows reported by the platform. Must be called
+  // after restacking browser windows without activating them, for instance
+  // with views::Widget::StackAtTop().
+  void InvalidateStackingOrder();
+
+ private:
+  struct Window {
+    raw_ptr<views::Widget> widget;
+    gfx::NativeWindow native_window;
+    gfx::Rect bounds;
+    bool visible = false;
+  };
+
+  // BrowserListObserver:
+  void OnBrowserAdded(Browser* browser) override;
+  void OnBrowserRemoved(Browser* browser) override;
+
+  // views::WidgetObserver:
+  void OnWidgetActivationChanged(views::Widget* widget, bool active) override;
+  void OnWidgetBoundsChanged(views::Widget* widget,
+                             const gfx::Rect& new_bounds) override;
+  void OnWidgetDestroying(views::Widget* widget) override;
+  void OnWidgetShowStateChanged(views::Widget* widget) override;
+  void OnWidgetVisibilityChanged(views::Widget* widget, bool visible) override;
+
+  // Syncs |windows_| with the browser windows.
+  void Rebuild();
+
+  void Invalidate();
+
+  std::vector<Window>::iterator FindWindow(views::Widget* widget);
+
+  const std::unique_ptr<WindowFinder> platform_finder_;
+
+  // The browser windows, in no particular order.
+  std::vector<Window> windows_;
+  bool valid_ = false;
+
+  // The topmost window reported by the platform for a set of overlapping
+  // windows, listed in |windows_| order.
+  std::map<std::vector<gfx::NativeWindow>, gfx::NativeWindow> topmost_cache_;
+
+  base::ScopedMultiSourceObservation<views::Widget, views::WidgetObserver>
+      widget_observations_{this};
+};
+
+#endif  // RADIUM_BROWSER_UI_VIEWS_DRAGGING_CACHED_WINDOW_FINDER_H_
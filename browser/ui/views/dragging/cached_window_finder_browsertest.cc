@@ -0,0 +1,134 @@
+// Copyright 2025 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/views/dragging/cached_window_finder.h"
+
+#include <memory>
+#include <set>
+
+#include "base/memory/raw_ptr.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_window.h"
+#include "radium/browser/ui/gallery/gallery_window_factory.h"
+#include "radium/browser/ui/window_finder.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/views/widget/widget.h"
+
+namespace {
+
+// Answers with a fixed window, and counts how often it is asked.
+class FakePlatformFinder : public WindowFinder {
+ public:
+  FakePlatformFinder(gfx::NativeWindow* topmost, int* query_count)
+      : topmost_(topmost), query_count_(query_count) {}
+
+  // WindowFinder:
+  gfx::NativeWindow GetLocalProcessWindowAtPoint(
+      const gfx::Point& screen_point,
+      const std::set<gfx::NativeWindow>& ignore) override {
+    ++*query_count_;
+    return *topmost_;
+  }
+
+ private:
+  raw_ptr<gfx::NativeWindow> topmost_;
+  raw_ptr<int> query_count_;
+};
+
+}  // namespace
+
+class CachedWindowFinderBrowserTest : public RadiumBrowserTest {
+ protected:
+  void PreRunTestOnMainThread() override {
+    RadiumBrowserTest::PreRunTestOnMainThread();
+    finder_ = std::make_unique<CachedWindowFinder>(
+        std::make_unique<FakePlatformFinder>(&topmost_, &query_count_));
+    // The window opened at startup stays out of the way.
+    ignore_.insert(GetWidget(browser())->GetNativeWindow());
+  }
+
+  void PostRunTestOnMainThread() override {
+    finder_.reset();
+    RadiumBrowserTest::PostRunTestOnMainThread();
+  }
+
+  views::Widget* GetWidget(Browser* browser) {
+    return browser->window()->GetWidget();
+  }
+
+  views::Widget* CreateWindow(const gfx::Rect& bounds) {
+    views::Widget* widget =
+        GetWidget(CreateGalleryBrowser(browser()->profile()));
+    widget->SetBounds(bounds);
+    return widget;
+  }
+
+  gfx::NativeWindow GetWindowAt(int x, int y) {
+    return finder_->GetLocalProcessWindowAtPoint(gfx::Point(x, y), ignore_);
+  }
+
+  gfx::NativeWindow topmost_ = gfx::NativeWindow();
+  int query_count_ = 0;
+  std::set<gfx::NativeWindow> ignore_;
+  std::unique_ptr<CachedWindowFinder> finder_;
+};
+
+// Points covered by one window never reach the platform, and the topmost of
+// overlapping windows is asked once until the windows may have been
+// restacked.
+IN_PROC_BROWSER_TEST_F(CachedWindowFinderBrowserTest, CachesTopmostWindow) {
+  views::Widget* left = CreateWindow(gfx::Rect(0, 0, 400, 300));
+  views::Widget* right = CreateWindow(gfx::Rect(200, 0, 400, 300));
+  ASSERT_EQ(gfx::Rect(0, 0, 400, 300), left->GetWindowBoundsInScreen());
+
+  EXPECT_EQ(left->GetNativeWindow(), GetWindowAt(100, 100));
+  EXPECT_EQ(right->GetNativeWindow(), GetWindowAt(500, 100));
+  EXPECT_EQ(gfx::NativeWindow(), GetWindowAt(700, 100));
+  EXPECT_EQ(0, query_count_);
+
+  topmost_ = right->GetNativeWindow();
+  EXPECT_EQ(right->GetNativeWindow(), GetWindowAt(300, 100));
+  EXPECT_EQ(right->GetNativeWindow(), GetWindowAt(350, 200));
+  EXPECT_EQ(1, query_count_);
+
+  // Raising a window without activating it must be reported.
+  topmost_ = left->GetNativeWindow();
+  finder_->InvalidateStackingOrder();
+  EXPECT_EQ(left->GetNativeWindow(), GetWindowAt(300, 100));
+  EXPECT_EQ(2, query_count_);
+
+  // Showing a window again may raise it.
+  right->Hide();
+  EXPECT_EQ(left->GetNativeWindow(), GetWindowAt(300, 100));
+  right->Show();
+  topmost_ = right->GetNativeWindow();
+  EXPECT_EQ(right->GetNativeWindow(), GetWindowAt(300, 100));
+  EXPECT_EQ(3, query_count_);
+}
+
+// Bounds are followed without asking the platform.
+IN_PROC_BROWSER_TEST_F(CachedWindowFinderBrowserTest, FollowsBounds) {
+  views::Widget* widget = CreateWindow(gfx::Rect(0, 0, 400, 300));
+  EXPECT_EQ(widget->GetNativeWindow(), GetWindowAt(100, 100));
+
+  widget->SetBounds(gfx::Rect(1000, 0, 400, 300));
+  EXPECT_EQ(gfx::NativeWindow(), GetWindowAt(100, 100));
+  EXPECT_EQ(widget->GetNativeWindow(), GetWindowAt(1100, 100));
+  EXPECT_EQ(0, query_count_);
+}
+
+// Windows that open or close after the first query are picked up.
+IN_PROC_BROWSER_TEST_F(CachedWindowFinderBrowserTest, FollowsBrowserList) {
+  EXPECT_EQ(gfx::NativeWindow(), GetWindowAt(100, 100));
+
+  views::Widget* widget = CreateWindow(gfx::Rect(0, 0, 400, 300));
+  EXPECT_EQ(widget->GetNativeWindow(), GetWindowAt(100, 100));
+
+  widget->CloseNow();
+  EXPECT_EQ(gfx::NativeWindow(), GetWindowAt(100, 100));
+}
@@ -4,14 +4,18 @@
 
 #include "radium/browser/ui/views/dragging/drag_controller.h"
 
+#include <optional>
 #include <utility>
 
 #include "base/functional/bind.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "base/trace_event/typed_macros.h"
 #include "content/public/browser/web_contents.h"
+#include "radium/browser/ui/views/dragging/cached_window_finder.h"
 #include "radium/browser/ui/views/dragging/drag_context.h"
-#include "radium/browser/ui/window_finder.h"
 #include "ui/display/screen.h"
 #include "ui/views/view.h"
 #include "ui/views/view_tracker.h"
@@ -76,7 +80,7 @@ DragController::Liveness DragController::Init(
   source_context_destory_tracker_->SetIsDeletingCallback(base::BindOnce(
       &DragController::OnSourceContextDestory, base::Unretained(this)));
 
-  window_finder_ = std::make_unique<WindowFinder>();
+  window_finder_ = std::make_unique<CachedWindowFinder>();
   return Liveness::ALIVE;
 }
 
@@ -127,9 +131,14 @@ DragController::Liveness DragController::Init(
     }
 
     current_state_ = DragState::kDraggingTabs;
+    return ContinueDragging(point_in_screen);
   }
 
-  return ContinueDragging(point_in_screen);
+  // Only the latest position is processed, once per frame. Changes of the
+  // attached context happen from a task posted by ContinueDraggingAtFrame().
+  move_coalescer_.AddMove(point_in_screen,
+                          GetAttachedWidget()->GetCompositor());
+  return Liveness::ALIVE;
 }
 
 void DragController::EndDrag(EndDragReason reason) {
@@ -147,6 +156,17 @@ void DragController::EndDrag(EndDragReason reason) {
     return;
   }
 
+  // A dropped drag ends where the pointer last was, which may be over another
+  // context. A canceled one reverts.
+  if (reason == END_DRAG_COMPLETE) {
+    if (FlushPendingMove() == Liveness::DELETED) {
+      return;
+    }
+  } else {
+    std::ignore = move_coalescer_.TakePendingMove();
+    pending_target_point_in_screen_.reset();
+  }
+
   // End the move loop if we're in one. Note that the drag will end (just below)
   // before the move loop actually exits.
   if (current_state_ == DragState::kDraggingWindow && in_move_loop_) {
@@ -330,6 +350,61 @@ bool DragController::CanStartDrag(const gfx::Point& point_in_screen) const {
   return Liveness::ALIVE;
 }
 
+void DragController::ContinueDraggingAtFrame(
+    const gfx::Point& point_in_screen) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  // The drag may have been stopped or be waiting for the move loop to exit
+  // since the position was reported.
+  if (!IsDraggingAttached()) {
+    return;
+  }
+
+  // This runs inside Compositor::BeginMainFrame(), where detaching, running
+  // the nested move loop or deleting `this` is not safe. Only the attached
+  // views follow the pointer here, the target context is updated from a task.
+  if (current_state_ == DragState::kDraggingTabs) {
+    MoveAttached(point_in_screen, false);
+  }
+  const bool update_posted = pending_target_point_in_screen_.has_value();
+  pending_target_point_in_screen_ = point_in_screen;
+  if (!update_posted) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&DragController::UpdateTargetContext,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  base::UmaHistogramCustomMicrosecondsTimes(
+      "Radium.Drag.FrameCost", base::TimeTicks::Now() - start_time,
+      base::Microseconds(1), base::Milliseconds(100), 50);
+}
+
+void DragController::UpdateTargetContext() {
+  std::optional<gfx::Point> point_in_screen =
+      std::exchange(pending_target_point_in_screen_, std::nullopt);
+  if (!point_in_screen || !IsDraggingAttached()) {
+    return;
+  }
+  std::ignore = ContinueDragging(point_in_screen.value());
+  // N.B. `this` may be deleted here.
+}
+
+DragController::Liveness DragController::FlushPendingMove() {
+  std::optional<gfx::Point> point_in_screen =
+      move_coalescer_.TakePendingMove();
+  if (!point_in_screen) {
+    point_in_screen = pending_target_point_in_screen_;
+  }
+  pending_target_point_in_screen_.reset();
+  if (!point_in_screen || !IsDraggingAttached()) {
+    return Liveness::ALIVE;
+  }
+  return ContinueDragging(point_in_screen.value());
+}
+
+bool DragController::IsDraggingAttached() const {
+  return current_state_ == DragState::kDraggingTabs ||
+         current_state_ == DragState::kDraggingWindow;
+}
+
 std::tuple<std::unique_ptr<DragController>,
            std::vector<std::unique_ptr<views::View>>>
 DragController::Detach(ReleaseCapture release_capture) {
@@ -688,6 +763,7 @@ void DragController::BringWindowUnderPointToFront(
   if (current_state_ == DragState::kDraggingWindow) {
     attached_context_->GetWidget()->StackAtTop();
   }
+  window_finder_->InvalidateStackingOrder();
 }
 
 DragController::Liveness DragController::SetCapture(DragContext* context) {
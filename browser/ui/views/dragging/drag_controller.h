@@ -5,15 +5,18 @@
 #ifndef RADIUM_BROWSER_UI_VIEWS_DRAGGING_DRAG_CONTROLLER_H_
 #define RADIUM_BROWSER_UI_VIEWS_DRAGGING_DRAG_CONTROLLER_H_
 
+#include <optional>
+
 #include "base/scoped_observation.h"
 #include "base/timer/timer.h"
+#include "radium/browser/ui/views/dragging/drag_move_coalescer.h"
 #include "ui/base/dragdrop/mojom/drag_drop_types.mojom-shared.h"
 #include "ui/gfx/geometry/point.h"
 #include "ui/gfx/native_widget_types.h"
 #include "ui/views/widget/widget_observer.h"
 
+class CachedWindowFinder;
 class DragContext;
-class WindowFinder;
 
 namespace views {
 class View;
@@ -158,6 +161,22 @@ class DragController : public views::WidgetObserver {
   // drag to (which may be the currently attached one).
   [[nodiscard]] Liveness ContinueDragging(const gfx::Point& point_in_screen);
 
+  // Moves the attached views to the latest position reported during a frame,
+  // and posts UpdateTargetContext() for it.
+  void ContinueDraggingAtFrame(const gfx::Point& point_in_screen);
+
+  // Runs ContinueDragging() for the latest position processed at a frame,
+  // which may attach the drag to another context or detach it.
+  void UpdateTargetContext();
+
+  // Runs ContinueDragging() for the position still waiting for the next frame
+  // or for UpdateTargetContext(), if any. Called before the drag is dropped so
+  // that it ends where the pointer last was.
+  [[nodiscard]] Liveness FlushPendingMove();
+
+  // Returns true while the dragged views or window follow the pointer.
+  bool IsDraggingAttached() const;
+
   // Detach the dragged tabs from the current TabDragContext. Returns
   // ownership of the owned controller, which must be `this`, if
   // `attached_context_` currently owns a controller. Otherwise returns
@@ -245,7 +264,7 @@ class DragController : public views::WidgetObserver {
   // Non-null for the duration of RunMoveLoop.
   raw_ptr<views::Widget> move_loop_widget_;
 
-  std::unique_ptr<WindowFinder> window_finder_;
+  std::unique_ptr<CachedWindowFinder> window_finder_;
 
   base::ScopedObservation<views::Widget, views::WidgetObserver>
       widget_observation_{this};
@@ -293,6 +312,15 @@ class DragController : public views::WidgetObserver {
   // the drag.
   bool is_dragging_new_browser_;
 
+  // The latest position processed at a frame, until UpdateTargetContext()
+  // runs for it.
+  std::optional<gfx::Point> pending_target_point_in_screen_;
+
+  // Coalesces the moves reported once the drag has started.
+  DragMoveCoalescer move_coalescer_{
+      base::BindRepeating(&DragController::ContinueDraggingAtFrame,
+                          base::Unretained(this))};
+
   base::WeakPtrFactory<DragController> weak_factory_{this};
 };
 
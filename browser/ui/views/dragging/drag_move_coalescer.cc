@@ -0,0 +1,70 @@
+// Copyright 2025 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/views/dragging/drag_move_coalescer.h"
+
+#include <utility>
+
+#include "base/metrics/histogram_functions.h"
+#include "ui/compositor/compositor.h"
+
+DragMoveCoalescer::DragMoveCoalescer(MoveCallback callback)
+    : callback_(std::move(callback)) {}
+
+DragMoveCoalescer::~DragMoveCoalescer() {
+  StopObservingCompositor();
+  if (move_count_ > 0) {
+    base::UmaHistogramCounts100000("Radium.Drag.DroppedMovesPerDrag",
+                                   dropped_move_count_);
+  }
+}
+
+void DragMoveCoalescer::AddMove(const gfx::Point& point_in_screen,
+                                ui::Compositor* compositor) {
+  ++move_count_;
+  if (pending_point_in_screen_) {
+    ++dropped_move_count_in_frame_;
+    ++dropped_move_count_;
+  }
+  pending_point_in_screen_ = point_in_screen;
+
+  if (!compositor) {
+    StopObservingCompositor();
+    OnAnimationStep(base::TimeTicks::Now());
+    return;
+  }
+
+  // The dragged widget may have changed since the last move.
+  if (compositor_ != compositor) {
+    StopObservingCompositor();
+    compositor_ = compositor;
+    compositor_->AddAnimationObserver(this);
+  }
+}
+
+std::optional<gfx::Point> DragMoveCoalescer::TakePendingMove() {
+  StopObservingCompositor();
+  dropped_move_count_in_frame_ = 0;
+  return std::exchange(pending_point_in_screen_, std::nullopt);
+}
+
+void DragMoveCoalescer::OnAnimationStep(base::TimeTicks timestamp) {
+  base::UmaHistogramCounts100("Radium.Drag.DroppedMovesPerFrame",
+                              dropped_move_count_in_frame_);
+  std::optional<gfx::Point> point_in_screen = TakePendingMove();
+  if (point_in_screen) {
+    callback_.Run(point_in_screen.value());
+  }
+}
+
+void DragMoveCoalescer::OnCompositingShuttingDown(ui::Compositor* compositor) {
+  StopObservingCompositor();
+}
+
+void DragMoveCoalescer::StopObservingCompositor() {
+  if (compositor_) {
+    compositor_->RemoveAnimationObserver(this);
+    compositor_ = nullptr;
+  }
+}
@@ -0,0 +1,65 @@
+// Copyright 2025 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_VIEWS_DRAGGING_DRAG_MOVE_COALESCER_H_
+#define RADIUM_BROWSER_UI_VIEWS_DRAGGING_DRAG_MOVE_COALESCER_H_
+
+#include <optional>
+
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "ui/compositor/compositor_animation_observer.h"
+#include "ui/gfx/geometry/point.h"
+
+namespace ui {
+class Compositor;
+}  // namespace ui
+
+// Coalesces the pointer positions of a drag so that only the latest one is
+// processed, once per frame of the compositor of the dragged widget. High
+// polling rate mice report far more moves than can be presented.
+class DragMoveCoalescer : public ui::CompositorAnimationObserver {
+ public:
+  using MoveCallback = base::RepeatingCallback<void(const gfx::Point&)>;
+
+  // |callback| is run with the latest position at each frame, from the
+  // compositor's animation step. It must not delete the coalescer or run a
+  // nested loop.
+  explicit DragMoveCoalescer(MoveCallback callback);
+  DragMoveCoalescer(const DragMoveCoalescer&) = delete;
+  DragMoveCoalescer& operator=(const DragMoveCoalescer&) = delete;
+
+  ~DragMoveCoalescer() override;
+
+  // Makes |point_in_screen| the position to process at the next frame of
+  // |compositor|, replacing any pending one. Processes it immediately if there
+  // is no compositor.
+  void AddMove(const gfx::Point& point_in_screen, ui::Compositor* compositor);
+
+  // Returns and clears the pending position, if any, without running the
+  // callback.
+  std::optional<gfx::Point> TakePendingMove();
+
+ private:
+  // ui::CompositorAnimationObserver:
+  void OnAnimationStep(base::TimeTicks timestamp) override;
+  void OnCompositingShuttingDown(ui::Compositor* compositor) override;
+
+  void StopObservingCompositor();
+
+  MoveCallback callback_;
+
+  std::optional<gfx::Point> pending_point_in_screen_;
+
+  // The compositor whose next frame processes |pending_point_in_screen_|.
+  raw_ptr<ui::Compositor> compositor_ = nullptr;
+
+  // The number of moves since the last processed one, and over the whole
+  // drag, that were replaced before being processed.
+  int dropped_move_count_in_frame_ = 0;
+  int dropped_move_count_ = 0;
+  int move_count_ = 0;
+};
+
+#endif  // RADIUM_BROWSER_UI_VIEWS_DRAGGING_DRAG_MOVE_COALESCER_H_
@@ -13,6 +13,8 @@
 #include "radium/browser/ui/color/radium_color_id.h"
 #include "radium/browser/ui/views/frame/untitled_widget.h"
 #include "radium/browser/ui/views/radium_layout_provider.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager_factory.h"
 #include "radium/common/webui_url_constants.h"
 #include "ui/base/hit_test.h"
 #include "ui/views/accessibility/view_accessibility.h"
@@ -130,7 +132,13 @@ GalleryView::GalleryView(std::unique_ptr<Browser> browser)
               .CopyAddressTo(&webview_)
               .CustomConfigure(base::BindOnce(
                   [](Browser* browser, views::WebView* webview) {
-                    webview->SetWebContents(browser->CreateWebContents());
+                    std::unique_ptr<content::WebContents> web_contents =
+                        WebUIContentsPreloadManagerFactory::GetForProfile(
+                            browser->profile())
+                            ->MakeContents(
+                                GURL(radium::kRadiumUIWebuiGalleryURL));
+                    webview->SetWebContents(web_contents.get());
+                    browser->AddWebContents(std::move(web_contents));
                   },
                   browser_.get()))
               .SetProperty(views::kBoxLayoutFlexKey,
@@ -151,8 +159,6 @@ gfx::Size GalleryView::GetMinimumSize() const {
 void GalleryView::AddedToWidget() {
   GetWidget()->AddObserver(this);
   OnWidgetShowStateChanged(GetWidget());
-
-  webview_->LoadInitialURL(GURL(radium::kRadiumUIWebuiGalleryURL));
 }
 
 void GalleryView::RemovedFromWidget() {
@@ -208,6 +214,13 @@ void GalleryView::OnWidgetShowStateChanged(views::Widget* widget) {
       0, 0));
 }
 
+void GalleryView::OnWebContentsReplaced(content::WebContents* old_contents,
+                                        content::WebContents* new_contents) {
+  if (webview_->GetWebContents() == old_contents) {
+    webview_->SetWebContents(new_contents);
+  }
+}
+
 void GalleryView::OnWebContentsEmpty() {
   GetWidget()->Close();
 }
@@ -52,6 +52,8 @@ class GalleryView : public UntitledWidgetDelegateView,
   void OnWidgetShowStateChanged(views::Widget* widget) override;
 
   // BrowserObserver:
+  void OnWebContentsReplaced(content::WebContents* old_contents,
+                             content::WebContents* new_contents) override;
   void OnWebContentsEmpty() override;
 
  private:
@@ -42,6 +42,9 @@
 
 namespace {
 
+// The view of the sign-in window that is shown, if any.
+SigninFrameView* g_signin_frame_view = nullptr;
+
 // Calculates the height of the QR Code with padding.
 constexpr gfx::Size GetQRCodeImageSize() {
   constexpr int kQRImageSizePx = 150;
@@ -82,11 +85,25 @@ void SigninWindow::Show(Profile* profile, base::OnceClosure finish_callback) {
   widget->Show();
 }
 
+// static
+void SigninWindow::CloseForTesting() {
+  if (g_signin_frame_view) {
+    // Destroys the view, which releases its keep-alive.
+    g_signin_frame_view->GetWidget()->CloseNow();
+  }
+}
+
 SigninFrameView::SigninFrameView()
     : keep_alive_(KeepAliveOrigin::USER_MANAGER_VIEW,
-                  KeepAliveRestartOption::DISABLED) {}
+                  KeepAliveRestartOption::DISABLED) {
+  g_signin_frame_view = this;
+}
 
-SigninFrameView::~SigninFrameView() = default;
+SigninFrameView::~SigninFrameView() {
+  if (g_signin_frame_view == this) {
+    g_signin_frame_view = nullptr;
+  }
+}
 
 void SigninFrameView::Init(views::Widget* widget,
                            base::OnceClosure finish_callback) {
@@ -0,0 +1,207 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/web_contents_lifecycle_controller.h"
+
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/trace_event/trace_event.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/webui/radium_webui_config.h"
+#include "radium/browser/ui/webui/radium_webui_config_map.h"
+#include "radium/common/pref_names.h"
+
+namespace {
+
+// A WebContents that was discarded and not shown since, or whose renderer
+// crashed, has nothing to freeze or discard. Discarding it again would only
+// replace it with another empty WebContents.
+bool HasLiveRenderer(content::WebContents* web_contents) {
+  return !web_contents->WasDiscarded() &&
+         web_contents->GetPrimaryMainFrame()->IsRenderFrameLive();
+}
+
+}  // namespace
+
+WebContentsLifecycleController::BackgroundState::BackgroundState() = default;
+WebContentsLifecycleController::BackgroundState::~BackgroundState() = default;
+
+WebContentsLifecycleController::WebContentsLifecycleController(
+    Browser* browser)
+    : browser_(browser),
+      web_contents_collection_(this),
+      memory_pressure_listener_(
+          FROM_HERE,
+          base::BindRepeating(&WebContentsLifecycleController::OnMemoryPressure,
+                              base::Unretained(this))) {
+  browser_observer_.Observe(browser);
+}
+
+WebContentsLifecycleController::~WebContentsLifecycleController() = default;
+
+void WebContentsLifecycleController::OnWebContentsAdded(
+    content::WebContents* web_contents) {
+  web_contents_collection_.StartObserving(web_contents);
+  if (web_contents->GetVisibility() != content::Visibility::VISIBLE) {
+    OnHidden(web_contents);
+  }
+}
+
+void WebContentsLifecycleController::OnWebContentsRemoved(
+    content::WebContents* web_contents) {
+  web_contents_collection_.StopObserving(web_contents);
+  // The WebContents may be moved to another browser, which manages its
+  // lifecycle from now on.
+  OnShown(web_contents);
+}
+
+void WebContentsLifecycleController::WebContentsDestroyed(
+    content::WebContents* web_contents) {
+  background_contents_.erase(web_contents);
+}
+
+void WebContentsLifecycleController::OnVisibilityChanged(
+    content::WebContents* web_contents,
+    content::Visibility visibility) {
+  if (visibility == content::Visibility::VISIBLE) {
+    OnShown(web_contents);
+  } else {
+    OnHidden(web_contents);
+  }
+}
+
+void WebContentsLifecycleController::OnHidden(
+    content::WebContents* web_contents) {
+  if (background_contents_.contains(web_contents)) {
+    return;
+  }
+
+  auto state = std::make_unique<BackgroundState>();
+  if (browser_->profile()->GetPrefs()->GetBoolean(
+          prefs::kBackgroundContentsFreezingEnabled)) {
+    state->freeze_timer.Start(
+        FROM_HERE,
+        browser_->profile()->GetPrefs()->GetTimeDelta(
+            prefs::kBackgroundContentsFreezeDelay),
+        base::BindOnce(&WebContentsLifecycleController::Freeze,
+                       base::Unretained(this), web_contents));
+  }
+  background_contents_[web_contents] = std::move(state);
+}
+
+void WebContentsLifecycleController::OnShown(
+    content::WebContents* web_contents) {
+  auto it = background_contents_.find(web_contents);
+  if (it == background_contents_.end()) {
+    return;
+  }
+
+  if (it->second->frozen) {
+    web_contents->SetPageFrozen(false);
+    base::UmaHistogramLongTimes(
+        "Radium.WebContentsLifecycle.FrozenDuration",
+        base::TimeTicks::Now() - it->second->frozen_time);
+  }
+  background_contents_.erase(it);
+}
+
+bool WebContentsLifecycleController::CanFreeze(
+    content::WebContents* web_contents) const {
+  if (!browser_->profile()->GetPrefs()->GetBoolean(
+          prefs::kBackgroundContentsFreezingEnabled) ||
+      !HasLiveRenderer(web_contents) ||
+      web_contents->IsCurrentlyAudible() || web_contents->IsBeingCaptured()) {
+    return false;
+  }
+
+  RadiumWebUIConfig* config = RadiumWebUIConfigMap::GetInstance().GetConfig(
+      browser_->profile(), web_contents->GetLastCommittedURL());
+  return !config || config->CanFreeze(browser_->profile());
+}
+
+bool WebContentsLifecycleController::CanDiscard(
+    content::WebContents* web_contents) const {
+  if (!browser_->profile()->GetPrefs()->GetBoolean(
+          prefs::kBackgroundContentsDiscardingEnabled) ||
+      !HasLiveRenderer(web_contents) ||
+      web_contents->IsCurrentlyAudible() || web_contents->IsBeingCaptured() ||
+      web_contents->NeedToFireBeforeUnloadOrUnloadEvents() ||
+      !web_contents->GetController().GetLastCommittedEntry()) {
+    return false;
+  }
+
+  RadiumWebUIConfig* config = RadiumWebUIConfigMap::GetInstance().GetConfig(
+      browser_->profile(), web_contents->GetLastCommittedURL());
+  return !config || config->CanDiscard(browser_->profile());
+}
+
+void WebContentsLifecycleController::Freeze(
+    content::WebContents* web_contents) {
+  auto it = background_contents_.find(web_contents);
+  CHECK(it != background_contents_.end());
+  if (it->second->frozen || !CanFreeze(web_contents)) {
+    return;
+  }
+
+  TRACE_EVENT0("browser", "WebContentsLifecycleController::Freeze");
+  web_contents->SetPageFrozen(true);
+  it->second->frozen = true;
+  it->second->frozen_time = base::TimeTicks::Now();
+}
+
+void WebContentsLifecycleController::Discard(
+    content::WebContents* web_contents) {
+  TRACE_EVENT0("browser", "WebContentsLifecycleController::Discard");
+  background_contents_.erase(web_contents);
+
+  // The replacement has no renderer until it is shown, at which point the
+  // NavigationController reloads the last committed entry.
+  content::WebContents::CreateParams params(web_contents->GetBrowserContext());
+  params.initially_hidden = true;
+  params.desired_renderer_state =
+      content::WebContents::CreateParams::kNoRendererProcess;
+  std::unique_ptr<content::WebContents> new_contents =
+      content::WebContents::Create(params);
+  new_contents->GetController().CopyStateFrom(&web_contents->GetController(),
+                                              /*needs_reload=*/true);
+  new_contents->SetWasDiscarded(true);
+  web_contents->AboutToBeDiscarded(new_contents.get());
+
+  std::unique_ptr<content::WebContents> old_contents =
+      browser_->ReplaceWebContents(web_contents, std::move(new_contents));
+  // Destroying the old WebContents releases its renderer.
+  old_contents.reset();
+}
+
+void WebContentsLifecycleController::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    return;
+  }
+
+  // Under moderate pressure only discard what has been in the background long
+  // enough to be frozen.
+  const bool critical =
+      level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  std::vector<content::WebContents*> to_discard;
+  for (const auto& [web_contents, state] : background_contents_) {
+    if ((critical || state->frozen) && CanDiscard(web_contents)) {
+      to_discard.push_back(web_contents);
+    }
+  }
+
+  for (content::WebContents* web_contents : to_discard) {
+    Discard(web_contents);
+  }
+  base::UmaHistogramCounts100("Radium.WebContentsLifecycle.DiscardCount",
+                              to_discard.size());
+}
@@ -0,0 +1,94 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEB_CONTENTS_LIFECYCLE_CONTROLLER_H_
+#define RADIUM_BROWSER_UI_WEB_CONTENTS_LIFECYCLE_CONTROLLER_H_
+
+#include <map>
+#include <memory>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/raw_ptr.h"
+#include "base/scoped_observation.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "radium/browser/tab_contents/web_contents_collection.h"
+#include "radium/browser/ui/browser_observer.h"
+
+class Browser;
+
+namespace content {
+class WebContents;
+}  // namespace content
+
+// Manages the lifecycle of the WebContents of a Browser while they are in the
+// background, so that many windows can stay open without their renderers
+// using memory for content nobody looks at:
+//
+// * A WebContents that has been hidden or occluded for
+//   prefs::kBackgroundContentsFreezeDelay is frozen, and unfrozen as soon as
+//   it becomes visible again.
+// * Under memory pressure hidden or occluded WebContents are discarded: they
+//   are replaced by a WebContents without a renderer that keeps their
+//   navigation history, and that reloads when it is shown.
+//
+// Both can be turned off with profile prefs, and a WebUI can opt out through
+// RadiumWebUIConfig::CanFreeze() and CanDiscard().
+class WebContentsLifecycleController : public BrowserObserver,
+                                       public WebContentsCollection::Observer {
+ public:
+  explicit WebContentsLifecycleController(Browser* browser);
+  WebContentsLifecycleController(const WebContentsLifecycleController&) =
+      delete;
+  WebContentsLifecycleController& operator=(
+      const WebContentsLifecycleController&) = delete;
+
+  ~WebContentsLifecycleController() override;
+
+ private:
+  // The lifecycle state of a WebContents that is not visible.
+  struct BackgroundState {
+    BackgroundState();
+    ~BackgroundState();
+
+    // Runs Freeze() once the freeze delay has passed.
+    base::OneShotTimer freeze_timer;
+    bool frozen = false;
+    base::TimeTicks frozen_time;
+  };
+
+  // BrowserObserver:
+  void OnWebContentsAdded(content::WebContents* web_contents) override;
+  void OnWebContentsRemoved(content::WebContents* web_contents) override;
+
+  // WebContentsCollection::Observer:
+  void WebContentsDestroyed(content::WebContents* web_contents) override;
+  void OnVisibilityChanged(content::WebContents* web_contents,
+                           content::Visibility visibility) override;
+
+  void OnHidden(content::WebContents* web_contents);
+  void OnShown(content::WebContents* web_contents);
+
+  bool CanFreeze(content::WebContents* web_contents) const;
+  bool CanDiscard(content::WebContents* web_contents) const;
+  void Freeze(content::WebContents* web_contents);
+  void Discard(content::WebContents* web_contents);
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  raw_ptr<Browser> browser_;
+
+  WebContentsCollection web_contents_collection_;
+
+  // The WebContents of |browser_| that are hidden or occluded.
+  std::map<content::WebContents*, std::unique_ptr<BackgroundState>>
+      background_contents_;
+
+  base::ScopedObservation<Browser, BrowserObserver> browser_observer_{this};
+
+  base::MemoryPressureListener memory_pressure_listener_;
+};
+
+#endif  // RADIUM_BROWSER_UI_WEB_CONTENTS_LIFECYCLE_CONTROLLER_H_
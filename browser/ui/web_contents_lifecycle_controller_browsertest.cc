@@ -0,0 +1,135 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/web_contents_lifecycle_controller.h"
+
+#include <memory>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/time/time.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/common/pref_names.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+// Records the freeze event of the page lifecycle API, which a page receives
+// right before it is frozen.
+constexpr char kRecordFreezeScript[] =
+    "window.wasFrozen = false;"
+    "document.addEventListener('freeze', () => { window.wasFrozen = true; });";
+
+}  // namespace
+
+class WebContentsLifecycleControllerBrowserTest : public RadiumBrowserTest {
+ protected:
+  void PreRunTestOnMainThread() override {
+    RadiumBrowserTest::PreRunTestOnMainThread();
+    browser()->profile()->GetPrefs()->SetTimeDelta(
+        prefs::kBackgroundContentsFreezeDelay, base::TimeDelta());
+  }
+
+  // Adds a WebContents showing a WebUI to the browser, and returns it.
+  content::WebContents* AddWebContents() {
+    std::unique_ptr<content::WebContents> web_contents =
+        content::WebContents::Create(
+            content::WebContents::CreateParams(browser()->profile()));
+    EXPECT_TRUE(content::NavigateToURL(web_contents.get(), url()));
+    EXPECT_TRUE(content::ExecJs(web_contents.get(), kRecordFreezeScript));
+    content::WebContents* web_contents_ptr = web_contents.get();
+    browser()->AddWebContents(std::move(web_contents));
+    return web_contents_ptr;
+  }
+
+  // Returns the WebContents that replaced a discarded one, if any.
+  content::WebContents* FindDiscardedWebContents() {
+    for (const auto& web_contents : browser()->tabs()) {
+      if (web_contents->WasDiscarded()) {
+        return web_contents.get();
+      }
+    }
+    return nullptr;
+  }
+
+  void SimulateMemoryPressure() {
+    base::MemoryPressureListener::SimulatePressureNotification(
+        base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+    base::RunLoop().RunUntilIdle();
+  }
+
+  GURL url() const { return GURL(radium::kRadiumUIExampleURL); }
+
+  base::HistogramTester histogram_tester_;
+};
+
+IN_PROC_BROWSER_TEST_F(WebContentsLifecycleControllerBrowserTest,
+                       FreezesHiddenContentsUntilShown) {
+  content::WebContents* web_contents = AddWebContents();
+  web_contents->WasHidden();
+  base::RunLoop().RunUntilIdle();
+
+  web_contents->WasShown();
+  histogram_tester_.ExpectTotalCount(
+      "Radium.WebContentsLifecycle.FrozenDuration", 1);
+  EXPECT_EQ(true, content::EvalJs(web_contents, "window.wasFrozen"));
+}
+
+IN_PROC_BROWSER_TEST_F(WebContentsLifecycleControllerBrowserTest,
+                       DiscardsHiddenContentsUnderPressure) {
+  base::WeakPtr<content::WebContents> web_contents =
+      AddWebContents()->GetWeakPtr();
+  web_contents->WasHidden();
+  SimulateMemoryPressure();
+  EXPECT_FALSE(web_contents);
+
+  content::WebContents* discarded = FindDiscardedWebContents();
+  ASSERT_TRUE(discarded);
+  EXPECT_FALSE(discarded->GetPrimaryMainFrame()->IsRenderFrameLive());
+  EXPECT_EQ(url(), discarded->GetLastCommittedURL());
+
+  // A discarded WebContents has no renderer to free, so further pressure
+  // leaves it alone.
+  base::WeakPtr<content::WebContents> discarded_weak_ptr =
+      discarded->GetWeakPtr();
+  SimulateMemoryPressure();
+  EXPECT_TRUE(discarded_weak_ptr);
+}
+
+// A discarded WebContents reloads when it is shown, and is frozen and
+// discarded like any other once it is hidden again.
+IN_PROC_BROWSER_TEST_F(WebContentsLifecycleControllerBrowserTest,
+                       ReloadsDiscardedContentsWhenShown) {
+  AddWebContents()->WasHidden();
+  SimulateMemoryPressure();
+  content::WebContents* discarded = FindDiscardedWebContents();
+  ASSERT_TRUE(discarded);
+
+  discarded->WasShown();
+  EXPECT_TRUE(content::WaitForLoadStop(discarded));
+  EXPECT_TRUE(discarded->GetPrimaryMainFrame()->IsRenderFrameLive());
+  EXPECT_EQ(url(), discarded->GetLastCommittedURL());
+  EXPECT_TRUE(content::ExecJs(discarded, kRecordFreezeScript));
+
+  discarded->WasHidden();
+  base::RunLoop().RunUntilIdle();
+  discarded->WasShown();
+  EXPECT_EQ(true, content::EvalJs(discarded, "window.wasFrozen"));
+
+  base::WeakPtr<content::WebContents> reloaded = discarded->GetWeakPtr();
+  discarded->WasHidden();
+  SimulateMemoryPressure();
+  EXPECT_FALSE(reloaded);
+}
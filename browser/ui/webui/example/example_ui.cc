@@ -4,20 +4,33 @@
 
 #include "radium/browser/ui/webui/example/example_ui.h"
 
-#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_ui.h"
 #include "content/public/browser/web_ui_data_source.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/webui/webui_data_source_registry.h"
 #include "radium/browser/ui/webui/webui_util.h"
 #include "radium/common/webui_url_constants.h"
+#include "radium/grit/example_code_cache_resources_map.h"
 #include "radium/grit/example_resources.h"
 #include "radium/grit/example_resources_map.h"
 
-ExampleUI::ExampleUI(content::WebUI* web_ui) : ui::MojoWebUIController(web_ui) {
+namespace {
+
+void CreateAndAddExampleUIHtmlSource(Profile* profile) {
   content::WebUIDataSource* source = content::WebUIDataSource::CreateAndAdd(
-      web_ui->GetWebContents()->GetBrowserContext(),
-      radium::kRadiumUIExampleHost);
+      profile, radium::kRadiumUIExampleHost);
 
   radium::webui::SetupWebUIDataSource(source, kExampleResources,
                                       IDR_EXAMPLE_EXAMPLE_HTML);
+  radium::webui::AddCodeCacheResources(source, kExampleCodeCacheResources);
+}
+
+}  // namespace
+
+ExampleUI::ExampleUI(content::WebUI* web_ui) : ui::MojoWebUIController(web_ui) {
+  WebUIDataSourceRegistry::EnsureDataSourcesForProfile(
+      Profile::FromWebUI(web_ui), radium::kRadiumUIExampleHost,
+      &CreateAndAddExampleUIHtmlSource);
 }
 
 ExampleUI::~ExampleUI() = default;
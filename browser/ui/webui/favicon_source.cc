@@ -6,15 +6,26 @@
 
 #include <cmath>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/barrier_callback.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram_functions.h"
+#include "base/numerics/byte_conversions.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "components/favicon/core/history_ui_favicon_request_handler.h"
 #include "components/favicon_base/favicon_url_parser.h"
 #include "components/history/core/browser/top_sites.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/web_contents.h"
+#include "net/base/url_util.h"
 #include "radium/browser/favicon/favicon_service_factory.h"
 #include "radium/browser/profiles/profile.h"
 #include "radium/browser/themes/theme_service.h"
@@ -26,7 +37,6 @@
 #include "ui/base/resource/resource_scale_factor.h"
 #include "ui/base/webui/web_ui_util.h"
 #include "ui/gfx/codec/png_codec.h"
-#include "ui/native_theme/native_theme.h"
 #include "ui/resources/grit/ui_resources.h"
 #include "url/gurl.h"
 
@@ -35,6 +45,17 @@ namespace {
 // Generous cap to guard against out-of-memory issues.
 constexpr int kMaxDesiredSizeInPixel = 2048;
 
+// Path of the batch endpoint, e.g.
+// radium://favicon2/batch?size=16&scaleFactor=2x&pageUrl=a&pageUrl=b.
+constexpr char kBatchPath[] = "/batch";
+
+// Upper bound of the icons served by a single batch request.
+constexpr size_t kMaxBatchSize = 1000;
+
+// The favicon2 query parameters that select an icon.
+constexpr char kPageUrlParam[] = "pageUrl";
+constexpr char kIconUrlParam[] = "iconUrl";
+
 // web_contents->GetLastCommittedURL in general will not necessarily yield the
 // original URL that started the request, but we're only interested in verifying
 // if it was issued by a history page, for whom this is the case. If it is not
@@ -66,7 +87,7 @@ FaviconSource::FaviconSource(Profile* profile,
                              chrome::FaviconUrlFormat url_format)
     : profile_(profile->GetOriginalProfile()), url_format_(url_format) {}
 
-FaviconSource::~FaviconSource() {}
+FaviconSource::~FaviconSource() = default;
 
 std::string FaviconSource::GetSource() {
   switch (url_format_) {
@@ -87,6 +108,11 @@ void FaviconSource::StartDataRequest(
   favicon::FaviconService* favicon_service = nullptr;
   // FaviconServiceFactory::GetForProfile(profile_,
   //                                      ServiceAccessType::EXPLICIT_ACCESS);
+  if (IsBatchRequest(url)) {
+    StartBatchRequest(url, favicon_service, wc_getter, std::move(callback));
+    return;
+  }
+
   if (!favicon_service) {
     SendDefaultResponse(std::move(callback), wc_getter);
     return;
@@ -99,6 +125,14 @@ void FaviconSource::StartDataRequest(
     return;
   }
 
+  RequestIcon(parsed, favicon_service, wc_getter, std::move(callback));
+}
+
+void FaviconSource::RequestIcon(
+    const chrome::ParsedFaviconPath& parsed,
+    favicon::FaviconService* favicon_service,
+    const content::WebContents::Getter& wc_getter,
+    content::URLDataSource::GotDataCallback callback) {
   GURL page_url(parsed.page_url);
   GURL icon_url(parsed.icon_url);
   if (!page_url.is_valid() && !icon_url.is_valid()) {
@@ -117,6 +151,11 @@ void FaviconSource::StartDataRequest(
     return;
   }
 
+  if (!favicon_service) {
+    SendDefaultResponse(std::move(callback), parsed, wc_getter);
+    return;
+  }
+
   if (parsed.page_url.empty()) {
     // Request by icon url.
 
@@ -179,7 +218,105 @@ void FaviconSource::StartDataRequest(
   }
 }
 
-std::string FaviconSource::GetMimeType(const GURL&) {
+void FaviconSource::StartBatchRequest(
+    const GURL& url,
+    favicon::FaviconService* favicon_service,
+    const content::WebContents::Getter& wc_getter,
+    content::URLDataSource::GotDataCallback callback) {
+  // Split the query into the parameters shared by all icons and the list of
+  // page/icon URLs. The values are kept escaped so every icon can be parsed
+  // exactly like a single favicon2 request.
+  std::vector<std::string> shared_params;
+  std::vector<std::string> url_params;
+  for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
+    std::string param = base::StrCat({it.GetKey(), "=", it.GetValue()});
+    if (it.GetKey() == kPageUrlParam || it.GetKey() == kIconUrlParam) {
+      url_params.push_back(std::move(param));
+    } else {
+      shared_params.push_back(std::move(param));
+    }
+  }
+
+  if (url_params.empty() || url_params.size() > kMaxBatchSize) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+
+  base::UmaHistogramCounts1000("Radium.FaviconSource.Batch.Size",
+                               url_params.size());
+
+  const std::string shared_query = base::JoinString(shared_params, "&");
+  auto on_icon = base::BarrierCallback<BatchEntry>(
+      url_params.size(),
+      base::BindOnce(&FaviconSource::OnBatchRequestDone,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+  for (size_t i = 0; i < url_params.size(); ++i) {
+    content::URLDataSource::GotDataCallback icon_callback = base::BindOnce(
+        [](size_t index, base::RepeatingCallback<void(BatchEntry)> on_icon,
+           scoped_refptr<base::RefCountedMemory> bytes) {
+          on_icon.Run(BatchEntry(index, std::move(bytes)));
+        },
+        i, on_icon);
+
+    chrome::ParsedFaviconPath parsed;
+    const std::string path =
+        shared_query.empty()
+            ? base::StrCat({"?", url_params[i]})
+            : base::StrCat({"?", shared_query, "&", url_params[i]});
+    if (!chrome::ParseFaviconPath(path, url_format_, &parsed)) {
+      SendDefaultResponse(std::move(icon_callback), wc_getter);
+      continue;
+    }
+    RequestIcon(parsed, favicon_service, wc_getter, std::move(icon_callback));
+  }
+}
+
+void FaviconSource::OnBatchRequestDone(
+    content::URLDataSource::GotDataCallback callback,
+    std::vector<BatchEntry> entries) {
+  // Entries arrive in completion order.
+  std::ranges::sort(entries, {}, &BatchEntry::first);
+
+  size_t payload_size = 0;
+  for (const BatchEntry& entry : entries) {
+    payload_size += entry.second ? entry.second->size() : 0;
+  }
+
+  std::vector<uint8_t> data;
+  data.reserve(sizeof(uint32_t) * (1 + 2 * entries.size()) + payload_size);
+  auto append_u32 = [&data](size_t value) {
+    auto bytes = base::U32ToLittleEndian(base::checked_cast<uint32_t>(value));
+    data.insert(data.end(), bytes.begin(), bytes.end());
+  };
+
+  append_u32(entries.size());
+  size_t offset = 0;
+  for (const BatchEntry& entry : entries) {
+    const size_t length = entry.second ? entry.second->size() : 0;
+    append_u32(offset);
+    append_u32(length);
+    offset += length;
+  }
+  for (const BatchEntry& entry : entries) {
+    if (entry.second) {
+      data.insert(data.end(), entry.second->begin(), entry.second->end());
+    }
+  }
+
+  std::move(callback).Run(
+      base::MakeRefCounted<base::RefCountedBytes>(std::move(data)));
+}
+
+bool FaviconSource::IsBatchRequest(const GURL& url) const {
+  // The legacy format has no query parameters to batch.
+  return url_format_ == chrome::FaviconUrlFormat::kFavicon2 &&
+         url.path_piece() == kBatchPath;
+}
+
+std::string FaviconSource::GetMimeType(const GURL& url) {
+  if (IsBatchRequest(url)) {
+    return "application/octet-stream";
+  }
   // We need to explicitly return a mime type, otherwise if the user tries to
   // drag the image they get no extension.
   return "image/png";
@@ -212,13 +349,9 @@ void FaviconSource::SendDefaultResponse(
     content::URLDataSource::GotDataCallback callback,
     const chrome::ParsedFaviconPath& parsed,
     const content::WebContents::Getter& wc_getter) {
-  SendDefaultResponse(
-      std::move(callback), parsed.size_in_dip, parsed.device_scale_factor,
-      parsed.force_light_mode
-          ? false
-          : webui::ShouldUseDarkMode(
-                ThemeServiceFactory::GetForProfile(Profile::FromBrowserContext(
-                    wc_getter.Run()->GetBrowserContext()))));
+  SendDefaultResponse(std::move(callback), parsed.size_in_dip,
+                      parsed.device_scale_factor,
+                      ShouldUseDarkMode(parsed.force_light_mode));
   // if (!parsed.show_fallback_monogram) {
   //   return;
   // }
@@ -237,13 +370,8 @@ void FaviconSource::SendDefaultResponse(
     content::URLDataSource::GotDataCallback callback,
     const content::WebContents::Getter& wc_getter,
     bool force_light_mode) {
-  SendDefaultResponse(
-      std::move(callback), 16, 1.0f,
-      force_light_mode
-          ? false
-          : webui::ShouldUseDarkMode(
-                ThemeServiceFactory::GetForProfile(Profile::FromBrowserContext(
-                    wc_getter.Run()->GetBrowserContext()))));
+  SendDefaultResponse(std::move(callback), 16, 1.0f,
+                      ShouldUseDarkMode(force_light_mode));
 }
 
 void FaviconSource::SendDefaultResponse(
@@ -265,7 +393,25 @@ void FaviconSource::SendDefaultResponse(
       resource_id = dark_mode ? IDR_DEFAULT_FAVICON_DARK : IDR_DEFAULT_FAVICON;
       break;
   }
-  std::move(callback).Run(LoadIconBytes(scale_factor, resource_id));
+  std::move(callback).Run(GetDefaultIconBytes(scale_factor, resource_id));
+}
+
+bool FaviconSource::ShouldUseDarkMode(bool force_light_mode) const {
+  return !force_light_mode &&
+         webui::ShouldUseDarkMode(ThemeServiceFactory::GetForProfile(profile_));
+}
+
+scoped_refptr<base::RefCountedMemory> FaviconSource::GetDefaultIconBytes(
+    float scale_factor,
+    int resource_id) {
+  auto key = std::make_pair(resource_id,
+                            ui::GetSupportedResourceScaleFactor(scale_factor));
+  auto it = default_icons_.find(key);
+  if (it == default_icons_.end()) {
+    it = default_icons_.emplace(key, LoadIconBytes(scale_factor, resource_id))
+             .first;
+  }
+  return it->second;
 }
 
 base::RefCountedMemory* FaviconSource::LoadIconBytes(float scale_factor,
@@ -7,6 +7,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
@@ -14,6 +16,7 @@
 #include "base/task/cancelable_task_tracker.h"
 #include "components/favicon/core/favicon_service.h"
 #include "content/public/browser/url_data_source.h"
+#include "ui/base/resource/resource_scale_factor.h"
 #include "ui/gfx/favicon_size.h"
 
 class Profile;
@@ -27,15 +30,27 @@ enum class FaviconUrlFormat;
 struct ParsedFaviconPath;
 }  // namespace chrome
 
-namespace ui {
-class NativeTheme;
-}
-
 // FaviconSource is the gateway between network-level chrome:
 // requests for favicons and the history backend that serves these.
 // Two possible formats are allowed: chrome://favicon, kept only for backwards
 // compatibility for extensions, and chrome://favicon2. Formats are described in
 // favicon_url_parser.h.
+//
+// favicon2 additionally serves many icons in one request through
+// radium://favicon2/batch. The query takes the usual favicon2 parameters plus
+// any number of pageUrl or iconUrl parameters, e.g.
+//   radium://favicon2/batch?size=16&scaleFactor=2x&pageUrl=a&pageUrl=b
+// The response is a little-endian binary container:
+//   uint32 count
+//   count x { uint32 offset, uint32 length }  // Relative to the payload.
+//   payload                                    // Concatenated PNGs.
+// Icons are listed in request order. Failed lookups carry the default icon.
+// Each icon is still looked up on its own; the batch saves the renderer one
+// request per icon, and the response is sent once all lookups are done.
+//
+// Radium has no history backend, so every request is answered with a default
+// icon. The default icons are loaded once per resource id and scale, and kept
+// for the lifetime of the source.
 class FaviconSource : public content::URLDataSource {
  public:
   // |type| is the type of icon this FaviconSource will provide.
@@ -52,7 +67,7 @@ class FaviconSource : public content::URLDataSource {
       const GURL& url,
       const content::WebContents::Getter& wc_getter,
       content::URLDataSource::GotDataCallback callback) override;
-  std::string GetMimeType(const GURL&) override;
+  std::string GetMimeType(const GURL& url) override;
   bool AllowCaching() override;
   bool ShouldReplaceExistingSource() override;
 
@@ -66,6 +81,36 @@ class FaviconSource : public content::URLDataSource {
   // Defines the allowed pixel sizes for requested favicons.
   enum IconSize { SIZE_16, SIZE_32, SIZE_64, NUM_SIZES };
 
+  // Returns whether a request should be served with dark icons. Follows the
+  // native theme at the time of the request.
+  bool ShouldUseDarkMode(bool force_light_mode) const;
+
+  // Returns the pinned bytes of a default icon.
+  scoped_refptr<base::RefCountedMemory> GetDefaultIconBytes(float scale_factor,
+                                                            int resource_id);
+
+  // The index of an icon in a batch request and its bytes.
+  using BatchEntry = std::pair<size_t, scoped_refptr<base::RefCountedMemory>>;
+
+  // Looks up the icon described by |parsed| in |favicon_service|, and falls
+  // back to the default icon.
+  void RequestIcon(const chrome::ParsedFaviconPath& parsed,
+                   favicon::FaviconService* favicon_service,
+                   const content::WebContents::Getter& wc_getter,
+                   content::URLDataSource::GotDataCallback callback);
+
+  // Returns whether |url| is a radium://favicon2/batch request.
+  bool IsBatchRequest(const GURL& url) const;
+
+  // Serves a radium://favicon2/batch request. Every icon is requested like a
+  // single favicon2 request, and the response is sent once all are done.
+  void StartBatchRequest(const GURL& url,
+                         favicon::FaviconService* favicon_service,
+                         const content::WebContents::Getter& wc_getter,
+                         content::URLDataSource::GotDataCallback callback);
+  void OnBatchRequestDone(content::URLDataSource::GotDataCallback callback,
+                          std::vector<BatchEntry> entries);
+
   // Called when favicon data is available from the history backend. If
   // |bitmap_result| is valid, returns it to caller using |callback|. Otherwise
   // will send appropriate default icon for |size_in_dip| and |scale_factor|.
@@ -93,6 +138,11 @@ class FaviconSource : public content::URLDataSource {
 
   chrome::FaviconUrlFormat url_format_;
 
+  // Default icons keyed by resource id and scale. Never evicted.
+  std::map<std::pair<int, ui::ResourceScaleFactor>,
+           scoped_refptr<base::RefCountedMemory>>
+      default_icons_;
+
   base::CancelableTaskTracker cancelable_task_tracker_;
 
   base::WeakPtrFactory<FaviconSource> weak_ptr_factory_{this};
@@ -0,0 +1,165 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/favicon_source.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/test/test_future.h"
+#include "components/favicon_base/favicon_url_parser.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/native_theme/native_theme.h"
+#include "ui/resources/grit/ui_resources.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kIconUrl[] =
+    "radium://favicon2/?size=16&scaleFactor=1x&pageUrl=https%3A%2F%2Fa.test";
+
+// Splits a radium://favicon2/batch response into its icons.
+std::vector<std::string> DecodeBatch(const base::RefCountedMemory& response) {
+  const std::string data(response.begin(), response.end());
+  auto read_u32 = [&data](size_t pos) {
+    uint32_t value = 0;
+    for (size_t i = 4; i > 0; --i) {
+      value = (value << 8) | static_cast<uint8_t>(data[pos + i - 1]);
+    }
+    return value;
+  };
+
+  const uint32_t count = read_u32(0);
+  const size_t payload_start = 4 + 8 * count;
+  std::vector<std::string> icons;
+  for (uint32_t i = 0; i < count; ++i) {
+    icons.push_back(data.substr(payload_start + read_u32(4 + 8 * i),
+                                read_u32(8 + 8 * i)));
+  }
+  return icons;
+}
+
+std::string ToString(const base::RefCountedMemory& bytes) {
+  return std::string(bytes.begin(), bytes.end());
+}
+
+// Serves a distinct byte string for every resource and counts the loads.
+class TestFaviconSource : public FaviconSource {
+ public:
+  explicit TestFaviconSource(Profile* profile,
+                             chrome::FaviconUrlFormat format =
+                                 chrome::FaviconUrlFormat::kFavicon2)
+      : FaviconSource(profile, format) {}
+
+  int load_count() const { return load_count_; }
+
+  scoped_refptr<base::RefCountedMemory> GetBytes(int resource_id) {
+    auto& bytes = icons_[resource_id];
+    if (!bytes) {
+      bytes = base::MakeRefCounted<base::RefCountedString>(
+          "icon " + std::to_string(resource_id));
+    }
+    return bytes;
+  }
+
+ protected:
+  // FaviconSource:
+  base::RefCountedMemory* LoadIconBytes(float scale_factor,
+                                        int resource_id) override {
+    ++load_count_;
+    return GetBytes(resource_id).get();
+  }
+
+ private:
+  int load_count_ = 0;
+  std::map<int, scoped_refptr<base::RefCountedMemory>> icons_;
+};
+
+}  // namespace
+
+class FaviconSourceBrowserTest : public RadiumBrowserTest {
+ protected:
+  void SetUpOnMainThread() override {
+    source_ = std::make_unique<TestFaviconSource>(browser()->profile());
+  }
+
+  void TearDownOnMainThread() override { source_.reset(); }
+
+  scoped_refptr<base::RefCountedMemory> Request(const std::string& url) {
+    base::test::TestFuture<scoped_refptr<base::RefCountedMemory>> future;
+    source_->StartDataRequest(
+        GURL(url),
+        base::BindRepeating([]() -> content::WebContents* { return nullptr; }),
+        future.GetCallback());
+    return future.Take();
+  }
+
+  std::unique_ptr<TestFaviconSource> source_;
+};
+
+IN_PROC_BROWSER_TEST_F(FaviconSourceBrowserTest, LoadsDefaultIconOnce) {
+  ui::NativeTheme::GetInstanceForNativeUi()->set_use_dark_colors(false);
+  const scoped_refptr<base::RefCountedMemory> expected =
+      source_->GetBytes(IDR_DEFAULT_FAVICON);
+
+  EXPECT_EQ(expected, Request(kIconUrl));
+  EXPECT_EQ(expected, Request(kIconUrl));
+  EXPECT_EQ(1, source_->load_count());
+}
+
+// The theme is read for every request, not when the source is created.
+IN_PROC_BROWSER_TEST_F(FaviconSourceBrowserTest, FollowsNativeTheme) {
+  ui::NativeTheme* native_theme = ui::NativeTheme::GetInstanceForNativeUi();
+  native_theme->set_use_dark_colors(false);
+  EXPECT_EQ(source_->GetBytes(IDR_DEFAULT_FAVICON), Request(kIconUrl));
+
+  native_theme->set_use_dark_colors(true);
+  EXPECT_EQ(source_->GetBytes(IDR_DEFAULT_FAVICON_DARK), Request(kIconUrl));
+
+  native_theme->set_use_dark_colors(false);
+  EXPECT_EQ(source_->GetBytes(IDR_DEFAULT_FAVICON), Request(kIconUrl));
+  EXPECT_EQ(2, source_->load_count());
+}
+
+// Icons come back in request order, whatever order their lookups finish in.
+IN_PROC_BROWSER_TEST_F(FaviconSourceBrowserTest, ServesBatch) {
+  ui::NativeTheme::GetInstanceForNativeUi()->set_use_dark_colors(false);
+  const GURL url(
+      "radium://favicon2/batch?size=32&scaleFactor=1x"
+      "&pageUrl=https%3A%2F%2Fa.test&iconUrl=https%3A%2F%2Fb.test%2Ficon.png"
+      "&pageUrl=https%3A%2F%2Fc.test");
+  EXPECT_EQ("application/octet-stream", source_->GetMimeType(url));
+
+  scoped_refptr<base::RefCountedMemory> response = Request(url.spec());
+  ASSERT_TRUE(response);
+  const std::string icon = ToString(*source_->GetBytes(IDR_DEFAULT_FAVICON_32));
+  EXPECT_EQ(std::vector<std::string>(3, icon), DecodeBatch(*response));
+  EXPECT_EQ(1, source_->load_count());
+}
+
+IN_PROC_BROWSER_TEST_F(FaviconSourceBrowserTest, RejectsBatchWithoutURLs) {
+  EXPECT_FALSE(Request("radium://favicon2/batch?size=16&scaleFactor=1x"));
+}
+
+// Only favicon2 has the query parameters that a batch is made of.
+IN_PROC_BROWSER_TEST_F(FaviconSourceBrowserTest, LegacyFormatHasNoBatch) {
+  ui::NativeTheme::GetInstanceForNativeUi()->set_use_dark_colors(false);
+  source_ = std::make_unique<TestFaviconSource>(
+      browser()->profile(), chrome::FaviconUrlFormat::kFaviconLegacy);
+  const GURL url("radium://favicon/batch");
+  EXPECT_EQ("image/png", source_->GetMimeType(url));
+  EXPECT_EQ(source_->GetBytes(IDR_DEFAULT_FAVICON), Request(url.spec()));
+}
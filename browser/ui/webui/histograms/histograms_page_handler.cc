@@ -0,0 +1,264 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/histograms/histograms_page_handler.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/string_util.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "content/public/browser/histogram_fetcher.h"
+
+namespace {
+
+// How long to wait for child processes to send their histograms.
+constexpr base::TimeDelta kChildHistogramsTimeout = base::Seconds(1);
+constexpr base::TimeDelta kMonitoringInterval = base::Seconds(1);
+// Stands for the current histograms in GetDelta().
+constexpr int32_t kCurrentSnapshotId = -1;
+
+histograms::mojom::HistogramPtr GetHistogramData(
+    const std::string& name,
+    const base::HistogramSamples& samples) {
+  auto data = histograms::mojom::Histogram::New();
+  data->name = name;
+  data->count = samples.TotalCount();
+  data->sum = samples.sum();
+  for (std::unique_ptr<base::SampleCountIterator> it = samples.Iterator();
+       !it->Done(); it->Next()) {
+    base::HistogramBase::Sample min;
+    int64_t max;
+    base::HistogramBase::Count count;
+    it->Get(&min, &max, &count);
+    data->buckets.push_back(histograms::mojom::Bucket::New(min, max, count));
+  }
+  return data;
+}
+
+histograms::mojom::HistogramPtr GetHistogramData(
+    const base::HistogramBase& histogram) {
+  return GetHistogramData(histogram.histogram_name(),
+                          *histogram.SnapshotSamples());
+}
+
+base::StatisticsRecorder::Histograms GetHistogramsMatching(
+    const std::string& query) {
+  return base::StatisticsRecorder::Sort(base::StatisticsRecorder::WithName(
+      base::StatisticsRecorder::GetHistograms(), query,
+      /*case_sensitive=*/false));
+}
+
+// Returns the samples in |to| that are not in |from|, or null if there are
+// none. Both have their buckets ordered by min, and |from| may be null.
+histograms::mojom::HistogramPtr ComputeDelta(
+    const histograms::mojom::Histogram* from,
+    const histograms::mojom::Histogram& to) {
+  if (from && from->count == to.count && from->sum == to.sum) {
+    return nullptr;
+  }
+
+  auto delta = histograms::mojom::Histogram::New();
+  delta->name = to.name;
+  delta->count = to.count - (from ? from->count : 0);
+  delta->sum = to.sum - (from ? from->sum : 0);
+  size_t from_index = 0;
+  for (const histograms::mojom::BucketPtr& bucket : to.buckets) {
+    int64_t count = bucket->count;
+    if (from) {
+      while (from_index < from->buckets.size() &&
+             from->buckets[from_index]->min < bucket->min) {
+        ++from_index;
+      }
+      if (from_index < from->buckets.size() &&
+          from->buckets[from_index]->min == bucket->min) {
+        count -= from->buckets[from_index]->count;
+      }
+    }
+    if (count != 0) {
+      delta->buckets.push_back(
+          histograms::mojom::Bucket::New(bucket->min, bucket->max, count));
+    }
+  }
+  return delta;
+}
+
+}  // namespace
+
+HistogramsPageHandler::HistogramsPageHandler(
+    mojo::PendingReceiver<histograms::mojom::PageHandler> receiver,
+    mojo::PendingRemote<histograms::mojom::Page> page)
+    : receiver_(this, std::move(receiver)), page_(std::move(page)) {}
+
+HistogramsPageHandler::~HistogramsPageHandler() = default;
+
+void HistogramsPageHandler::GetHistograms(const std::string& query,
+                                          GetHistogramsCallback callback) {
+  FetchChildHistograms(base::BindOnce(
+      &HistogramsPageHandler::OnGetHistogramsFetched,
+      weak_ptr_factory_.GetWeakPtr(), query, std::move(callback)));
+}
+
+void HistogramsPageHandler::TakeSnapshot(TakeSnapshotCallback callback) {
+  FetchChildHistograms(
+      base::BindOnce(&HistogramsPageHandler::OnTakeSnapshotFetched,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void HistogramsPageHandler::GetDelta(int32_t from_id,
+                                     int32_t to_id,
+                                     const std::string& query,
+                                     GetDeltaCallback callback) {
+  if (!snapshots_.contains(from_id) ||
+      (to_id != kCurrentSnapshotId && !snapshots_.contains(to_id))) {
+    std::move(callback).Run(std::nullopt);
+    return;
+  }
+  if (to_id != kCurrentSnapshotId) {
+    OnGetDeltaFetched(from_id, to_id, query, std::move(callback));
+    return;
+  }
+  FetchChildHistograms(base::BindOnce(
+      &HistogramsPageHandler::OnGetDeltaFetched, weak_ptr_factory_.GetWeakPtr(),
+      from_id, to_id, query, std::move(callback)));
+}
+
+void HistogramsPageHandler::StartMonitoring(const std::string& query) {
+  monitoring_query_ = query;
+  // The first update sends all the histograms that match.
+  monitored_totals_.clear();
+  monitoring_timer_.Start(
+      FROM_HERE, kMonitoringInterval,
+      base::BindRepeating(&HistogramsPageHandler::UpdateMonitoredHistograms,
+                          base::Unretained(this)));
+  UpdateMonitoredHistograms();
+}
+
+void HistogramsPageHandler::StopMonitoring() {
+  monitoring_timer_.Stop();
+  monitored_totals_.clear();
+}
+
+void HistogramsPageHandler::FetchChildHistograms(base::OnceClosure callback) {
+  // Child processes with a persistent allocator share their histograms
+  // through memory, the others send them over IPC.
+  base::StatisticsRecorder::ImportProvidedHistogramsSync();
+  content::FetchHistogramsAsynchronously(
+      base::SequencedTaskRunner::GetCurrentDefault(), std::move(callback),
+      kChildHistogramsTimeout);
+}
+
+void HistogramsPageHandler::OnGetHistogramsFetched(
+    const std::string& query,
+    GetHistogramsCallback callback) {
+  std::vector<histograms::mojom::HistogramPtr> result;
+  for (const base::HistogramBase* histogram : GetHistogramsMatching(query)) {
+    result.push_back(GetHistogramData(*histogram));
+  }
+  std::move(callback).Run(std::move(result));
+}
+
+void HistogramsPageHandler::OnTakeSnapshotFetched(
+    TakeSnapshotCallback callback) {
+  Snapshot snapshot;
+  for (const base::HistogramBase* histogram : GetHistogramsMatching("")) {
+    snapshot.emplace(histogram->histogram_name(), GetHistogramData(*histogram));
+  }
+
+  const int32_t id = next_snapshot_id_++;
+  snapshots_.emplace(id, std::move(snapshot));
+  if (snapshots_.size() > kMaxSnapshots) {
+    snapshots_.erase(snapshots_.begin());
+  }
+  std::move(callback).Run(id);
+}
+
+void HistogramsPageHandler::OnGetDeltaFetched(int32_t from_id,
+                                              int32_t to_id,
+                                              const std::string& query,
+                                              GetDeltaCallback callback) {
+  // The snapshots may have been dropped while child histograms were fetched.
+  auto from_it = snapshots_.find(from_id);
+  if (from_it == snapshots_.end()) {
+    std::move(callback).Run(std::nullopt);
+    return;
+  }
+  const Snapshot& from = from_it->second;
+
+  Snapshot current;
+  if (to_id == kCurrentSnapshotId) {
+    for (const base::HistogramBase* histogram : GetHistogramsMatching(query)) {
+      current.emplace(histogram->histogram_name(),
+                      GetHistogramData(*histogram));
+    }
+  }
+  auto to_it = snapshots_.find(to_id);
+  if (to_id != kCurrentSnapshotId && to_it == snapshots_.end()) {
+    std::move(callback).Run(std::nullopt);
+    return;
+  }
+  const Snapshot& to = to_id == kCurrentSnapshotId ? current : to_it->second;
+
+  const std::string lower_query = base::ToLowerASCII(query);
+  std::vector<histograms::mojom::HistogramPtr> result;
+  for (const auto& [name, histogram] : to) {
+    if (!lower_query.empty() &&
+        base::ToLowerASCII(name).find(lower_query) == std::string::npos) {
+      continue;
+    }
+    auto from_histogram = from.find(name);
+    histograms::mojom::HistogramPtr delta = ComputeDelta(
+        from_histogram == from.end() ? nullptr : from_histogram->second.get(),
+        *histogram);
+    if (delta) {
+      result.push_back(std::move(delta));
+    }
+  }
+  std::move(callback).Run(std::move(result));
+}
+
+void HistogramsPageHandler::UpdateMonitoredHistograms() {
+  if (monitoring_update_pending_) {
+    return;
+  }
+  monitoring_update_pending_ = true;
+  FetchChildHistograms(
+      base::BindOnce(&HistogramsPageHandler::OnUpdateMonitoredHistogramsFetched,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void HistogramsPageHandler::OnUpdateMonitoredHistogramsFetched() {
+  monitoring_update_pending_ = false;
+  if (!monitoring_timer_.IsRunning()) {
+    return;
+  }
+
+  // Every histogram is snapshotted, but only the ones that changed are
+  // serialized and sent.
+  std::vector<histograms::mojom::HistogramPtr> changed;
+  for (const base::HistogramBase* histogram :
+       GetHistogramsMatching(monitoring_query_)) {
+    std::unique_ptr<base::HistogramSamples> samples =
+        histogram->SnapshotSamples();
+    std::pair<int64_t, int64_t> totals(samples->TotalCount(), samples->sum());
+    auto [it, inserted] =
+        monitored_totals_.try_emplace(histogram->histogram_name(), totals);
+    if (!inserted) {
+      if (it->second == totals) {
+        continue;
+      }
+      it->second = totals;
+    }
+    changed.push_back(GetHistogramData(histogram->histogram_name(), *samples));
+  }
+  if (!changed.empty()) {
+    page_->OnHistogramsChanged(std::move(changed));
+  }
+}
@@ -0,0 +1,92 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_HISTOGRAMS_HISTOGRAMS_PAGE_HANDLER_H_
+#define RADIUM_BROWSER_UI_WEBUI_HISTOGRAMS_HISTOGRAMS_PAGE_HANDLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/functional/callback_forward.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "radium/browser/ui/webui/histograms/histograms.mojom.h"
+
+// Serves the histograms of the browser and its child processes to the
+// radium://histograms page.
+class HistogramsPageHandler : public histograms::mojom::PageHandler {
+ public:
+  // The number of snapshots kept for the page. Taking another one drops the
+  // oldest.
+  static constexpr size_t kMaxSnapshots = 10;
+
+  HistogramsPageHandler(
+      mojo::PendingReceiver<histograms::mojom::PageHandler> receiver,
+      mojo::PendingRemote<histograms::mojom::Page> page);
+  HistogramsPageHandler(const HistogramsPageHandler&) = delete;
+  HistogramsPageHandler& operator=(const HistogramsPageHandler&) = delete;
+
+  ~HistogramsPageHandler() override;
+
+  // histograms::mojom::PageHandler:
+  void GetHistograms(const std::string& query,
+                     GetHistogramsCallback callback) override;
+  void TakeSnapshot(TakeSnapshotCallback callback) override;
+  void GetDelta(int32_t from_id,
+                int32_t to_id,
+                const std::string& query,
+                GetDeltaCallback callback) override;
+  void StartMonitoring(const std::string& query) override;
+  void StopMonitoring() override;
+
+ private:
+  // The histograms at some point in time, by name.
+  using Snapshot =
+      std::map<std::string, histograms::mojom::HistogramPtr, std::less<>>;
+
+  // Merges the histograms of child processes into the browser's, then runs
+  // |callback|.
+  void FetchChildHistograms(base::OnceClosure callback);
+
+  void OnGetHistogramsFetched(const std::string& query,
+                              GetHistogramsCallback callback);
+  void OnTakeSnapshotFetched(TakeSnapshotCallback callback);
+  void OnGetDeltaFetched(int32_t from_id,
+                         int32_t to_id,
+                         const std::string& query,
+                         GetDeltaCallback callback);
+  void UpdateMonitoredHistograms();
+  void OnUpdateMonitoredHistogramsFetched();
+
+  mojo::Receiver<histograms::mojom::PageHandler> receiver_;
+  mojo::Remote<histograms::mojom::Page> page_;
+
+  // The snapshots taken by the page, by id. Only the kMaxSnapshots most
+  // recent ones are kept.
+  std::map<int32_t, Snapshot> snapshots_;
+  int32_t next_snapshot_id_ = 0;
+
+  std::string monitoring_query_;
+  // The sample count and sum of the monitored histograms when they were last
+  // sent to the page, to tell which ones changed.
+  std::map<std::string, std::pair<int64_t, int64_t>, std::less<>>
+      monitored_totals_;
+  base::RepeatingTimer monitoring_timer_;
+  // Set while child histograms are fetched for a monitoring update, so that
+  // slow children do not make updates pile up.
+  bool monitoring_update_pending_ = false;
+
+  base::WeakPtrFactory<HistogramsPageHandler> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_HISTOGRAMS_HISTOGRAMS_PAGE_HANDLER_H_
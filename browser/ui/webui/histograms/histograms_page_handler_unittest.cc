@@ -0,0 +1,189 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/histograms/histograms_page_handler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/test/test_future.h"
+#include "base/time/time.h"
+#include "content/public/test/browser_task_environment.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "radium/browser/ui/webui/histograms/histograms.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Histograms = std::vector<histograms::mojom::HistogramPtr>;
+
+constexpr char kHistogramA[] = "Radium.Test.A";
+constexpr char kHistogramB[] = "Radium.Test.B";
+// Samples of the test histograms are in [0, kExclusiveMax), one bucket each.
+constexpr int kExclusiveMax = 10;
+
+// Collects what the handler pushes to the page.
+class FakePage : public histograms::mojom::Page {
+ public:
+  mojo::PendingRemote<histograms::mojom::Page> BindNewPipeAndPassRemote() {
+    return receiver_.BindNewPipeAndPassRemote();
+  }
+
+  base::test::TestFuture<Histograms>& updates() { return updates_; }
+
+ private:
+  // histograms::mojom::Page:
+  void OnHistogramsChanged(Histograms histograms) override {
+    updates_.SetValue(std::move(histograms));
+  }
+
+  mojo::Receiver<histograms::mojom::Page> receiver_{this};
+  base::test::TestFuture<Histograms> updates_;
+};
+
+std::vector<std::pair<int64_t, int64_t>> GetBuckets(
+    const histograms::mojom::Histogram& histogram) {
+  std::vector<std::pair<int64_t, int64_t>> buckets;
+  for (const histograms::mojom::BucketPtr& bucket : histogram.buckets) {
+    buckets.emplace_back(bucket->min, bucket->count);
+  }
+  return buckets;
+}
+
+}  // namespace
+
+class HistogramsPageHandlerTest : public testing::Test {
+ protected:
+  HistogramsPageHandlerTest()
+      : handler_(remote_.BindNewPipeAndPassReceiver(),
+                 page_.BindNewPipeAndPassRemote()) {}
+
+  int32_t TakeSnapshot() {
+    base::test::TestFuture<int32_t> snapshot_id;
+    remote_->TakeSnapshot(snapshot_id.GetCallback());
+    return snapshot_id.Get();
+  }
+
+  std::optional<Histograms> GetDelta(int32_t from_id,
+                                     int32_t to_id,
+                                     const std::string& query) {
+    base::test::TestFuture<std::optional<Histograms>> histograms;
+    remote_->GetDelta(from_id, to_id, query, histograms.GetCallback());
+    return histograms.Take();
+  }
+
+  content::BrowserTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  // Leaves out the histograms of the rest of the test binary.
+  std::unique_ptr<base::StatisticsRecorder> statistics_recorder_ =
+      base::StatisticsRecorder::CreateTemporaryForTesting();
+  FakePage page_;
+  mojo::Remote<histograms::mojom::PageHandler> remote_;
+  HistogramsPageHandler handler_;
+};
+
+// Buckets are matched by their min, whether or not the other side has them.
+TEST_F(HistogramsPageHandlerTest, DeltaAlignsBuckets) {
+  base::UmaHistogramExactLinear(kHistogramA, 1, kExclusiveMax);
+  base::UmaHistogramExactLinear(kHistogramA, 5, kExclusiveMax);
+  const int32_t snapshot_id = TakeSnapshot();
+
+  base::UmaHistogramExactLinear(kHistogramA, 3, kExclusiveMax);
+  base::UmaHistogramExactLinear(kHistogramA, 5, kExclusiveMax);
+  std::optional<Histograms> delta = GetDelta(snapshot_id, -1, kHistogramA);
+  ASSERT_TRUE(delta);
+  ASSERT_EQ(1u, delta->size());
+  const histograms::mojom::Histogram& histogram = *(*delta)[0];
+  EXPECT_EQ(kHistogramA, histogram.name);
+  EXPECT_EQ(2, histogram.count);
+  EXPECT_EQ(8, histogram.sum);
+  // Bucket 1 has no new samples, bucket 3 is not in the snapshot.
+  EXPECT_EQ((std::vector<std::pair<int64_t, int64_t>>{{3, 1}, {5, 1}}),
+            GetBuckets(histogram));
+}
+
+// A histogram created after the snapshot reports all its samples, and one
+// without new samples is left out.
+TEST_F(HistogramsPageHandlerTest, DeltaWithoutFrom) {
+  base::UmaHistogramExactLinear(kHistogramA, 1, kExclusiveMax);
+  const int32_t snapshot_id = TakeSnapshot();
+
+  base::UmaHistogramExactLinear(kHistogramB, 2, kExclusiveMax);
+  base::UmaHistogramExactLinear(kHistogramB, 2, kExclusiveMax);
+  std::optional<Histograms> delta = GetDelta(snapshot_id, -1, "Radium.Test");
+  ASSERT_TRUE(delta);
+  ASSERT_EQ(1u, delta->size());
+  const histograms::mojom::Histogram& histogram = *(*delta)[0];
+  EXPECT_EQ(kHistogramB, histogram.name);
+  EXPECT_EQ(2, histogram.count);
+  EXPECT_EQ(4, histogram.sum);
+  EXPECT_EQ((std::vector<std::pair<int64_t, int64_t>>{{2, 2}}),
+            GetBuckets(histogram));
+}
+
+TEST_F(HistogramsPageHandlerTest, DeltaBetweenSnapshots) {
+  const int32_t from_id = TakeSnapshot();
+  base::UmaHistogramExactLinear(kHistogramA, 4, kExclusiveMax);
+  const int32_t to_id = TakeSnapshot();
+  base::UmaHistogramExactLinear(kHistogramA, 6, kExclusiveMax);
+
+  std::optional<Histograms> delta = GetDelta(from_id, to_id, "");
+  ASSERT_TRUE(delta);
+  ASSERT_EQ(1u, delta->size());
+  EXPECT_EQ(1, (*delta)[0]->count);
+  EXPECT_EQ(4, (*delta)[0]->sum);
+}
+
+TEST_F(HistogramsPageHandlerTest, DropsOldestSnapshot) {
+  const int32_t first_id = TakeSnapshot();
+  const int32_t second_id = TakeSnapshot();
+  for (size_t i = 2; i < HistogramsPageHandler::kMaxSnapshots; ++i) {
+    TakeSnapshot();
+  }
+  EXPECT_TRUE(GetDelta(first_id, -1, ""));
+
+  TakeSnapshot();
+  EXPECT_FALSE(GetDelta(first_id, -1, ""));
+  EXPECT_TRUE(GetDelta(second_id, -1, ""));
+  EXPECT_FALSE(GetDelta(second_id, first_id, ""));
+}
+
+// The first update sends every match, later ones only what changed.
+TEST_F(HistogramsPageHandlerTest, MonitoringSendsChangedHistograms) {
+  base::UmaHistogramExactLinear(kHistogramA, 1, kExclusiveMax);
+  base::UmaHistogramExactLinear(kHistogramB, 1, kExclusiveMax);
+  remote_->StartMonitoring("Radium.Test");
+
+  Histograms update = page_.updates().Take();
+  ASSERT_EQ(2u, update.size());
+  EXPECT_EQ(kHistogramA, update[0]->name);
+  EXPECT_EQ(kHistogramB, update[1]->name);
+
+  base::UmaHistogramExactLinear(kHistogramB, 7, kExclusiveMax);
+  update = page_.updates().Take();
+  ASSERT_EQ(1u, update.size());
+  EXPECT_EQ(kHistogramB, update[0]->name);
+  EXPECT_EQ(2, update[0]->count);
+  EXPECT_EQ(8, update[0]->sum);
+
+  // Nothing changed, so nothing is sent.
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_FALSE(page_.updates().IsReady());
+
+  remote_->StopMonitoring();
+  base::UmaHistogramExactLinear(kHistogramA, 2, kExclusiveMax);
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_FALSE(page_.updates().IsReady());
+}
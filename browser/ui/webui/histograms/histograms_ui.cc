@@ -0,0 +1,56 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/histograms/histograms_ui.h"
+
+#include <utility>
+
+#include "content/public/browser/web_ui.h"
+#include "content/public/browser/web_ui_data_source.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/webui/histograms/histograms_page_handler.h"
+#include "radium/browser/ui/webui/webui_data_source_registry.h"
+#include "radium/browser/ui/webui/webui_util.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/grit/histograms_code_cache_resources_map.h"
+#include "radium/grit/histograms_resources.h"
+#include "radium/grit/histograms_resources_map.h"
+
+namespace {
+
+void CreateAndAddHistogramsUIHtmlSource(Profile* profile) {
+  content::WebUIDataSource* source = content::WebUIDataSource::CreateAndAdd(
+      profile, radium::kRadiumUIHistogramsHost);
+
+  radium::webui::SetupWebUIDataSource(source, kHistogramsResources,
+                                      IDR_HISTOGRAMS_HISTOGRAMS_HTML);
+  radium::webui::AddCodeCacheResources(source,
+                                       kHistogramsCodeCacheResources);
+}
+
+}  // namespace
+
+HistogramsUI::HistogramsUI(content::WebUI* web_ui)
+    : ui::MojoWebUIController(web_ui) {
+  WebUIDataSourceRegistry::EnsureDataSourcesForProfile(
+      Profile::FromWebUI(web_ui), radium::kRadiumUIHistogramsHost,
+      &CreateAndAddHistogramsUIHtmlSource);
+}
+
+HistogramsUI::~HistogramsUI() = default;
+
+WEB_UI_CONTROLLER_TYPE_IMPL(HistogramsUI)
+
+void HistogramsUI::BindInterface(
+    mojo::PendingReceiver<histograms::mojom::PageHandlerFactory> receiver) {
+  page_factory_receiver_.reset();
+  page_factory_receiver_.Bind(std::move(receiver));
+}
+
+void HistogramsUI::CreatePageHandler(
+    mojo::PendingRemote<histograms::mojom::Page> page,
+    mojo::PendingReceiver<histograms::mojom::PageHandler> receiver) {
+  page_handler_ = std::make_unique<HistogramsPageHandler>(std::move(receiver),
+                                                          std::move(page));
+}
@@ -0,0 +1,62 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_HISTOGRAMS_HISTOGRAMS_UI_H_
+#define RADIUM_BROWSER_UI_WEBUI_HISTOGRAMS_HISTOGRAMS_UI_H_
+
+#include <memory>
+
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "radium/browser/ui/webui/histograms/histograms.mojom.h"
+#include "radium/browser/ui/webui/radium_webui_config.h"
+#include "radium/common/webui_url_constants.h"
+#include "ui/webui/mojo_web_ui_controller.h"
+
+namespace content {
+class WebUI;
+}
+
+class HistogramsPageHandler;
+class HistogramsUI;
+
+class HistogramsUIConfig : public DefaultRadiumWebUIConfig<HistogramsUI> {
+ public:
+  HistogramsUIConfig()
+      : DefaultRadiumWebUIConfig(radium::kRadiumUIScheme,
+                                 radium::kRadiumUIHistogramsHost) {}
+};
+
+// The WebUI controller for radium://histograms, which lists the histograms
+// recorded by the browser and its child processes, and diffs snapshots of
+// them.
+class HistogramsUI : public ui::MojoWebUIController,
+                     public histograms::mojom::PageHandlerFactory {
+ public:
+  explicit HistogramsUI(content::WebUI* web_ui);
+  HistogramsUI(const HistogramsUI&) = delete;
+  HistogramsUI& operator=(const HistogramsUI&) = delete;
+
+  ~HistogramsUI() override;
+
+  void BindInterface(
+      mojo::PendingReceiver<histograms::mojom::PageHandlerFactory> receiver);
+
+  static constexpr std::string GetWebUIName() { return "Histograms"; }
+
+ private:
+  // histograms::mojom::PageHandlerFactory:
+  void CreatePageHandler(
+      mojo::PendingRemote<histograms::mojom::Page> page,
+      mojo::PendingReceiver<histograms::mojom::PageHandler> receiver) override;
+
+  std::unique_ptr<HistogramsPageHandler> page_handler_;
+  mojo::Receiver<histograms::mojom::PageHandlerFactory> page_factory_receiver_{
+      this};
+
+  WEB_UI_CONTROLLER_TYPE_DECL();
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_HISTOGRAMS_HISTOGRAMS_UI_H_
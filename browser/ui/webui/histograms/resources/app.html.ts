@@ -0,0 +1,60 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import {html} from '//resources/lit/v3_0/lit.rollup.js';
+
+import type {HistogramsAppElement} from './app.js';
+
+export function getHtml(this: HistogramsAppElement) {
+  // clang-format off
+  return html`
+<div id="toolbar">
+  <input id="query" type="search" placeholder="Filter histograms"
+      @input="${this.onQueryInput_}">
+  <button @click="${this.onRefreshClick_}">Refresh</button>
+  <label>
+    <input type="checkbox" .checked="${this.monitoring_}"
+        @change="${this.onMonitorChange_}">
+    Monitor
+  </label>
+  <button @click="${this.onSnapshotClick_}">Take snapshot</button>
+  <label>
+    Changes since
+    <select @change="${this.onBaselineChange_}">
+      <option value="-1" ?selected="${this.baselineId_ === -1}">
+        (show all samples)
+      </option>
+      ${this.snapshotIds_.map(id => html`
+        <option value="${id}" ?selected="${this.baselineId_ === id}">
+          Snapshot ${id + 1}
+        </option>`)}
+    </select>
+  </label>
+  <button @click="${this.onExportClick_}">Export JSON</button>
+</div>
+<div id="histograms">
+  ${this.histograms_.map(histogram => html`
+    <details class="histogram">
+      <summary>
+        <span class="name">${histogram.name}</span>
+        <span class="stats">
+          ${histogram.count} samples, mean ${this.getMean_(histogram)}
+        </span>
+      </summary>
+      <table>
+        ${histogram.buckets.map(bucket => html`
+          <tr>
+            <td class="range">${bucket.min} - ${bucket.max}</td>
+            <td class="count">${bucket.count}</td>
+            <td class="bar-cell">
+              <div class="bar" style="width: ${
+                  Number(bucket.count) * 100 /
+                  this.getMaxBucketCount_(histogram)}%"></div>
+            </td>
+          </tr>`)}
+      </table>
+    </details>`)}
+</div>`;
+  // clang-format on
+}
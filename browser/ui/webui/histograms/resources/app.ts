@@ -0,0 +1,180 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import {CrLitElement} from '//resources/lit/v3_0/lit.rollup.js';
+
+import {getCss} from './app.css.js';
+import {getHtml} from './app.html.js';
+import {BrowserProxy} from './browser_proxy.js';
+import type {Histogram} from './histograms.mojom-webui.js';
+
+// Stands for the current histograms in getDelta().
+const CURRENT_SNAPSHOT_ID = -1;
+// Delay before a new filter is applied, so that typing does not send a
+// request per key.
+const QUERY_DEBOUNCE_MS = 300;
+
+// The mojo int64 fields are bigints, which JSON does not support.
+function toJson(histogram: Histogram) {
+  return {
+    name: histogram.name,
+    count: Number(histogram.count),
+    sum: Number(histogram.sum),
+    buckets: histogram.buckets.map(bucket => ({
+                                     min: Number(bucket.min),
+                                     max: Number(bucket.max),
+                                     count: Number(bucket.count),
+                                   })),
+  };
+}
+
+export class HistogramsAppElement extends CrLitElement {
+  static get is() {
+    return 'histograms-app';
+  }
+
+  static override get styles() {
+    return getCss();
+  }
+
+  override render() {
+    return getHtml.bind(this)();
+  }
+
+  static override get properties() {
+    return {
+      histograms_: {type: Array},
+      monitoring_: {type: Boolean},
+      snapshotIds_: {type: Array},
+      baselineId_: {type: Number},
+    };
+  }
+
+  protected histograms_: Histogram[] = [];
+  protected monitoring_: boolean = false;
+  protected snapshotIds_: number[] = [];
+  // The snapshot the histograms are diffed against, or -1 to show them all.
+  protected baselineId_: number = CURRENT_SNAPSHOT_ID;
+
+  private proxy_: BrowserProxy = BrowserProxy.getInstance();
+  private query_: string = '';
+  private queryTimeout_: number|null = null;
+  private listenerId_: number|null = null;
+
+  override connectedCallback() {
+    super.connectedCallback();
+    this.listenerId_ =
+        this.proxy_.callbackRouter.onHistogramsChanged.addListener(
+            this.onHistogramsChanged_.bind(this));
+    this.refresh_();
+  }
+
+  override disconnectedCallback() {
+    super.disconnectedCallback();
+    if (this.listenerId_ !== null) {
+      this.proxy_.callbackRouter.removeListener(this.listenerId_);
+      this.listenerId_ = null;
+    }
+  }
+
+  protected onQueryInput_(e: Event) {
+    this.query_ = (e.target as HTMLInputElement).value;
+    if (this.queryTimeout_ !== null) {
+      clearTimeout(this.queryTimeout_);
+    }
+    this.queryTimeout_ = setTimeout(() => {
+      this.queryTimeout_ = null;
+      if (this.monitoring_) {
+        this.proxy_.handler.startMonitoring(this.query_);
+      }
+      this.refresh_();
+    }, QUERY_DEBOUNCE_MS);
+  }
+
+  protected onRefreshClick_() {
+    this.refresh_();
+  }
+
+  protected onMonitorChange_(e: Event) {
+    this.monitoring_ = (e.target as HTMLInputElement).checked;
+    if (this.monitoring_) {
+      // Updates carry the current samples, not deltas.
+      this.baselineId_ = CURRENT_SNAPSHOT_ID;
+      this.proxy_.handler.startMonitoring(this.query_);
+    } else {
+      this.proxy_.handler.stopMonitoring();
+    }
+  }
+
+  protected async onSnapshotClick_() {
+    const {snapshotId} = await this.proxy_.handler.takeSnapshot();
+    this.snapshotIds_ = [...this.snapshotIds_, snapshotId];
+  }
+
+  protected onBaselineChange_(e: Event) {
+    this.baselineId_ = Number((e.target as HTMLSelectElement).value);
+    if (this.baselineId_ !== CURRENT_SNAPSHOT_ID && this.monitoring_) {
+      this.monitoring_ = false;
+      this.proxy_.handler.stopMonitoring();
+    }
+    this.refresh_();
+  }
+
+  protected onExportClick_() {
+    const json = JSON.stringify(this.histograms_.map(toJson), null, 2);
+    const link = document.createElement('a');
+    link.href =
+        URL.createObjectURL(new Blob([json], {type: 'application/json'}));
+    link.download = 'histograms.json';
+    link.click();
+    URL.revokeObjectURL(link.href);
+  }
+
+  protected getMaxBucketCount_(histogram: Histogram): number {
+    return Math.max(
+        1, ...histogram.buckets.map(bucket => Number(bucket.count)));
+  }
+
+  protected getMean_(histogram: Histogram): string {
+    const count = Number(histogram.count);
+    return count === 0 ? '0' : (Number(histogram.sum) / count).toFixed(1);
+  }
+
+  private async refresh_() {
+    if (this.baselineId_ === CURRENT_SNAPSHOT_ID) {
+      const {histograms} = await this.proxy_.handler.getHistograms(this.query_);
+      this.histograms_ = histograms;
+      return;
+    }
+    const {histograms} = await this.proxy_.handler.getDelta(
+        this.baselineId_, CURRENT_SNAPSHOT_ID, this.query_);
+    this.histograms_ = histograms || [];
+  }
+
+  // Merges the histograms that changed into the list, in place.
+  private onHistogramsChanged_(changed: Histogram[]) {
+    const byName = new Map(this.histograms_.map(
+        (histogram, index) => [histogram.name, index] as [string, number]));
+    const histograms = [...this.histograms_];
+    for (const histogram of changed) {
+      const index = byName.get(histogram.name);
+      if (index === undefined) {
+        histograms.push(histogram);
+      } else {
+        histograms[index] = histogram;
+      }
+    }
+    // Same order as the browser sends them in.
+    histograms.sort((a, b) => a.name < b.name ? -1 : a.name > b.name ? 1 : 0);
+    this.histograms_ = histograms;
+  }
+}
+
+declare global {
+  interface HTMLElementTagNameMap {
+    'histograms-app': HistogramsAppElement;
+  }
+}
+
+customElements.define(HistogramsAppElement.is, HistogramsAppElement);
@@ -6,6 +6,7 @@
 
 #include "build/build_config.h"
 #include "radium/browser/ui/webui/example/example_ui.h"
+#include "radium/browser/ui/webui/histograms/histograms_ui.h"
 #include "radium/browser/ui/webui/radium_webui_config_map.h"
 
 #if !BUILDFLAG(IS_ANDROID)
@@ -15,6 +16,7 @@
 void RegisterRadiumWebUIConfigs() {
   auto& map = RadiumWebUIConfigMap::GetInstance();
   map.AddWebUIConfig(std::make_unique<ExampleUIConfig>());
+  map.AddWebUIConfig(std::make_unique<HistogramsUIConfig>());
 
 #if !BUILDFLAG(IS_ANDROID)
   map.AddWebUIConfig(std::make_unique<WebuiGalleryUIConfig>());
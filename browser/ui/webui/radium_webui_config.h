@@ -44,6 +44,17 @@ class RadiumWebUIConfig : public content::WebUIConfig {
   // * Visibility: Do not assume user visibility upon page load. Observe
   //   `OnVisibilityChanged()` on the WebContents to track visibility.
   virtual bool IsPreloadable(content::BrowserContext* browser_context) = 0;
+
+  // Returns true if a hidden or occluded WebContents showing this WebUI may be
+  // frozen. Return false for WebUIs that must keep running in the background,
+  // e.g. to keep a connection alive.
+  virtual bool CanFreeze(content::BrowserContext* browser_context) = 0;
+
+  // Returns true if a hidden or occluded WebContents showing this WebUI may be
+  // discarded under memory pressure. A discarded WebUI is reloaded from its
+  // URL when shown again, so return false if it holds state that would be
+  // lost.
+  virtual bool CanDiscard(content::BrowserContext* browser_context) = 0;
 };
 
 template <typename T>
@@ -80,6 +91,12 @@ class DefaultRadiumWebUIConfig : public RadiumWebUIConfig {
   bool IsPreloadable(content::BrowserContext* browser_context) override {
     return false;
   }
+  bool CanFreeze(content::BrowserContext* browser_context) override {
+    return true;
+  }
+  bool CanDiscard(content::BrowserContext* browser_context) override {
+    return true;
+  }
 };
 
 #endif  // RADIUM_BROWSER_UI_WEBUI_RADIUM_WEBUI_CONFIG_H_
@@ -10,6 +10,7 @@
 #include "content/public/browser/web_ui_controller.h"
 #include "content/public/browser/web_ui_controller_factory.h"
 #include "content/public/browser/webui_config.h"
+#include "radium/browser/ui/webui/radium_webui_config.h"
 #include "radium/common/webui_url_constants.h"
 #include "url/gurl.h"
 
@@ -68,37 +69,40 @@ RadiumWebUIConfigMap::RadiumWebUIConfigMap()
 RadiumWebUIConfigMap::~RadiumWebUIConfigMap() = default;
 
 void RadiumWebUIConfigMap::AddWebUIConfig(
-    std::unique_ptr<content::WebUIConfig> config) {
+    std::unique_ptr<RadiumWebUIConfig> config) {
   CHECK_EQ(config->scheme(), radium::kRadiumUIScheme);
   AddWebUIConfigImpl(std::move(config));
 }
 
 void RadiumWebUIConfigMap::AddWebUIConfigImpl(
-    std::unique_ptr<content::WebUIConfig> config) {
+    std::unique_ptr<RadiumWebUIConfig> config) {
+  // Canonicalize the host the same way GURL does for navigations.
   GURL url(base::StrCat(
       {config->scheme(), url::kStandardSchemeSeparator, config->host()}));
-  auto it = configs_map_.emplace(url::Origin::Create(url), std::move(config));
+  CHECK(url.is_valid()) << url.possibly_invalid_spec();
+  auto it = configs_map_.emplace(url.host(), std::move(config));
   // CHECK if a content::WebUIConfig with the same host was already added.
   CHECK(it.second) << url;
 }
 
-content::WebUIConfig* RadiumWebUIConfigMap::GetConfig(
+RadiumWebUIConfig* RadiumWebUIConfigMap::GetConfig(
     content::BrowserContext* browser_context,
     const GURL& url) {
-  // "filesystem:" and "blob:" get dropped by url::Origin::Create() below. We
-  // don't want navigations to these URLs to have WebUI bindings, e.g.
-  // chrome.send() or Mojo.bindInterface(), since some WebUIs currently expose
-  // untrusted content via these schemes.
-  if (url.scheme() != radium::kRadiumUIScheme) {
+  // Only the radium:// scheme is served, so "filesystem:" and "blob:" URLs are
+  // rejected here. We don't want navigations to these URLs to have WebUI
+  // bindings, e.g. chrome.send() or Mojo.bindInterface(), since some WebUIs
+  // currently expose untrusted content via these schemes. URLs with an explicit
+  // port never matched a registered origin either.
+  if (!url.SchemeIs(radium::kRadiumUIScheme) || url.has_port()) {
     return nullptr;
   }
 
-  auto origin_and_config = configs_map_.find(url::Origin::Create(url));
-  if (origin_and_config == configs_map_.end()) {
+  auto host_and_config = configs_map_.find(url.host_piece());
+  if (host_and_config == configs_map_.end()) {
     return nullptr;
   }
 
-  auto& config = origin_and_config->second;
+  auto& config = host_and_config->second;
   if (!config->IsWebUIEnabled(browser_context) ||
       !config->ShouldHandleURL(url)) {
     return nullptr;
@@ -107,11 +111,11 @@ content::WebUIConfig* RadiumWebUIConfigMap::GetConfig(
   return config.get();
 }
 
-std::unique_ptr<content::WebUIConfig> RadiumWebUIConfigMap::RemoveConfig(
+std::unique_ptr<RadiumWebUIConfig> RadiumWebUIConfigMap::RemoveConfig(
     const GURL& url) {
   CHECK(url.scheme() == radium::kRadiumUIScheme);
 
-  auto it = configs_map_.find(url::Origin::Create(url));
+  auto it = configs_map_.find(url.host_piece());
   if (it == configs_map_.end()) {
     return nullptr;
   }
@@ -128,7 +132,9 @@ std::vector<content::WebUIConfigInfo> RadiumWebUIConfigMap::GetWebUIConfigList(
   for (auto& it : configs_map_) {
     auto& webui_config = it.second;
     origins.push_back({
-        .origin = it.first,
+        .origin = url::Origin::Create(GURL(
+            base::StrCat({webui_config->scheme(),
+                          url::kStandardSchemeSeparator, it.first}))),
         .enabled =
             browser_context && webui_config->IsWebUIEnabled(browser_context),
     });
@@ -5,11 +5,15 @@
 #ifndef RADIUM_BROWSER_UI_WEBUI_RADIUM_WEBUI_CONFIG_MAP_H_
 #define RADIUM_BROWSER_UI_WEBUI_RADIUM_WEBUI_CONFIG_MAP_H_
 
-#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "content/public/browser/webui_config_map.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+#include "url/gurl.h"
+
+class RadiumWebUIConfig;
 
 // Class that holds all WebUIConfigs for the browser.
 //
@@ -30,16 +34,16 @@ class RadiumWebUIConfigMap {
 
   // Adds a radium:// WebUIConfig. CHECKs if the WebUIConfig is for a
   // chrome-untrusted:// WebUIConfig.
-  void AddWebUIConfig(std::unique_ptr<content::WebUIConfig> config);
+  void AddWebUIConfig(std::unique_ptr<RadiumWebUIConfig> config);
 
   // Returns the WebUIConfig for |url| if it's registered and the WebUI is
   // enabled. (WebUIs can be disabled based on the profile or feature flags.)
-  content::WebUIConfig* GetConfig(content::BrowserContext* browser_context,
-                                  const GURL& url);
+  RadiumWebUIConfig* GetConfig(content::BrowserContext* browser_context,
+                               const GURL& url);
 
   // Removes and returns the WebUIConfig with |url|. Returns nullptr if
   // there is no WebUIConfig with |url|.
-  std::unique_ptr<content::WebUIConfig> RemoveConfig(const GURL& url);
+  std::unique_ptr<RadiumWebUIConfig> RemoveConfig(const GURL& url);
 
   // Gets a list of the origin (host + scheme) and enabled/disabled status of
   // all currently registered WebUIConfigs. If |browser_context| is null,
@@ -48,10 +52,12 @@ class RadiumWebUIConfigMap {
       content::BrowserContext* browser_context);
 
  private:
-  void AddWebUIConfigImpl(std::unique_ptr<content::WebUIConfig> config);
+  void AddWebUIConfigImpl(std::unique_ptr<RadiumWebUIConfig> config);
 
+  // All configs share the radium:// scheme, so the host alone identifies a
+  // config. Keyed by host to avoid building a url::Origin for every lookup.
   using WebUIConfigMapImpl =
-      std::map<url::Origin, std::unique_ptr<content::WebUIConfig>>;
+      absl::flat_hash_map<std::string, std::unique_ptr<RadiumWebUIConfig>>;
   WebUIConfigMapImpl configs_map_;
 
   std::unique_ptr<content::WebUIControllerFactory> webui_controller_factory_;
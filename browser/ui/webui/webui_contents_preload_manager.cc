@@ -0,0 +1,247 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_contents_preload_manager.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/feature_list.h"
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/string_split.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+#include "content/public/browser/webui_config.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/ui_features.h"
+#include "radium/browser/ui/webui/radium_webui_config.h"
+#include "radium/browser/ui/webui/radium_webui_config_map.h"
+#include "radium/browser/ui/webui/webui_process_model.h"
+#include "ui/base/page_transition_types.h"
+#include "url/gurl.h"
+
+namespace {
+
+std::set<url::Origin> GetExcludeOrigins() {
+  std::set<url::Origin> origins;
+  for (const std::string& origin :
+       base::SplitString(features::kPreloadTopChromeWebUIExcludeOrigins.Get(),
+                         ",", base::TRIM_WHITESPACE,
+                         base::SPLIT_WANT_NONEMPTY)) {
+    origins.insert(url::Origin::Create(GURL(origin)));
+  }
+  return origins;
+}
+
+// Records the time between a WebContents being requested through
+// MakeContents() and its first non-empty paint. A preloaded WebContents that
+// already painted before it was requested records zero.
+class FirstPaintRecorder
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<FirstPaintRecorder> {
+ public:
+  FirstPaintRecorder(const FirstPaintRecorder&) = delete;
+  FirstPaintRecorder& operator=(const FirstPaintRecorder&) = delete;
+
+  ~FirstPaintRecorder() override = default;
+
+  void OnRequested(WebUIContentsPreloadManager::RequestResult result) {
+    result_ = result;
+    request_time_ = base::TimeTicks::Now();
+    if (painted_) {
+      Record(base::TimeDelta());
+    }
+  }
+
+ private:
+  friend content::WebContentsUserData<FirstPaintRecorder>;
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+
+  explicit FirstPaintRecorder(content::WebContents* web_contents)
+      : content::WebContentsObserver(web_contents),
+        content::WebContentsUserData<FirstPaintRecorder>(*web_contents) {}
+
+  // content::WebContentsObserver:
+  void DidFirstVisuallyNonEmptyPaint() override {
+    painted_ = true;
+    if (!request_time_.is_null()) {
+      Record(base::TimeTicks::Now() - request_time_);
+    }
+  }
+
+  void Record(base::TimeDelta time_to_first_paint) {
+    base::UmaHistogramMediumTimes(
+        result_ == WebUIContentsPreloadManager::RequestResult::kHit
+            ? "Radium.WebUI.Preload.RequestToFirstPaint.Hit"
+            : "Radium.WebUI.Preload.RequestToFirstPaint.Miss",
+        time_to_first_paint);
+    // Only the first paint after the request is interesting.
+    request_time_ = base::TimeTicks();
+    Observe(nullptr);
+  }
+
+  bool painted_ = false;
+  base::TimeTicks request_time_;
+  WebUIContentsPreloadManager::RequestResult result_ =
+      WebUIContentsPreloadManager::RequestResult::kMiss;
+};
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(FirstPaintRecorder);
+
+}  // namespace
+
+WebUIContentsPreloadManager::WebUIContentsPreloadManager(Profile* profile)
+    : profile_(profile), exclude_origins_(GetExcludeOrigins()) {}
+
+WebUIContentsPreloadManager::~WebUIContentsPreloadManager() = default;
+
+void WebUIContentsPreloadManager::Warmup() {
+  ScheduleSpareRendererWarmup();
+
+  if (!base::FeatureList::IsEnabled(features::kPreloadTopChromeWebUI) ||
+      preload_mode() != PreloadMode::kPreloadOnWarmup) {
+    return;
+  }
+
+  // Preloading competes with the window that triggered the warmup, so let it
+  // go first.
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(&WebUIContentsPreloadManager::PreloadAll,
+                                weak_ptr_factory_.GetWeakPtr()));
+}
+
+std::unique_ptr<content::WebContents> WebUIContentsPreloadManager::MakeContents(
+    const GURL& url) {
+  TRACE_EVENT1("browser", "WebUIContentsPreloadManager::MakeContents", "url",
+               url.possibly_invalid_spec());
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  const url::Origin origin = url::Origin::Create(url);
+  std::unique_ptr<content::WebContents> web_contents;
+  auto it = preloaded_contents_.find(origin);
+  if (it != preloaded_contents_.end()) {
+    web_contents = std::move(it->second);
+    preloaded_contents_.erase(it);
+  }
+
+  const RequestResult result =
+      web_contents ? RequestResult::kHit : RequestResult::kMiss;
+  base::UmaHistogramEnumeration("Radium.WebUI.Preload.RequestResult", result);
+
+  if (web_contents) {
+    // The preloaded WebContents is navigated to the WebUI root. Requests for a
+    // sub page still reuse its renderer.
+    if (web_contents->GetVisibleURL() != url) {
+      web_contents->GetController().LoadURL(url, content::Referrer(),
+                                            ui::PAGE_TRANSITION_AUTO_TOPLEVEL,
+                                            std::string());
+    }
+  } else {
+    web_contents = CreateWebContents(url, /*initially_hidden=*/false);
+  }
+  FirstPaintRecorder::FromWebContents(web_contents.get())->OnRequested(result);
+  // The WebUI may have taken the spare renderer, start the next one.
+  ScheduleSpareRendererWarmup();
+
+  if (base::FeatureList::IsEnabled(features::kPreloadTopChromeWebUI) &&
+      IsPreloadable(url)) {
+    SchedulePreload(origin);
+  }
+
+  return web_contents;
+}
+
+void WebUIContentsPreloadManager::ReleaseContents() {
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  preloaded_contents_.clear();
+}
+
+content::WebContents*
+WebUIContentsPreloadManager::GetPreloadedWebContentsForTesting(
+    const GURL& url) {
+  auto it = preloaded_contents_.find(url::Origin::Create(url));
+  return it != preloaded_contents_.end() ? it->second.get() : nullptr;
+}
+
+WebUIContentsPreloadManager::PreloadMode
+WebUIContentsPreloadManager::preload_mode() const {
+  return static_cast<PreloadMode>(features::kPreloadTopChromeWebUIMode.Get());
+}
+
+bool WebUIContentsPreloadManager::IsPreloadable(const GURL& url) {
+  if (exclude_origins_.contains(url::Origin::Create(url))) {
+    return false;
+  }
+
+  RadiumWebUIConfig* config =
+      RadiumWebUIConfigMap::GetInstance().GetConfig(profile_, url);
+  return config && config->IsPreloadable(profile_);
+}
+
+void WebUIContentsPreloadManager::Preload(const url::Origin& origin) {
+  if (preloaded_contents_.contains(origin)) {
+    return;
+  }
+
+  TRACE_EVENT0("browser", "WebUIContentsPreloadManager::Preload");
+  preloaded_contents_[origin] =
+      CreateWebContents(origin.GetURL(), /*initially_hidden=*/true);
+}
+
+void WebUIContentsPreloadManager::PreloadAll() {
+  for (const content::WebUIConfigInfo& info :
+       RadiumWebUIConfigMap::GetInstance().GetWebUIConfigList(profile_)) {
+    if (info.enabled && IsPreloadable(info.origin.GetURL())) {
+      Preload(info.origin);
+    }
+  }
+}
+
+void WebUIContentsPreloadManager::SchedulePreload(const url::Origin& origin) {
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(&WebUIContentsPreloadManager::Preload,
+                                weak_ptr_factory_.GetWeakPtr(), origin));
+}
+
+void WebUIContentsPreloadManager::ScheduleSpareRendererWarmup() {
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(
+                     &WebUIContentsPreloadManager::WarmupSpareRenderer,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void WebUIContentsPreloadManager::WarmupSpareRenderer() {
+  WebUIProcessModel::MaybeWarmupSpareRenderer(profile_);
+}
+
+std::unique_ptr<content::WebContents>
+WebUIContentsPreloadManager::CreateWebContents(const GURL& url,
+                                               bool initially_hidden) {
+  content::WebContents::CreateParams params(profile_);
+  params.initially_hidden = initially_hidden;
+  std::unique_ptr<content::WebContents> web_contents =
+      content::WebContents::Create(params);
+  FirstPaintRecorder::CreateForWebContents(web_contents.get());
+  web_contents->GetController().LoadURL(url, content::Referrer(),
+                                        ui::PAGE_TRANSITION_AUTO_TOPLEVEL,
+                                        std::string());
+  return web_contents;
+}
+
+void WebUIContentsPreloadManager::Shutdown() {
+  // The preloaded WebContents must not outlive the profile.
+  ReleaseContents();
+}
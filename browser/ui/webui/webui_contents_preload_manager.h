@@ -0,0 +1,111 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_WEBUI_CONTENTS_PRELOAD_MANAGER_H_
+#define RADIUM_BROWSER_UI_WEBUI_WEBUI_CONTENTS_PRELOAD_MANAGER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "url/origin.h"
+
+class GURL;
+class Profile;
+
+namespace content {
+class WebContents;
+}
+
+// Keeps radium:// WebUIs warm for a profile. For every RadiumWebUIConfig that
+// returns true from IsPreloadable(), at most one hidden WebContents is kept
+// navigated to the WebUI, so that showing it only needs to hand over a
+// WebContents whose renderer, navigation and script bootstrap are already done.
+//
+// Preloading is gated by features::kPreloadTopChromeWebUI. When the feature is
+// disabled MakeContents() still works, it just always creates a new
+// WebContents.
+class WebUIContentsPreloadManager : public KeyedService {
+ public:
+  // This enum entry values must be in sync with
+  // features::PreloadTopChromeWebUIMode.
+  enum class PreloadMode {
+    // Preload every preloadable WebUI as soon as a browser window is created
+    // for the profile.
+    kPreloadOnWarmup = 0,
+    // Only preload a WebUI after it has been requested once.
+    kPreloadOnMakeContents = 1,
+  };
+
+  // These values are persisted to logs. Entries should not be renumbered and
+  // numeric values should never be reused.
+  enum class RequestResult {
+    kHit = 0,
+    kMiss = 1,
+    kMaxValue = kMiss,
+  };
+
+  explicit WebUIContentsPreloadManager(Profile* profile);
+  WebUIContentsPreloadManager(const WebUIContentsPreloadManager&) = delete;
+  WebUIContentsPreloadManager& operator=(const WebUIContentsPreloadManager&) =
+      delete;
+
+  ~WebUIContentsPreloadManager() override;
+
+  // Schedules preloading of all preloadable WebUIs that are not warm yet. Does
+  // nothing unless the preload mode is kPreloadOnWarmup.
+  void Warmup();
+
+  // Returns a WebContents navigated to |url|. If a preloaded WebContents exists
+  // for the WebUI of |url| it is handed over, otherwise a new one is created.
+  // In both cases a replacement is preloaded for the next request. The caller
+  // is responsible for attaching the WebContents to a Browser.
+  std::unique_ptr<content::WebContents> MakeContents(const GURL& url);
+
+  // Destroys the preloaded WebContents and cancels pending preloads. Called
+  // when the last browser window of the profile closes, as their renderers
+  // would keep the profile from being unloaded. The next Warmup() or
+  // MakeContents() preloads again.
+  void ReleaseContents();
+
+  content::WebContents* GetPreloadedWebContentsForTesting(const GURL& url);
+
+ private:
+  PreloadMode preload_mode() const;
+
+  // Returns true if |url| belongs to a WebUI that may be preloaded.
+  bool IsPreloadable(const GURL& url);
+
+  // Creates a hidden WebContents navigated to |origin| unless one already
+  // exists.
+  void Preload(const url::Origin& origin);
+  void PreloadAll();
+  void SchedulePreload(const url::Origin& origin);
+
+  // Keeps a spare renderer warm for the next WebUI, see WebUIProcessModel.
+  void ScheduleSpareRendererWarmup();
+  void WarmupSpareRenderer();
+
+  std::unique_ptr<content::WebContents> CreateWebContents(
+      const GURL& url,
+      bool initially_hidden);
+
+  // KeyedService:
+  void Shutdown() override;
+
+  raw_ptr<Profile> profile_;
+
+  // The origins of WebUIs excluded from preloading by field trial.
+  const std::set<url::Origin> exclude_origins_;
+
+  std::map<url::Origin, std::unique_ptr<content::WebContents>>
+      preloaded_contents_;
+
+  base::WeakPtrFactory<WebUIContentsPreloadManager> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_WEBUI_CONTENTS_PRELOAD_MANAGER_H_
@@ -0,0 +1,151 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_contents_preload_manager.h"
+
+#include <memory>
+
+#include "base/location.h"
+#include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/run_until.h"
+#include "base/test/scoped_feature_list.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/ui_features.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager_factory.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kRequestResultHistogram[] =
+    "Radium.WebUI.Preload.RequestResult";
+
+// Runs the preloads that the manager posted so far.
+void RunPostedPreloads() {
+  base::RunLoop run_loop;
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE, run_loop.QuitClosure());
+  run_loop.Run();
+}
+
+}  // namespace
+
+class WebUIContentsPreloadManagerBrowserTest : public RadiumBrowserTest {
+ public:
+  WebUIContentsPreloadManagerBrowserTest() {
+    feature_list_.InitAndEnableFeatureWithParameters(
+        features::kPreloadTopChromeWebUI,
+        {{features::kPreloadTopChromeWebUIModeName,
+          features::kPreloadTopChromeWebUIModePreloadOnWarmupName}});
+  }
+
+ protected:
+  WebUIContentsPreloadManager* manager() {
+    return WebUIContentsPreloadManagerFactory::GetForProfile(
+        browser()->profile());
+  }
+
+  // Waits until a WebContents other than |handed_out| is preloaded for |url|
+  // and returns it.
+  content::WebContents* WaitForPreloadedContents(
+      const GURL& url,
+      content::WebContents* handed_out = nullptr) {
+    content::WebContents* preloaded = nullptr;
+    if (!base::test::RunUntil([&] {
+          preloaded = manager()->GetPreloadedWebContentsForTesting(url);
+          return preloaded && preloaded != handed_out;
+        })) {
+      return nullptr;
+    }
+    return preloaded;
+  }
+
+  const GURL gallery_url_{radium::kRadiumUIWebuiGalleryURL};
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+// The window opened at startup warms the profile up, and every preloaded
+// WebContents that MakeContents() hands out is replaced by a new one.
+IN_PROC_BROWSER_TEST_F(WebUIContentsPreloadManagerBrowserTest,
+                       HandsOutAndRefillsPreloadedContents) {
+  manager()->Warmup();
+  content::WebContents* preloaded = WaitForPreloadedContents(gallery_url_);
+  ASSERT_TRUE(preloaded);
+
+  base::HistogramTester histogram_tester;
+  std::unique_ptr<content::WebContents> contents =
+      manager()->MakeContents(gallery_url_);
+  EXPECT_EQ(preloaded, contents.get());
+  EXPECT_NE(contents.get(),
+            manager()->GetPreloadedWebContentsForTesting(gallery_url_));
+  histogram_tester.ExpectUniqueSample(
+      kRequestResultHistogram,
+      WebUIContentsPreloadManager::RequestResult::kHit, 1);
+
+  content::WebContents* refill =
+      WaitForPreloadedContents(gallery_url_, contents.get());
+  ASSERT_TRUE(refill);
+
+  std::unique_ptr<content::WebContents> next_contents =
+      manager()->MakeContents(gallery_url_);
+  EXPECT_EQ(refill, next_contents.get());
+  histogram_tester.ExpectUniqueSample(
+      kRequestResultHistogram,
+      WebUIContentsPreloadManager::RequestResult::kHit, 2);
+}
+
+// WebUIs that are not preloadable get a new WebContents every time.
+IN_PROC_BROWSER_TEST_F(WebUIContentsPreloadManagerBrowserTest,
+                       CreatesContentsForOtherWebUIs) {
+  const GURL url(radium::kRadiumUIExampleURL);
+  base::HistogramTester histogram_tester;
+  std::unique_ptr<content::WebContents> contents =
+      manager()->MakeContents(url);
+  ASSERT_TRUE(contents);
+  EXPECT_EQ(url, contents->GetVisibleURL());
+  histogram_tester.ExpectUniqueSample(
+      kRequestResultHistogram,
+      WebUIContentsPreloadManager::RequestResult::kMiss, 1);
+
+  RunPostedPreloads();
+  EXPECT_FALSE(manager()->GetPreloadedWebContentsForTesting(url));
+}
+
+class WebUIContentsPreloadManagerDisabledBrowserTest
+    : public RadiumBrowserTest {
+ public:
+  WebUIContentsPreloadManagerDisabledBrowserTest() {
+    feature_list_.InitAndDisableFeature(features::kPreloadTopChromeWebUI);
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(WebUIContentsPreloadManagerDisabledBrowserTest,
+                       NeverPreloads) {
+  const GURL url(radium::kRadiumUIWebuiGalleryURL);
+  WebUIContentsPreloadManager* manager =
+      WebUIContentsPreloadManagerFactory::GetForProfile(browser()->profile());
+  manager->Warmup();
+
+  base::HistogramTester histogram_tester;
+  std::unique_ptr<content::WebContents> contents = manager->MakeContents(url);
+  ASSERT_TRUE(contents);
+  histogram_tester.ExpectUniqueSample(
+      kRequestResultHistogram,
+      WebUIContentsPreloadManager::RequestResult::kMiss, 1);
+
+  RunPostedPreloads();
+  EXPECT_FALSE(manager->GetPreloadedWebContentsForTesting(url));
+}
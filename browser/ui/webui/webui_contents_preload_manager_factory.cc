@@ -0,0 +1,48 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_contents_preload_manager_factory.h"
+
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/webui/webui_contents_preload_manager.h"
+
+// static
+WebUIContentsPreloadManager* WebUIContentsPreloadManagerFactory::GetForProfile(
+    Profile* profile) {
+  return static_cast<WebUIContentsPreloadManager*>(
+      GetInstance()->GetServiceForBrowserContext(profile, true));
+}
+
+// static
+WebUIContentsPreloadManagerFactory*
+WebUIContentsPreloadManagerFactory::GetInstance() {
+  static base::NoDestructor<WebUIContentsPreloadManagerFactory> instance;
+  return instance.get();
+}
+
+WebUIContentsPreloadManagerFactory::WebUIContentsPreloadManagerFactory()
+    : ProfileKeyedServiceFactory(
+          "WebUIContentsPreloadManager",
+          // Windows of off-the-record profiles, like the ones DevTools
+          // clients open in their browser contexts, make their WebUIs from
+          // the manager of their own profile.
+          ProfileSelections::Builder()
+              .WithRegular(ProfileSelection::kOwnInstance)
+              .WithGuest(ProfileSelection::kOriginalOnly)
+              .Build()) {}
+
+WebUIContentsPreloadManagerFactory::~WebUIContentsPreloadManagerFactory() =
+    default;
+
+std::unique_ptr<KeyedService>
+WebUIContentsPreloadManagerFactory::BuildServiceInstanceForBrowserContext(
+    content::BrowserContext* context) const {
+  return std::make_unique<WebUIContentsPreloadManager>(
+      Profile::FromBrowserContext(context));
+}
+
+bool WebUIContentsPreloadManagerFactory::ServiceIsCreatedWithBrowserContext()
+    const {
+  return true;
+}
@@ -0,0 +1,39 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_WEBUI_CONTENTS_PRELOAD_MANAGER_FACTORY_H_
+#define RADIUM_BROWSER_UI_WEBUI_WEBUI_CONTENTS_PRELOAD_MANAGER_FACTORY_H_
+
+#include "base/no_destructor.h"
+#include "radium/browser/profiles/profile_keyed_service_factory.h"
+
+class Profile;
+class WebUIContentsPreloadManager;
+
+class WebUIContentsPreloadManagerFactory : public ProfileKeyedServiceFactory {
+ public:
+  // Returns the WebUIContentsPreloadManager that keeps the preloadable
+  // WebUIs of |profile| warm.
+  static WebUIContentsPreloadManager* GetForProfile(Profile* profile);
+
+  static WebUIContentsPreloadManagerFactory* GetInstance();
+
+  WebUIContentsPreloadManagerFactory(
+      const WebUIContentsPreloadManagerFactory&) = delete;
+  WebUIContentsPreloadManagerFactory& operator=(
+      const WebUIContentsPreloadManagerFactory&) = delete;
+
+ private:
+  friend base::NoDestructor<WebUIContentsPreloadManagerFactory>;
+
+  WebUIContentsPreloadManagerFactory();
+  ~WebUIContentsPreloadManagerFactory() override;
+
+  // BrowserContextKeyedServiceFactory:
+  std::unique_ptr<KeyedService> BuildServiceInstanceForBrowserContext(
+      content::BrowserContext* context) const override;
+  bool ServiceIsCreatedWithBrowserContext() const override;
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_WEBUI_CONTENTS_PRELOAD_MANAGER_FACTORY_H_
@@ -0,0 +1,57 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_data_source_registry.h"
+
+#include <utility>
+
+#include "base/i18n/rtl.h"
+#include "base/trace_event/trace_event.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/webui/webui_data_source_registry_factory.h"
+
+// static
+void WebUIDataSourceRegistry::EnsureDataSourcesForProfile(
+    Profile* profile,
+    std::string_view host,
+    Recipe recipe) {
+  WebUIDataSourceRegistry* registry =
+      WebUIDataSourceRegistryFactory::GetForProfile(profile);
+  if (registry) {
+    registry->EnsureDataSources(host, recipe);
+  } else {
+    recipe(profile);
+  }
+}
+
+WebUIDataSourceRegistry::WebUIDataSourceRegistry(Profile* profile)
+    : profile_(profile) {
+  native_theme_observation_.Observe(ui::NativeTheme::GetInstanceForNativeUi());
+}
+
+WebUIDataSourceRegistry::~WebUIDataSourceRegistry() = default;
+
+void WebUIDataSourceRegistry::EnsureDataSources(std::string_view host,
+                                                Recipe recipe) {
+  std::string locale = base::i18n::GetConfiguredLocale();
+  if (locale != locale_) {
+    Invalidate();
+    locale_ = std::move(locale);
+  }
+  if (!built_hosts_.emplace(host).second) {
+    return;
+  }
+  TRACE_EVENT0("ui", "WebUIDataSourceRegistry::EnsureDataSources");
+  ++recipe_run_count_;
+  recipe(profile_);
+}
+
+void WebUIDataSourceRegistry::Invalidate() {
+  built_hosts_.clear();
+}
+
+void WebUIDataSourceRegistry::OnNativeThemeUpdated(
+    ui::NativeTheme* observed_theme) {
+  Invalidate();
+}
@@ -0,0 +1,74 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_WEBUI_DATA_SOURCE_REGISTRY_H_
+#define RADIUM_BROWSER_UI_WEBUI_WEBUI_DATA_SOURCE_REGISTRY_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+
+#include "base/containers/flat_set.h"
+#include "base/functional/function_ref.h"
+#include "base/memory/raw_ptr.h"
+#include "base/scoped_observation.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "ui/native_theme/native_theme.h"
+#include "ui/native_theme/native_theme_observer.h"
+
+class Profile;
+
+// Builds the data sources of a profile's radium:// WebUIs the first time one of
+// their controllers is created, instead of every time. Data sources stay
+// registered with the URLDataManager of their BrowserContext, so rebuilding
+// them for each new WebContents only repeats the resource path and CSP setup
+// to replace a source with an identical one.
+//
+// The sources are built again once the application locale or the native theme
+// has changed, since their strings and load time data depend on both.
+class WebUIDataSourceRegistry : public KeyedService,
+                                public ui::NativeThemeObserver {
+ public:
+  // Creates the data sources of a WebUI and adds them to the profile.
+  using Recipe = base::FunctionRef<void(Profile* profile)>;
+
+  // Runs |recipe| through the registry of |profile|, or every time if the
+  // profile has none.
+  static void EnsureDataSourcesForProfile(Profile* profile,
+                                          std::string_view host,
+                                          Recipe recipe);
+
+  explicit WebUIDataSourceRegistry(Profile* profile);
+  WebUIDataSourceRegistry(const WebUIDataSourceRegistry&) = delete;
+  WebUIDataSourceRegistry& operator=(const WebUIDataSourceRegistry&) = delete;
+
+  ~WebUIDataSourceRegistry() override;
+
+  // Runs |recipe| unless it already ran for |host| since the sources were
+  // last invalidated.
+  void EnsureDataSources(std::string_view host, Recipe recipe);
+
+  // Makes the next EnsureDataSources() call for every host run its recipe.
+  void Invalidate();
+
+  // The number of recipes that ran, each of which updates the URLDataManager.
+  size_t recipe_run_count() const { return recipe_run_count_; }
+
+  // ui::NativeThemeObserver:
+  void OnNativeThemeUpdated(ui::NativeTheme* observed_theme) override;
+
+ private:
+  const raw_ptr<Profile> profile_;
+
+  // The locale the sources in |built_hosts_| were built with.
+  std::string locale_;
+  base::flat_set<std::string> built_hosts_;
+  size_t recipe_run_count_ = 0;
+
+  base::ScopedObservation<ui::NativeTheme, ui::NativeThemeObserver>
+      native_theme_observation_{this};
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_WEBUI_DATA_SOURCE_REGISTRY_H_
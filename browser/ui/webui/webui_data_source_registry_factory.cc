@@ -0,0 +1,38 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_data_source_registry_factory.h"
+
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/webui/webui_data_source_registry.h"
+
+// static
+WebUIDataSourceRegistry* WebUIDataSourceRegistryFactory::GetForProfile(
+    Profile* profile) {
+  return static_cast<WebUIDataSourceRegistry*>(
+      GetInstance()->GetServiceForBrowserContext(profile, true));
+}
+
+// static
+WebUIDataSourceRegistryFactory* WebUIDataSourceRegistryFactory::GetInstance() {
+  static base::NoDestructor<WebUIDataSourceRegistryFactory> instance;
+  return instance.get();
+}
+
+WebUIDataSourceRegistryFactory::WebUIDataSourceRegistryFactory()
+    : ProfileKeyedServiceFactory(
+          "WebUIDataSourceRegistry",
+          ProfileSelections::Builder()
+              .WithRegular(ProfileSelection::kOwnInstance)
+              .WithGuest(ProfileSelection::kOwnInstance)
+              .Build()) {}
+
+WebUIDataSourceRegistryFactory::~WebUIDataSourceRegistryFactory() = default;
+
+std::unique_ptr<KeyedService>
+WebUIDataSourceRegistryFactory::BuildServiceInstanceForBrowserContext(
+    content::BrowserContext* context) const {
+  return std::make_unique<WebUIDataSourceRegistry>(
+      Profile::FromBrowserContext(context));
+}
@@ -0,0 +1,39 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_WEBUI_DATA_SOURCE_REGISTRY_FACTORY_H_
+#define RADIUM_BROWSER_UI_WEBUI_WEBUI_DATA_SOURCE_REGISTRY_FACTORY_H_
+
+#include "base/no_destructor.h"
+#include "radium/browser/profiles/profile_keyed_service_factory.h"
+
+class Profile;
+class WebUIDataSourceRegistry;
+
+class WebUIDataSourceRegistryFactory : public ProfileKeyedServiceFactory {
+ public:
+  // Returns the WebUIDataSourceRegistry of |profile|, or null for profiles
+  // that don't show WebUIs. Off-the-record profiles have their own, as they
+  // have their own data sources.
+  static WebUIDataSourceRegistry* GetForProfile(Profile* profile);
+
+  static WebUIDataSourceRegistryFactory* GetInstance();
+
+  WebUIDataSourceRegistryFactory(const WebUIDataSourceRegistryFactory&) =
+      delete;
+  WebUIDataSourceRegistryFactory& operator=(
+      const WebUIDataSourceRegistryFactory&) = delete;
+
+ private:
+  friend base::NoDestructor<WebUIDataSourceRegistryFactory>;
+
+  WebUIDataSourceRegistryFactory();
+  ~WebUIDataSourceRegistryFactory() override;
+
+  // BrowserContextKeyedServiceFactory:
+  std::unique_ptr<KeyedService> BuildServiceInstanceForBrowserContext(
+      content::BrowserContext* context) const override;
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_WEBUI_DATA_SOURCE_REGISTRY_FACTORY_H_
@@ -107,6 +107,15 @@ export function getHtml(this: CrUrlListItemDemoElement) {
   </cr-url-list-item>
 </div>
 
+<h2>With favicons from one batch request</h2>
+<div class="demos">
+  ${this.sites_.map((site, index) => html`
+    <cr-url-list-item url="${site.url}" title="${site.title}"
+        description="${new URL(site.url).hostname}"
+        .imageUrls="${this.favicons_[index] ? [this.favicons_[index]] : []}">
+    </cr-url-list-item>`)}
+</div>
+
 <h2>With other types of content</h2>
 <div class="demos">
   <cr-url-list-item count="23" size="compact"
@@ -11,6 +11,8 @@ import '//resources/cr_elements/icons.html.js';
 
 import {CrLitElement} from '//resources/lit/v3_0/lit.rollup.js';
 
+import {getFaviconsForPageUrls} from '../../favicon_batch.js';
+
 import {getCss} from './cr_url_list_item_demo.css.js';
 import {getHtml} from './cr_url_list_item_demo.html.js';
 
@@ -26,6 +28,34 @@ export class CrUrlListItemDemoElement extends CrLitElement {
   override render() {
     return getHtml.bind(this)();
   }
+
+  static override get properties() {
+    return {
+      favicons_: {type: Array},
+    };
+  }
+
+  protected sites_: Array<{url: string, title: string}> = [
+    {url: 'https://www.google.com', title: 'Google'},
+    {url: 'https://www.chromium.org', title: 'Chromium'},
+    {url: 'https://developer.mozilla.org', title: 'MDN Web Docs'},
+    {url: 'https://www.wikipedia.org', title: 'Wikipedia'},
+  ];
+  protected accessor favicons_: string[] = [];
+
+  override firstUpdated() {
+    // One request for the favicons of the whole list.
+    getFaviconsForPageUrls(this.sites_.map(site => site.url))
+        .then(favicons => {
+          this.favicons_ = favicons;
+        });
+  }
+
+  override disconnectedCallback() {
+    super.disconnectedCallback();
+    this.favicons_.forEach(URL.revokeObjectURL);
+    this.favicons_ = [];
+  }
 }
 
 export const tagName = CrUrlListItemDemoElement.is;
@@ -0,0 +1,37 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Splits the response of radium://favicon2/batch into one PNG per requested
+// URL, in request order. See FaviconSource for the container format.
+export function decodeFaviconBatch(buffer: ArrayBuffer): Uint8Array[] {
+  const view = new DataView(buffer);
+  const count = view.getUint32(0, /*littleEndian=*/ true);
+  const payloadStart = 4 + 8 * count;
+  const icons: Uint8Array[] = [];
+  for (let i = 0; i < count; ++i) {
+    const offset = view.getUint32(4 + 8 * i, /*littleEndian=*/ true);
+    const length = view.getUint32(8 + 8 * i, /*littleEndian=*/ true);
+    icons.push(new Uint8Array(buffer, payloadStart + offset, length));
+  }
+  return icons;
+}
+
+// Fetches the favicons of |pageUrls| with a single request, instead of one
+// radium://favicon2 request per icon. Resolves with an object URL per page
+// URL, in the same order. The caller owns the object URLs.
+export async function getFaviconsForPageUrls(
+    pageUrls: string[], sizeInDip: number = 16): Promise<string[]> {
+  const params = new URLSearchParams();
+  params.set('size', String(sizeInDip));
+  params.set('scaleFactor', `${window.devicePixelRatio}x`);
+  for (const pageUrl of pageUrls) {
+    params.append('pageUrl', pageUrl);
+  }
+  const response = await fetch(`radium://favicon2/batch?${params}`);
+  if (!response.ok) {
+    return [];
+  }
+  return decodeFaviconBatch(await response.arrayBuffer())
+      .map(png => URL.createObjectURL(new Blob([png], {type: 'image/png'})));
+}
@@ -11,8 +11,10 @@
 #include "content/public/browser/web_ui_data_source.h"
 #include "radium/browser/profiles/profile.h"
 #include "radium/browser/ui/webui/favicon_source.h"
+#include "radium/browser/ui/webui/webui_data_source_registry.h"
 #include "radium/browser/ui/webui/webui_util.h"
 #include "radium/common/webui_url_constants.h"
+#include "radium/grit/webui_gallery_code_cache_resources_map.h"
 #include "radium/grit/webui_gallery_resources.h"
 #include "radium/grit/webui_gallery_resources_map.h"
 #include "services/network/public/mojom/content_security_policy.mojom.h"
@@ -32,6 +34,8 @@ void CreateAndAddWebuiGalleryUIHtmlSource(Profile* profile) {
 
   radium::webui::SetupWebUIDataSource(source, kWebuiGalleryResources,
                                       IDR_WEBUI_GALLERY_WEBUI_GALLERY_HTML);
+  radium::webui::AddCodeCacheResources(source,
+                                       kWebuiGalleryCodeCacheResources);
 
   source->OverrideContentSecurityPolicy(
       network::mojom::CSPDirectiveName::FrameSrc, "frame-src 'self';");
@@ -57,7 +61,9 @@ void CreateAndAddWebuiGalleryUIHtmlSource(Profile* profile) {
 
 WebuiGalleryUI::WebuiGalleryUI(content::WebUI* web_ui)
     : ui::MojoWebUIController(web_ui, false) {
-  CreateAndAddWebuiGalleryUIHtmlSource(Profile::FromWebUI(web_ui));
+  WebUIDataSourceRegistry::EnsureDataSourcesForProfile(
+      Profile::FromWebUI(web_ui), radium::kRadiumUIWebuiGalleryHost,
+      &CreateAndAddWebuiGalleryUIHtmlSource);
 }
 
 WebuiGalleryUI::~WebuiGalleryUI() = default;
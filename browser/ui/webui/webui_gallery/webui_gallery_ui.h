@@ -25,6 +25,11 @@ class WebuiGalleryUIConfig : public DefaultRadiumWebUIConfig<WebuiGalleryUI> {
   WebuiGalleryUIConfig()
       : DefaultRadiumWebUIConfig(radium::kRadiumUIScheme,
                                  radium::kRadiumUIWebuiGalleryHost) {}
+
+  // DefaultRadiumWebUIConfig:
+  bool IsPreloadable(content::BrowserContext* browser_context) override {
+    return true;
+  }
 };
 
 // The Web UI controller for the chrome://webui-gallery page.
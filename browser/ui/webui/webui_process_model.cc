@@ -0,0 +1,139 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_process_model.h"
+
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "base/feature_list.h"
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/process/process_handle.h"
+#include "base/strings/strcat.h"
+#include "base/time/time.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/child_process_security_policy.h"
+#include "content/public/browser/render_process_host.h"
+#include "radium/browser/ui/ui_features.h"
+#include "radium/common/webui_url_constants.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr base::TimeDelta kMetricsInterval = base::Minutes(15);
+
+bool IsRadiumWebUI(const GURL& url) {
+  return url.SchemeIs(radium::kRadiumUIScheme);
+}
+
+bool IsWebUIRenderer(content::RenderProcessHost* host) {
+  return host->IsInitializedAndNotDead() &&
+         content::ChildProcessSecurityPolicy::GetInstance()->HasWebUIBindings(
+             host->GetID());
+}
+
+std::string GetHistogramName(std::string_view name) {
+  return base::StrCat({"Radium.WebUI.ProcessModel.", name,
+                       WebUIProcessModel::IsEnabled() ? ".PolicyOn"
+                                                      : ".PolicyOff"});
+}
+
+}  // namespace
+
+WebUIProcessModel::WebUIProcessModel() {
+  metrics_timer_.Start(FROM_HERE, kMetricsInterval, this,
+                       &WebUIProcessModel::RecordMetrics);
+}
+
+WebUIProcessModel::~WebUIProcessModel() = default;
+
+// static
+bool WebUIProcessModel::IsEnabled() {
+  return base::FeatureList::IsEnabled(features::kWebUIProcessModel);
+}
+
+// static
+bool WebUIProcessModel::ShouldUseProcessPerSite(
+    content::BrowserContext* browser_context,
+    const GURL& site_url) {
+  return IsEnabled() && IsRadiumWebUI(site_url) &&
+         features::kWebUIProcessModelProcessPerSite.Get();
+}
+
+// static
+void WebUIProcessModel::MaybeWarmupSpareRenderer(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!IsEnabled() || !features::kWebUIProcessModelKeepSpareRenderer.Get() ||
+      browser_context->ShutdownStarted()) {
+    return;
+  }
+  content::RenderProcessHost::WarmupSpareRenderProcessHost(browser_context);
+}
+
+// static
+int WebUIProcessModel::GetWebUIRendererCount(
+    content::BrowserContext* browser_context) {
+  int count = 0;
+  for (content::RenderProcessHost::iterator it =
+           content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if ((!browser_context || host->GetBrowserContext() == browser_context) &&
+        IsWebUIRenderer(host)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void WebUIProcessModel::RecordMetrics() {
+  base::UmaHistogramCounts100(GetHistogramName("RendererCount"),
+                              GetWebUIRendererCount(nullptr));
+
+  auto* instrumentation =
+      memory_instrumentation::MemoryInstrumentation::GetInstance();
+  if (!instrumentation) {
+    return;
+  }
+  instrumentation->RequestPrivateMemoryFootprint(
+      base::kNullProcessId, base::BindOnce(&WebUIProcessModel::OnMemoryDump,
+                                           weak_ptr_factory_.GetWeakPtr()));
+}
+
+void WebUIProcessModel::OnMemoryDump(
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> global_dump) {
+  if (!success || !global_dump) {
+    return;
+  }
+
+  // The renderers may have changed while the dump was taken, only count the
+  // ones that are still WebUI renderers.
+  std::set<base::ProcessId> webui_pids;
+  for (content::RenderProcessHost::iterator it =
+           content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (IsWebUIRenderer(host)) {
+      webui_pids.insert(host->GetProcess().Pid());
+    }
+  }
+
+  uint64_t private_footprint_kb = 0;
+  for (const memory_instrumentation::GlobalMemoryDump::ProcessDump& dump :
+       global_dump->process_dumps()) {
+    if (webui_pids.contains(dump.pid())) {
+      private_footprint_kb += dump.os_dump().private_footprint_kb;
+    }
+  }
+  base::UmaHistogramMemoryLargeMB(GetHistogramName("PrivateMemoryFootprint"),
+                                  private_footprint_kb / 1024);
+}
@@ -0,0 +1,72 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_BROWSER_UI_WEBUI_WEBUI_PROCESS_MODEL_H_
+#define RADIUM_BROWSER_UI_WEBUI_WEBUI_PROCESS_MODEL_H_
+
+#include <memory>
+
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+
+class GURL;
+
+namespace content {
+class BrowserContext;
+}
+
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}
+
+// Process model for the trusted radium:// WebUIs, gated by
+// features::kWebUIProcessModel:
+//
+// * All WebUIs of one host share a renderer process (process-per-site).
+//   WebUIs of different hosts are never put into the same process, as each
+//   WebUI process is locked to its site.
+// * WebUIs take the spare renderer of content like any other navigation. With
+//   kWebUIProcessModelKeepSpareRenderer, a new spare is also warmed up each
+//   time a WebUI is about to be shown, so that the next one does not wait for
+//   a process launch. It is off by default: the extra spare costs a
+//   renderer's memory while no WebUI is opened.
+//
+// The static methods back the process model hooks of
+// RadiumContentBrowserClient. The instance owned by GlobalFeatures
+// periodically records the number of WebUI renderers and their memory, split
+// by whether the policy is on, so both arms of the feature can be compared.
+class WebUIProcessModel {
+ public:
+  WebUIProcessModel();
+  WebUIProcessModel(const WebUIProcessModel&) = delete;
+  WebUIProcessModel& operator=(const WebUIProcessModel&) = delete;
+
+  ~WebUIProcessModel();
+
+  static bool IsEnabled();
+
+  static bool ShouldUseProcessPerSite(content::BrowserContext* browser_context,
+                                      const GURL& site_url);
+
+  // Starts a spare renderer for |browser_context| unless the policy is off.
+  // Called whenever a WebUI is about to be shown or has taken the spare.
+  static void MaybeWarmupSpareRenderer(
+      content::BrowserContext* browser_context);
+
+  // Returns the number of live renderers with WebUI bindings, for all profiles
+  // if |browser_context| is null.
+  static int GetWebUIRendererCount(content::BrowserContext* browser_context);
+
+ private:
+  void RecordMetrics();
+  void OnMemoryDump(bool success,
+                    std::unique_ptr<memory_instrumentation::GlobalMemoryDump>
+                        global_dump);
+
+  base::RepeatingTimer metrics_timer_;
+
+  base::WeakPtrFactory<WebUIProcessModel> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_BROWSER_UI_WEBUI_WEBUI_PROCESS_MODEL_H_
@@ -0,0 +1,125 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/ui/webui/webui_process_model.h"
+
+#include <memory>
+
+#include "base/test/scoped_feature_list.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/ui_features.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+class WebUIProcessModelBrowserTest : public RadiumBrowserTest {
+ public:
+  WebUIProcessModelBrowserTest() {
+    feature_list_.InitAndEnableFeature(features::kWebUIProcessModel);
+  }
+
+ protected:
+  // Returns a WebContents of the test profile navigated to |url|.
+  std::unique_ptr<content::WebContents> Navigate(const GURL& url) {
+    std::unique_ptr<content::WebContents> web_contents =
+        content::WebContents::Create(
+            content::WebContents::CreateParams(browser()->profile()));
+    EXPECT_TRUE(content::NavigateToURL(web_contents.get(), url));
+    return web_contents;
+  }
+
+  content::RenderProcessHost* GetProcess(content::WebContents* web_contents) {
+    return web_contents->GetPrimaryMainFrame()->GetProcess();
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+// WebUIs of one host share a process, WebUIs of different hosts never do.
+IN_PROC_BROWSER_TEST_F(WebUIProcessModelBrowserTest, SharesProcessPerHost) {
+  std::unique_ptr<content::WebContents> gallery =
+      Navigate(GURL(radium::kRadiumUIWebuiGalleryURL));
+  std::unique_ptr<content::WebContents> other_gallery =
+      Navigate(GURL(radium::kRadiumUIWebuiGalleryURL));
+  std::unique_ptr<content::WebContents> example =
+      Navigate(GURL(radium::kRadiumUIExampleURL));
+
+  EXPECT_EQ(GetProcess(gallery.get()), GetProcess(other_gallery.get()));
+  EXPECT_NE(GetProcess(gallery.get()), GetProcess(example.get()));
+}
+
+// The extra spare costs memory while no WebUI is opened, so it is opt-in.
+IN_PROC_BROWSER_TEST_F(WebUIProcessModelBrowserTest, NoExtraSpareByDefault) {
+  content::RenderProcessHost* spare =
+      content::RenderProcessHost::GetSpareRenderProcessHostForTesting();
+  WebUIProcessModel::MaybeWarmupSpareRenderer(browser()->profile());
+  EXPECT_EQ(spare,
+            content::RenderProcessHost::GetSpareRenderProcessHostForTesting());
+}
+
+// A WebUI without a process yet takes the spare that content keeps, rather
+// than starting a process of its own. The gallery already has one for the
+// window opened at startup.
+IN_PROC_BROWSER_TEST_F(WebUIProcessModelBrowserTest, TakesSpareRenderer) {
+  content::RenderProcessHost::WarmupSpareRenderProcessHost(
+      browser()->profile());
+  content::RenderProcessHost* spare =
+      content::RenderProcessHost::GetSpareRenderProcessHostForTesting();
+  ASSERT_TRUE(spare);
+
+  std::unique_ptr<content::WebContents> example =
+      Navigate(GURL(radium::kRadiumUIExampleURL));
+  EXPECT_EQ(spare, GetProcess(example.get()));
+}
+
+class WebUIProcessModelSpareRendererBrowserTest
+    : public WebUIProcessModelBrowserTest {
+ public:
+  WebUIProcessModelSpareRendererBrowserTest() {
+    spare_renderer_feature_list_.InitAndEnableFeatureWithParameters(
+        features::kWebUIProcessModel, {{"keep-spare-renderer", "true"}});
+  }
+
+ private:
+  base::test::ScopedFeatureList spare_renderer_feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(WebUIProcessModelSpareRendererBrowserTest,
+                       KeepsSpareRenderer) {
+  WebUIProcessModel::MaybeWarmupSpareRenderer(browser()->profile());
+  content::RenderProcessHost* spare =
+      content::RenderProcessHost::GetSpareRenderProcessHostForTesting();
+  ASSERT_TRUE(spare);
+  EXPECT_EQ(browser()->profile(), spare->GetBrowserContext());
+
+  // A WebUI without a process yet takes the spare. The gallery already has
+  // one for the window opened at startup.
+  std::unique_ptr<content::WebContents> example =
+      Navigate(GURL(radium::kRadiumUIExampleURL));
+  EXPECT_EQ(spare, GetProcess(example.get()));
+}
+
+class WebUIProcessModelDisabledBrowserTest : public RadiumBrowserTest {
+ public:
+  WebUIProcessModelDisabledBrowserTest() {
+    feature_list_.InitAndDisableFeature(features::kWebUIProcessModel);
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(WebUIProcessModelDisabledBrowserTest,
+                       KeepsDefaultProcessModel) {
+  EXPECT_FALSE(WebUIProcessModel::ShouldUseProcessPerSite(
+      browser()->profile(), GURL(radium::kRadiumUIWebuiGalleryURL)));
+}
@@ -4,12 +4,14 @@
 
 #include "radium/browser/ui/webui/webui_util.h"
 
+#include "base/feature_list.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "build/build_config.h"
 #include "content/public/browser/web_ui_data_source.h"
 #include "content/public/common/url_constants.h"
 #include "radium/browser/themes/theme_service.h"
+#include "radium/common/radium_features.h"
 #include "radium/common/webui_url_constants.h"
 #include "services/network/public/mojom/content_security_policy.mojom.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -74,6 +76,17 @@ void SetupWebUIDataSource(content::WebUIDataSource* source,
   SetJSModuleDefaults(source);
   source->SetSupportedScheme(radium::kRadiumUIScheme);
 }
+
+void AddCodeCacheResources(
+    content::WebUIDataSource* source,
+    base::span<const ::webui::ResourcePath> code_cache_resources) {
+  if (!base::FeatureList::IsEnabled(features::kWebUICodeCache)) {
+    return;
+  }
+  // Content attaches the code cache to the response of the module with the
+  // same path, and the renderer consumes it instead of compiling the module.
+  source->SetResourcePathToCodeCacheMap(code_cache_resources);
+}
 }  // namespace radium::webui
 
 namespace webui {
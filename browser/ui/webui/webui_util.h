@@ -24,6 +24,14 @@ void SetupWebUIDataSource(content::WebUIDataSource* source,
                           base::span<const ::webui::ResourcePath> resources,
                           int default_resource);
 
+// Registers the V8 code cache generated by webui_code_cache() for the
+// resources of |source|. |code_cache_resources| maps the path of each
+// JavaScript module to its code cache. Does nothing unless
+// features::kWebUICodeCache is enabled.
+void AddCodeCacheResources(
+    content::WebUIDataSource* source,
+    base::span<const ::webui::ResourcePath> code_cache_resources);
+
 }  // namespace radium::webui
 
 namespace webui {
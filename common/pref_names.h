@@ -64,6 +64,28 @@ inline constexpr char kAuthSchemes[] = "auth.schemes";
 // This pref should match |android_webview::prefs::kAuthServerAllowlist|.
 inline constexpr char kAuthServerAllowlist[] = "auth.server_allowlist";
 
+// Boolean that specifies whether a browser's hidden or occluded WebContents
+// may be discarded under memory pressure. Discarded contents are reloaded when
+// they are shown again.
+inline constexpr char kBackgroundContentsDiscardingEnabled[] =
+    "browser.background_contents.discarding_enabled";
+
+// TimeDelta after which a hidden or occluded WebContents of a browser is
+// frozen.
+inline constexpr char kBackgroundContentsFreezeDelay[] =
+    "browser.background_contents.freeze_delay";
+
+// Boolean that specifies whether a browser's hidden or occluded WebContents
+// are frozen after kBackgroundContentsFreezeDelay.
+inline constexpr char kBackgroundContentsFreezingEnabled[] =
+    "browser.background_contents.freezing_enabled";
+
+// Dictionary that maps the id of each app that used the Badging API to the
+// time it last did so, updated at most every kBadgingMinimumUpdateInterval.
+// Times older than kBadgingOverrideLifetime are dropped on updates.
+inline constexpr char kBadgingLastBadgingTimes[] =
+    "badging.last_badging_times";
+
 // Boolean that specifies whether HTTP Basic authentication is allowed for HTTP
 // requests.
 inline constexpr char kBasicAuthOverHttpEnabled[] =
@@ -139,6 +161,14 @@ inline constexpr char kDisableAuthNegotiateCnameLookup[] =
 inline constexpr char kDiskCacheDir[] = "browser.disk_cache_dir";
 // Pref name for the policy specifying the maximal cache size.
 inline constexpr char kDiskCacheSize[] = "browser.disk_cache_size";
+// Integer holding the HTTP cache size, in bytes, that HttpCacheSizeManager
+// last computed for each profile. Only used when kDiskCacheSize is 0.
+inline constexpr char kHttpCacheProfileBudget[] =
+    "browser.http_cache_profile_budget";
+// Double holding the HTTP cache hit rate, in [0, 1], that
+// kHttpCacheProfileBudget was scaled with, or -1 if it was not scaled.
+inline constexpr char kHttpCacheBudgetHitRate[] =
+    "browser.http_cache_budget_hit_rate";
 
 // String specifying the secure DNS mode to use. Any string other than
 // "secure" or "automatic" will be mapped to the default "off" mode.
@@ -0,0 +1,93 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/common/profiler/call_tree.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+
+CallTree::CallTree() {
+  nodes_.push_back({.parent = kRootNode,
+                    .module = kUnknownModule,
+                    .offset = 0,
+                    .self_count = 0,
+                    .total_count = 0});
+}
+
+CallTree::CallTree(CallTree&&) = default;
+CallTree& CallTree::operator=(CallTree&&) = default;
+CallTree::~CallTree() = default;
+
+void CallTree::AddSample(const std::vector<base::Frame>& frames) {
+  uint32_t node = kRootNode;
+  ++nodes_[node].total_count;
+  for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+    const uint32_t module = GetModuleIndex(it->module);
+    const uint64_t offset =
+        it->module ? it->instruction_pointer - it->module->GetBaseAddress()
+                   : it->instruction_pointer;
+    node = GetChild(node, module, offset);
+    ++nodes_[node].total_count;
+  }
+  ++nodes_[node].self_count;
+}
+
+size_t CallTree::GetDistinctStackCount() const {
+  return std::ranges::count_if(
+      nodes_, [](const Node& node) { return node.self_count > 0; });
+}
+
+std::string CallTree::Serialize() const {
+  std::string result = base::StrCat(
+      {"thread ", thread_name_, "\nsamples ",
+       base::NumberToString(sample_count()), " ",
+       base::NumberToString(duration_.InMilliseconds()), "\n"});
+  for (size_t i = 0; i < modules_.size(); ++i) {
+    base::StringAppendF(&result, "module %zu %s %s\n", i,
+                        modules_[i].id.c_str(),
+                        modules_[i].debug_basename.c_str());
+  }
+  for (size_t i = 1; i < nodes_.size(); ++i) {
+    const Node& node = nodes_[i];
+    base::StringAppendF(
+        &result, "node %zu %u %d %llx %u %u\n", i, node.parent,
+        node.module == kUnknownModule ? -1 : static_cast<int>(node.module),
+        static_cast<unsigned long long>(node.offset), node.self_count,
+        node.total_count);
+  }
+  return result;
+}
+
+uint32_t CallTree::GetModuleIndex(const base::ModuleCache::Module* module) {
+  if (!module) {
+    return kUnknownModule;
+  }
+  auto [it, inserted] = module_indices_.try_emplace(
+      module, base::checked_cast<uint32_t>(modules_.size()));
+  if (inserted) {
+    modules_.push_back(
+        {.id = module->GetId(),
+         .debug_basename = module->GetDebugBasename().AsUTF8Unsafe()});
+  }
+  return it->second;
+}
+
+uint32_t CallTree::GetChild(uint32_t parent, uint32_t module, uint64_t offset) {
+  auto [it, inserted] = children_.try_emplace(
+      std::make_tuple(parent, module, offset),
+      base::checked_cast<uint32_t>(nodes_.size()));
+  if (inserted) {
+    nodes_.push_back({.parent = parent,
+                      .module = module,
+                      .offset = offset,
+                      .self_count = 0,
+                      .total_count = 0});
+  }
+  return it->second;
+}
@@ -0,0 +1,92 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_COMMON_PROFILER_CALL_TREE_H_
+#define RADIUM_COMMON_PROFILER_CALL_TREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/profiler/frame.h"
+#include "base/profiler/module_cache.h"
+#include "base/time/time.h"
+
+// The stacks sampled from a thread, merged into a tree of call sites. Frames
+// are identified by their module and their offset in it, so that the tree can
+// be symbolized offline without the process.
+//
+// The text serialization is one record per line:
+//   thread <name>
+//   samples <count> <duration in ms>
+//   module <index> <id> <debug basename>
+//   node <index> <parent index> <module index> <hex offset> <self> <total>
+// Node 0 is the root and is not serialized. A module index of -1 stands for
+// frames outside of any known module, whose offset is then their address.
+class CallTree {
+ public:
+  static constexpr uint32_t kRootNode = 0;
+  static constexpr uint32_t kUnknownModule = UINT32_MAX;
+
+  struct Module {
+    std::string id;
+    std::string debug_basename;
+  };
+
+  struct Node {
+    uint32_t parent;
+    uint32_t module;
+    uint64_t offset;
+    // Samples that stopped at this frame.
+    uint32_t self_count;
+    // Samples that went through this frame.
+    uint32_t total_count;
+  };
+
+  CallTree();
+  CallTree(CallTree&&);
+  CallTree& operator=(CallTree&&);
+  ~CallTree();
+
+  // Adds the stack of a sample. |frames| starts with the innermost frame, as
+  // given by base::ProfileBuilder.
+  void AddSample(const std::vector<base::Frame>& frames);
+
+  void set_thread_name(std::string thread_name) {
+    thread_name_ = std::move(thread_name);
+  }
+  const std::string& thread_name() const { return thread_name_; }
+
+  void set_duration(base::TimeDelta duration) { duration_ = duration; }
+  base::TimeDelta duration() const { return duration_; }
+
+  size_t sample_count() const { return nodes_[kRootNode].total_count; }
+  const std::vector<Module>& modules() const { return modules_; }
+  const std::vector<Node>& nodes() const { return nodes_; }
+
+  // Returns the number of nodes at which at least one sample stopped.
+  size_t GetDistinctStackCount() const;
+
+  std::string Serialize() const;
+
+ private:
+  uint32_t GetModuleIndex(const base::ModuleCache::Module* module);
+  uint32_t GetChild(uint32_t parent, uint32_t module, uint64_t offset);
+
+  std::string thread_name_;
+  base::TimeDelta duration_;
+
+  std::vector<Module> modules_;
+  std::map<const base::ModuleCache::Module*, uint32_t> module_indices_;
+
+  std::vector<Node> nodes_;
+  // Maps (parent, module, offset) to the index of the child node.
+  std::map<std::tuple<uint32_t, uint32_t, uint64_t>, uint32_t> children_;
+};
+
+#endif  // RADIUM_COMMON_PROFILER_CALL_TREE_H_
@@ -0,0 +1,207 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/common/profiler/thread_profiler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/no_destructor.h"
+#include "base/process/process_handle.h"
+#include "base/profiler/module_cache.h"
+#include "base/profiler/profile_builder.h"
+#include "base/profiler/stack_sampling_profiler.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_local.h"
+#include "radium/common/profiler/unwind_util.h"
+#include "radium/common/radium_features.h"
+#include "radium/common/radium_switches.h"
+
+namespace {
+
+const char* GetThreadName(ThreadProfiler::Thread thread) {
+  switch (thread) {
+    case ThreadProfiler::Thread::kBrowserMain:
+      return "BrowserMain";
+    case ThreadProfiler::Thread::kBrowserIO:
+      return "BrowserIO";
+  }
+}
+
+// Merges the samples of a collection into a CallTree. Runs on the sampling
+// thread, and hands the tree over to the sampled thread when the collection
+// completes.
+class CallTreeBuilder : public base::ProfileBuilder {
+ public:
+  CallTreeBuilder(std::string thread_name,
+                  base::OnceCallback<void(CallTree)> callback)
+      : owning_task_runner_(base::SequencedTaskRunner::GetCurrentDefault()),
+        callback_(std::move(callback)) {
+    call_tree_.set_thread_name(std::move(thread_name));
+  }
+  CallTreeBuilder(const CallTreeBuilder&) = delete;
+  CallTreeBuilder& operator=(const CallTreeBuilder&) = delete;
+
+  ~CallTreeBuilder() override = default;
+
+  // base::ProfileBuilder:
+  base::ModuleCache* GetModuleCache() override { return &module_cache_; }
+
+  void OnSampleCompleted(std::vector<base::Frame> frames,
+                         base::TimeTicks sample_timestamp) override {
+    call_tree_.AddSample(frames);
+  }
+
+  void OnProfileCompleted(base::TimeDelta profile_duration,
+                          base::TimeDelta sampling_period) override {
+    call_tree_.set_duration(profile_duration);
+    owning_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback_), std::move(call_tree_)));
+  }
+
+ private:
+  const scoped_refptr<base::SequencedTaskRunner> owning_task_runner_;
+  base::OnceCallback<void(CallTree)> callback_;
+  base::ModuleCache module_cache_;
+  CallTree call_tree_;
+};
+
+void AppendToOutputFile(const base::FilePath& path,
+                        const std::string& contents) {
+  if (!base::PathExists(path)) {
+    base::WriteFile(path, contents);
+  } else {
+    base::AppendToFile(path, contents);
+  }
+}
+
+// Records the summary of a collection in histograms, and writes the tree to
+// the output directory if there is one.
+void ReportCollection(CallTree call_tree) {
+  const std::string prefix =
+      base::StrCat({"Radium.ThreadProfiler.", call_tree.thread_name(), "."});
+  const size_t sample_count = call_tree.sample_count();
+  base::UmaHistogramCounts10000(prefix + "SampleCount", sample_count);
+  base::UmaHistogramCounts10000(prefix + "DistinctStacks",
+                                call_tree.GetDistinctStackCount());
+  if (sample_count > 0) {
+    // How much of the collection the hottest stack takes, which is high when
+    // the thread spends its time on one task.
+    uint32_t top_stack_count = 0;
+    for (const CallTree::Node& node : call_tree.nodes()) {
+      top_stack_count = std::max(top_stack_count, node.self_count);
+    }
+    base::UmaHistogramPercentage(prefix + "TopStackPercentage",
+                                 top_stack_count * 100 / sample_count);
+  }
+
+  const base::FilePath output_dir =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+          switches::kThreadProfilerOutputDir);
+  if (output_dir.empty()) {
+    return;
+  }
+  const base::FilePath path = output_dir.AppendASCII(
+      base::StrCat({call_tree.thread_name(), "-",
+                    base::NumberToString(base::GetCurrentProcId()), ".txt"}));
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&AppendToOutputFile, path, call_tree.Serialize()));
+}
+
+}  // namespace
+
+// static
+ThreadProfiler::Params ThreadProfiler::Params::FromFeature() {
+  Params params;
+  params.sampling_interval = std::max(
+      features::kThreadProfilerSamplingInterval.Get(), base::Milliseconds(1));
+  params.collection_duration =
+      std::max(features::kThreadProfilerCollectionDuration.Get(),
+               params.sampling_interval);
+  const double duty_cycle =
+      std::clamp(features::kThreadProfilerDutyCycle.Get(), 0.001, 1.0);
+  params.collection_period = params.collection_duration / duty_cycle;
+  return params;
+}
+
+// static
+std::unique_ptr<ThreadProfiler> ThreadProfiler::CreateAndStartOnCurrentThread(
+    Thread thread) {
+  if (!base::FeatureList::IsEnabled(features::kThreadProfiler) ||
+      !base::StackSamplingProfiler::IsSupportedForCurrentPlatform()) {
+    return nullptr;
+  }
+  auto profiler = std::make_unique<ThreadProfiler>(
+      GetThreadName(thread), Params::FromFeature(),
+      base::BindRepeating(&ReportCollection));
+  profiler->Start();
+  return profiler;
+}
+
+// static
+void ThreadProfiler::StartOnChildThread(Thread thread) {
+  static base::NoDestructor<base::ThreadLocalOwnedPointer<ThreadProfiler>>
+      child_thread_profiler;
+  child_thread_profiler->Set(CreateAndStartOnCurrentThread(thread));
+}
+
+ThreadProfiler::ThreadProfiler(std::string thread_name,
+                               const Params& params,
+                               CollectionCallback callback)
+    : thread_name_(std::move(thread_name)),
+      params_(params),
+      callback_(std::move(callback)),
+      thread_token_(base::GetSamplingProfilerCurrentThreadToken()) {}
+
+ThreadProfiler::~ThreadProfiler() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void ThreadProfiler::Start() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  StartCollection();
+}
+
+void ThreadProfiler::StartCollection() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::StackSamplingProfiler::SamplingParams sampling_params;
+  sampling_params.sampling_interval = params_.sampling_interval;
+  sampling_params.samples_per_profile =
+      params_.collection_duration / params_.sampling_interval;
+
+  profiler_ = std::make_unique<base::StackSamplingProfiler>(
+      thread_token_, sampling_params,
+      std::make_unique<CallTreeBuilder>(
+          thread_name_,
+          base::BindOnce(&ThreadProfiler::OnCollectionCompleted,
+                         weak_ptr_factory_.GetWeakPtr())),
+      CreateCoreUnwindersFactory());
+  profiler_->Start();
+}
+
+void ThreadProfiler::OnCollectionCompleted(CallTree call_tree) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  profiler_.reset();
+  callback_.Run(std::move(call_tree));
+
+  next_collection_timer_.Start(
+      FROM_HERE,
+      std::max(params_.collection_period - params_.collection_duration,
+               base::TimeDelta()),
+      this, &ThreadProfiler::StartCollection);
+}
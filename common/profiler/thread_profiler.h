@@ -0,0 +1,89 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_COMMON_PROFILER_THREAD_PROFILER_H_
+#define RADIUM_COMMON_PROFILER_THREAD_PROFILER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/profiler/sampling_profiler_thread_token.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "radium/common/profiler/call_tree.h"
+
+namespace base {
+class StackSamplingProfiler;
+}
+
+// Samples the stack of a thread in periodic collections, to find out what
+// keeps it busy in the field. Each collection is merged into a CallTree,
+// which is summarized in histograms and, with --thread-profiler-output-dir,
+// appended to a file for offline symbolization.
+//
+// A ThreadProfiler must be created and destroyed on the thread it samples,
+// which must have a SequencedTaskRunner.
+class ThreadProfiler {
+ public:
+  // The threads that are profiled in production.
+  enum class Thread {
+    kBrowserMain,
+    kBrowserIO,
+  };
+
+  struct Params {
+    // Returns the params configured by features::kThreadProfiler.
+    static Params FromFeature();
+
+    base::TimeDelta sampling_interval;
+    base::TimeDelta collection_duration;
+    // Time from the start of a collection to the start of the next one.
+    base::TimeDelta collection_period;
+  };
+
+  // Called on the sampled thread with the result of each collection.
+  using CollectionCallback = base::RepeatingCallback<void(CallTree)>;
+
+  // Starts profiling the current thread if features::kThreadProfiler is
+  // enabled and stack sampling is supported. Returns null otherwise.
+  static std::unique_ptr<ThreadProfiler> CreateAndStartOnCurrentThread(
+      Thread thread);
+
+  // Like CreateAndStartOnCurrentThread(), for threads whose shutdown the
+  // caller does not control. The profiler lives until the thread exits.
+  static void StartOnChildThread(Thread thread);
+
+  ThreadProfiler(std::string thread_name,
+                 const Params& params,
+                 CollectionCallback callback);
+  ThreadProfiler(const ThreadProfiler&) = delete;
+  ThreadProfiler& operator=(const ThreadProfiler&) = delete;
+
+  ~ThreadProfiler();
+
+  // Starts the first collection right away, so that startup is covered.
+  void Start();
+
+ private:
+  void StartCollection();
+  void OnCollectionCompleted(CallTree call_tree);
+
+  const std::string thread_name_;
+  const Params params_;
+  const CollectionCallback callback_;
+  const base::SamplingProfilerThreadToken thread_token_;
+
+  // Set during a collection.
+  std::unique_ptr<base::StackSamplingProfiler> profiler_;
+  base::OneShotTimer next_collection_timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<ThreadProfiler> weak_ptr_factory_{this};
+};
+
+#endif  // RADIUM_COMMON_PROFILER_THREAD_PROFILER_H_
@@ -4,6 +4,8 @@
 
 #include "radium/common/radium_content_client.h"
 
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
 #include "components/crash/core/common/crash_key.h"
 #include "config/gpu_util.h"
 #include "radium/common/webui_url_constants.h"
@@ -13,6 +15,12 @@
 RadiumContentClient::RadiumContentClient() = default;
 RadiumContentClient::~RadiumContentClient() = default;
 
+// static
+base::Lock& RadiumContentClient::GetResourceBundleLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
 void RadiumContentClient::SetActiveURL(const GURL& url,
                                        std::string top_origin) {
   static crash_reporter::CrashKeyString<1024> active_url("url-chunk");
@@ -44,28 +52,33 @@ std::u16string RadiumContentClient::GetLocalizedString(
 }
 
 bool RadiumContentClient::HasDataResource(int resource_id) const {
+  base::AutoLock lock(GetResourceBundleLock());
   return ui::ResourceBundle::GetSharedInstance().HasDataResource(resource_id);
 }
 
 std::string_view RadiumContentClient::GetDataResource(
     int resource_id,
     ui::ResourceScaleFactor scale_factor) {
+  base::AutoLock lock(GetResourceBundleLock());
   return ui::ResourceBundle::GetSharedInstance().GetRawDataResourceForScale(
       resource_id, scale_factor);
 }
 
 base::RefCountedMemory* RadiumContentClient::GetDataResourceBytes(
     int resource_id) {
+  base::AutoLock lock(GetResourceBundleLock());
   return ui::ResourceBundle::GetSharedInstance().LoadDataResourceBytes(
       resource_id);
 }
 
 std::string RadiumContentClient::GetDataResourceString(int resource_id) {
+  base::AutoLock lock(GetResourceBundleLock());
   return ui::ResourceBundle::GetSharedInstance().LoadDataResourceString(
       resource_id);
 }
 
 gfx::Image& RadiumContentClient::GetNativeImageNamed(int resource_id) {
+  base::AutoLock lock(GetResourceBundleLock());
   return ui::ResourceBundle::GetSharedInstance().GetNativeImageNamed(
       resource_id);
 }
@@ -7,6 +7,10 @@
 
 #include "content/public/common/content_client.h"
 
+namespace base {
+class Lock;
+}
+
 class RadiumContentClient : public content::ContentClient {
  public:
   explicit RadiumContentClient();
@@ -15,6 +19,11 @@ class RadiumContentClient : public content::ContentClient {
 
   ~RadiumContentClient() override;
 
+  // Content asks for data resources from any thread. The getters below hold
+  // this lock while they read the shared ResourceBundle, and so must code
+  // that adds a data pack once other threads may be reading it.
+  static base::Lock& GetResourceBundleLock();
+
  private:
   void SetActiveURL(const GURL& url, std::string top_origin) override;
   void SetGpuInfo(const gpu::GPUInfo& gpu_info) override;
@@ -0,0 +1,18 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_COMMON_RADIUM_DESCRIPTORS_LINUX_H_
+#define RADIUM_COMMON_RADIUM_DESCRIPTORS_LINUX_H_
+
+#include "content/public/common/content_descriptors.h"
+
+// The resource paks the browser opens once and passes to the child processes
+// that load the ResourceBundle, see shared_resource_paks_linux.h.
+enum {
+  kRadium100PercentPakDescriptor = kContentIPCDescriptorMax + 1,
+  kRadium200PercentPakDescriptor,
+  kRadiumResourcesPakDescriptor,
+};
+
+#endif  // RADIUM_COMMON_RADIUM_DESCRIPTORS_LINUX_H_
@@ -6,8 +6,53 @@
 
 namespace features {
 
+// When kAdaptiveHttpCacheSize is enabled, the HTTP cache of each profile is
+// sized by HttpCacheSizeManager unless the disk cache size pref is set.
+BASE_FEATURE(kAdaptiveHttpCacheSize,
+             "AdaptiveHttpCacheSize",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
+// When kDeferHighDpiResourcePak is enabled, the browser only loads the 2x
+// resource pak once a display with a device scale factor above 1.5 is
+// attached, instead of at startup.
+BASE_FEATURE(kDeferHighDpiResourcePak,
+             "DeferHighDpiResourcePak",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
 // When kNoReferrers is enabled, most HTTP requests will provide empty
 // referrers instead of their ordinary behavior.
 BASE_FEATURE(kNoReferrers, "NoReferrers", base::FEATURE_DISABLED_BY_DEFAULT);
 
+// When kUnloadProfiles is enabled, a profile is unloaded once its last browser
+// window has been closed for kUnloadProfilesGracePeriod.
+BASE_FEATURE(kUnloadProfiles,
+             "UnloadProfiles",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
+const base::FeatureParam<base::TimeDelta> kUnloadProfilesGracePeriod{
+    &kUnloadProfiles, "grace_period", base::Seconds(30)};
+
+// When kThreadProfiler is enabled, the browser UI and IO threads are sampled
+// every kThreadProfilerSamplingInterval during collections that last
+// kThreadProfilerCollectionDuration. Collections are spaced so that the
+// threads are sampled kThreadProfilerDutyCycle of the time.
+BASE_FEATURE(kThreadProfiler,
+             "ThreadProfiler",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<base::TimeDelta> kThreadProfilerSamplingInterval{
+    &kThreadProfiler, "sampling_interval", base::Milliseconds(100)};
+
+const base::FeatureParam<base::TimeDelta> kThreadProfilerCollectionDuration{
+    &kThreadProfiler, "collection_duration", base::Seconds(30)};
+
+const base::FeatureParam<double> kThreadProfilerDutyCycle{
+    &kThreadProfiler, "duty_cycle", 0.05};
+
+// When kWebUICodeCache is enabled, radium:// WebUIs hand the V8 code cache
+// generated at build time for their JavaScript modules to the renderer.
+BASE_FEATURE(kWebUICodeCache,
+             "WebUICodeCache",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
 }  // namespace features
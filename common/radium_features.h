@@ -7,11 +7,35 @@
 
 #include "base/component_export.h"
 #include "base/feature_list.h"
+#include "base/metrics/field_trial_params.h"
+#include "base/time/time.h"
 
 namespace features {
 
+COMPONENT_EXPORT(RADIUM_FEATURES)
+BASE_DECLARE_FEATURE(kAdaptiveHttpCacheSize);
+
+COMPONENT_EXPORT(RADIUM_FEATURES)
+BASE_DECLARE_FEATURE(kDeferHighDpiResourcePak);
+
 COMPONENT_EXPORT(RADIUM_FEATURES) BASE_DECLARE_FEATURE(kNoReferrers);
 
+COMPONENT_EXPORT(RADIUM_FEATURES) BASE_DECLARE_FEATURE(kUnloadProfiles);
+COMPONENT_EXPORT(RADIUM_FEATURES)
+extern const base::FeatureParam<base::TimeDelta> kUnloadProfilesGracePeriod;
+
+COMPONENT_EXPORT(RADIUM_FEATURES) BASE_DECLARE_FEATURE(kThreadProfiler);
+COMPONENT_EXPORT(RADIUM_FEATURES)
+extern const base::FeatureParam<base::TimeDelta>
+    kThreadProfilerSamplingInterval;
+COMPONENT_EXPORT(RADIUM_FEATURES)
+extern const base::FeatureParam<base::TimeDelta>
+    kThreadProfilerCollectionDuration;
+COMPONENT_EXPORT(RADIUM_FEATURES)
+extern const base::FeatureParam<double> kThreadProfilerDutyCycle;
+
+COMPONENT_EXPORT(RADIUM_FEATURES) BASE_DECLARE_FEATURE(kWebUICodeCache);
+
 }  // namespace features
 
 #endif  // RADIUM_COMMON_RADIUM_FEATURES_H_
@@ -17,6 +17,10 @@ inline constexpr char kNoPreReadMainDll[] = "no-pre-read-main-dll";
 inline constexpr char kSourceShortcut[] = "source-shortcut";
 #endif  // BUILDFLAG(IS_WIN)
 
+// Stores Local State and the profile preferences in the binary format of
+// BinaryPrefStore instead of JSON. The JSON files are converted as needed.
+inline constexpr char kBinaryPrefStore[] = "binary-pref-store";
+
 inline constexpr char kProfileDirectory[] = "profile-directory";
 
 // TLS 1.2 mode for |kSSLVersionMax| and |kSSLVersionMin| switches.
@@ -25,6 +29,11 @@ inline constexpr char kSSLVersionTLSv12[] = "tls1.2";
 // TLS 1.3 mode for |kSSLVersionMax| and |kSSLVersionMin| switches.
 inline constexpr char kSSLVersionTLSv13[] = "tls1.3";
 
+// Directory to which the ThreadProfiler appends the call trees it collects,
+// one file per thread and process.
+inline constexpr char kThreadProfilerOutputDir[] =
+    "thread-profiler-output-dir";
+
 inline constexpr char kUserDataDir[] = "user-data-dir";
 
 // Uses WinHttp to resolve proxies instead of using Chromium's normal proxy
@@ -18,6 +18,8 @@ inline constexpr char kRadiumUIExampleHost[] = "example";
 inline constexpr char kRadiumUIExampleURL[] = "radium://example";
 inline constexpr char kRadiumUIFavicon2Host[] = "favicon2";
 inline constexpr char kRadiumUIFaviconHost[] = "favicon";
+inline constexpr char kRadiumUIHistogramsHost[] = "histograms";
+inline constexpr char kRadiumUIHistogramsURL[] = "radium://histograms";
 inline constexpr char kRadiumUIResourceHost[] = "resources";
 inline constexpr char kRadiumUIResourceURL[] = "radium://resources";
 inline constexpr char kRadiumUIWebuiGalleryHost[] = "webui-gallery";
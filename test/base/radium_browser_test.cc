@@ -0,0 +1,117 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/test/base/radium_browser_test.h"
+
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/functional/callback.h"
+#include "base/run_loop.h"
+#include "base/scoped_observation.h"
+#include "base/test/bind.h"
+#include "build/build_config.h"
+#include "content/public/browser/render_process_host.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_list.h"
+#include "radium/browser/ui/browser_list_observer.h"
+#include "radium/browser/ui/browser_window.h"
+#include "radium/browser/ui/signin/signin_window.h"
+#include "radium/browser/ui/startup/startup_browser_creator.h"
+#include "radium/common/radium_switches.h"
+
+#if BUILDFLAG(IS_OZONE)
+#include "ui/ozone/public/ozone_switches.h"
+#endif
+
+namespace {
+
+// Runs a RunLoop until |condition| holds, checking it whenever a browser is
+// added to or removed from the BrowserList.
+class BrowserListWaiter : public BrowserListObserver {
+ public:
+  explicit BrowserListWaiter(base::RepeatingCallback<bool()> condition)
+      : condition_(std::move(condition)) {
+    observation_.Observe(BrowserList::GetInstance());
+  }
+
+  void Wait() {
+    if (!condition_.Run()) {
+      run_loop_.Run();
+    }
+  }
+
+ private:
+  // BrowserListObserver:
+  void OnBrowserAdded(Browser* browser) override { MaybeQuit(); }
+  void OnBrowserRemoved(Browser* browser) override { MaybeQuit(); }
+
+  void MaybeQuit() {
+    if (condition_.Run()) {
+      run_loop_.Quit();
+    }
+  }
+
+  base::RepeatingCallback<bool()> condition_;
+  base::RunLoop run_loop_;
+  base::ScopedObservation<BrowserList, BrowserListObserver> observation_{
+      this};
+};
+
+}  // namespace
+
+RadiumBrowserTest::RadiumBrowserTest() = default;
+RadiumBrowserTest::~RadiumBrowserTest() = default;
+
+void RadiumBrowserTest::SetUp() {
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (!command_line->HasSwitch(switches::kUserDataDir)) {
+    CHECK(temp_user_data_dir_.CreateUniqueTempDir());
+    command_line->AppendSwitchPath(switches::kUserDataDir,
+                                   temp_user_data_dir_.GetPath());
+  }
+#if BUILDFLAG(IS_OZONE)
+  if (!command_line->HasSwitch(switches::kOzonePlatform)) {
+    command_line->AppendSwitchASCII(switches::kOzonePlatform, "headless");
+  }
+#endif
+
+  // Nobody is there to confirm the sign-in window.
+  StartupBrowserCreator::SetSkipSigninForTesting(true);
+
+  // Runs the browser, and the test body from PreRunTestOnMainThread() to
+  // PostRunTestOnMainThread().
+  content::BrowserTestBase::SetUp();
+}
+
+void RadiumBrowserTest::PreRunTestOnMainThread() {
+  // The first window is opened once the gallery profile has loaded.
+  BrowserListWaiter(base::BindRepeating([] {
+    return !BrowserList::GetInstance()->empty();
+  })).Wait();
+  browser_ = *BrowserList::GetInstance()->begin();
+}
+
+void RadiumBrowserTest::PostRunTestOnMainThread() {
+  browser_ = nullptr;
+
+  // Tests may show the sign-in window, which keeps the browser alive.
+  SigninWindow::CloseForTesting();
+
+  std::vector<Browser*> browsers(BrowserList::GetInstance()->begin(),
+                                 BrowserList::GetInstance()->end());
+  for (Browser* browser : browsers) {
+    browser->set_force_skip_warning_user_on_close(true);
+    browser->window()->Close();
+  }
+  BrowserListWaiter(base::BindRepeating([] {
+    return BrowserList::GetInstance()->empty();
+  })).Wait();
+
+  for (content::RenderProcessHost::iterator it =
+           content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    it.GetCurrentValue()->FastShutdownIfPossible();
+  }
+}
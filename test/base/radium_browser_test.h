@@ -0,0 +1,43 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_TEST_BASE_RADIUM_BROWSER_TEST_H_
+#define RADIUM_TEST_BASE_RADIUM_BROWSER_TEST_H_
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/raw_ptr.h"
+#include "content/public/test/browser_test_base.h"
+
+class Browser;
+
+// Base class for tests that run inside a complete Radium browser process.
+// The browser starts the way it does for users, with a fresh user data
+// directory, except that the sign-in window is skipped. The test body runs
+// once the first gallery window is shown. On Ozone the browser uses the
+// headless platform so that no display is needed.
+class RadiumBrowserTest : public content::BrowserTestBase {
+ public:
+  RadiumBrowserTest();
+  RadiumBrowserTest(const RadiumBrowserTest&) = delete;
+  RadiumBrowserTest& operator=(const RadiumBrowserTest&) = delete;
+
+  ~RadiumBrowserTest() override;
+
+  // content::BrowserTestBase:
+  void SetUp() override;
+  void PreRunTestOnMainThread() override;
+  void PostRunTestOnMainThread() override;
+
+ protected:
+  // The window opened at startup.
+  Browser* browser() const { return browser_; }
+
+ private:
+  // Only used when the test launcher did not provide a user data directory.
+  base::ScopedTempDir temp_user_data_dir_;
+
+  raw_ptr<Browser> browser_ = nullptr;
+};
+
+#endif  // RADIUM_TEST_BASE_RADIUM_BROWSER_TEST_H_
@@ -0,0 +1,35 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/test/base/radium_test_launcher.h"
+
+#include "base/time/time.h"
+#include "radium/app/radium_main_delegate.h"
+#include "radium/app/startup_timestamps.h"
+#include "radium/common/radium_switches.h"
+
+RadiumTestSuite::RadiumTestSuite(int argc, char** argv)
+    : content::ContentTestSuiteBase(argc, argv) {}
+
+RadiumTestSuite::~RadiumTestSuite() = default;
+
+RadiumTestLauncherDelegate::RadiumTestLauncherDelegate() = default;
+RadiumTestLauncherDelegate::~RadiumTestLauncherDelegate() = default;
+
+int RadiumTestLauncherDelegate::RunTestSuite(int argc, char** argv) {
+  return RadiumTestSuite(argc, argv).Run();
+}
+
+std::string
+RadiumTestLauncherDelegate::GetUserDataDirectoryCommandLineSwitch() {
+  return switches::kUserDataDir;
+}
+
+content::ContentMainDelegate*
+RadiumTestLauncherDelegate::CreateContentMainDelegate() {
+  // Each test runs in a child process of the launcher, so this is as close to
+  // the browser's entry point as the tests can measure.
+  return new RadiumMainDelegate(
+      StartupTimestamps{.exe_entry_point_ticks = base::TimeTicks::Now()});
+}
@@ -0,0 +1,40 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_TEST_BASE_RADIUM_TEST_LAUNCHER_H_
+#define RADIUM_TEST_BASE_RADIUM_TEST_LAUNCHER_H_
+
+#include <string>
+
+#include "content/public/test/content_test_suite_base.h"
+#include "content/public/test/test_launcher.h"
+
+// Test suite for tests that run inside a Radium browser process.
+class RadiumTestSuite : public content::ContentTestSuiteBase {
+ public:
+  RadiumTestSuite(int argc, char** argv);
+  RadiumTestSuite(const RadiumTestSuite&) = delete;
+  RadiumTestSuite& operator=(const RadiumTestSuite&) = delete;
+
+  ~RadiumTestSuite() override;
+};
+
+// Launches RadiumBrowserTests, each in a browser process started through
+// RadiumMainDelegate.
+class RadiumTestLauncherDelegate : public content::TestLauncherDelegate {
+ public:
+  RadiumTestLauncherDelegate();
+  RadiumTestLauncherDelegate(const RadiumTestLauncherDelegate&) = delete;
+  RadiumTestLauncherDelegate& operator=(const RadiumTestLauncherDelegate&) =
+      delete;
+
+  ~RadiumTestLauncherDelegate() override;
+
+  // content::TestLauncherDelegate:
+  int RunTestSuite(int argc, char** argv) override;
+  std::string GetUserDataDirectoryCommandLineSwitch() override;
+  content::ContentMainDelegate* CreateContentMainDelegate() override;
+};
+
+#endif  // RADIUM_TEST_BASE_RADIUM_TEST_LAUNCHER_H_
@@ -0,0 +1,18 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/command_line.h"
+#include "base/test/launcher/test_launcher.h"
+#include "radium/test/base/radium_test_launcher.h"
+
+int main(int argc, char** argv) {
+  base::CommandLine::Init(argc, argv);
+  size_t parallel_jobs = base::NumParallelJobs(/*cores_per_job=*/2);
+  if (parallel_jobs == 0U) {
+    return 1;
+  }
+
+  RadiumTestLauncherDelegate launcher_delegate;
+  return content::LaunchTests(&launcher_delegate, parallel_jobs, argc, argv);
+}
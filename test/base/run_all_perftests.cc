@@ -0,0 +1,13 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/test/base/radium_test_launcher.h"
+
+int main(int argc, char** argv) {
+  RadiumTestLauncherDelegate launcher_delegate;
+  // Run one test at a time so that tests do not compete for the CPU, which
+  // would make the numbers depend on the machine's load.
+  return content::LaunchTests(&launcher_delegate, /*parallel_jobs=*/1, argc,
+                              argv);
+}
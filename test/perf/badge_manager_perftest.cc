@@ -0,0 +1,120 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "components/ukm/test_ukm_recorder.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/badging/badge_manager.h"
+#include "radium/browser/badging/badge_manager_delegate.h"
+#include "radium/browser/badging/badge_manager_factory.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if defined(USE_DBUS)
+#include "dbus/bus.h"
+#include "dbus/mock_bus.h"
+#include "dbus/mock_exported_object.h"
+#include "dbus/object_path.h"
+#include "radium/browser/badging/badge_manager_delegate_linux.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#endif
+
+namespace {
+
+constexpr int kBadgeUpdateCount = 10000;
+constexpr char kAppId[] = "perftestappid";
+
+// Counts the badge updates that reach the platform.
+class CountingBadgeManagerDelegate : public badging::BadgeManagerDelegate {
+ public:
+  CountingBadgeManagerDelegate(Profile* profile,
+                               badging::BadgeManager* badge_manager,
+                               int* update_count)
+      : badging::BadgeManagerDelegate(profile, badge_manager),
+        update_count_(update_count) {}
+
+  // badging::BadgeManagerDelegate:
+  void OnAppBadgeUpdated(const webapps::AppId& app_id) override {
+    ++*update_count_;
+  }
+
+ private:
+  raw_ptr<int> update_count_;
+};
+
+}  // namespace
+
+using BadgeManagerPerfTest = RadiumBrowserTest;
+
+// Reports the time to handle a burst of badge updates for one app, and checks
+// that they are coalesced into a single platform update.
+IN_PROC_BROWSER_TEST_F(BadgeManagerPerfTest, UpdateBurst) {
+  badging::BadgeManager* badge_manager =
+      badging::BadgeManagerFactory::GetForProfile(browser()->profile());
+  ASSERT_TRUE(badge_manager);
+  int update_count = 0;
+  badge_manager->SetDelegate(std::make_unique<CountingBadgeManagerDelegate>(
+      browser()->profile(), badge_manager, &update_count));
+  ukm::TestUkmRecorder ukm_recorder;
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kBadgeUpdateCount; ++i) {
+    badge_manager->SetBadgeForTesting(kAppId, i + 1, &ukm_recorder);
+  }
+  badge_manager->FlushBadgeUpdatesForTesting();
+  radium_perf::ReportResult(
+      "BadgeUpdateBurst", "10000_updates",
+      (base::TimeTicks::Now() - start).InMillisecondsF(), "ms");
+
+  EXPECT_EQ(1, update_count);
+}
+
+#if defined(USE_DBUS)
+// Reports the time to handle a burst of badge updates for many apps through
+// the Linux delegate, which builds one LauncherEntry signal per app and
+// flush. The session bus is a fake, so the time the D-Bus thread takes to
+// send the signals is not included.
+IN_PROC_BROWSER_TEST_F(BadgeManagerPerfTest, UpdateBurstDBus) {
+  constexpr int kAppCount = 100;
+  badging::BadgeManager* badge_manager =
+      badging::BadgeManagerFactory::GetForProfile(browser()->profile());
+  ASSERT_TRUE(badge_manager);
+  auto bus = base::MakeRefCounted<testing::NiceMock<dbus::MockBus>>(
+      dbus::Bus::Options());
+  auto exported_object =
+      base::MakeRefCounted<testing::NiceMock<dbus::MockExportedObject>>(
+          bus.get(), dbus::ObjectPath("/com/canonical/unity/launcherentry/0"));
+  ON_CALL(*bus, GetExportedObject(testing::_))
+      .WillByDefault(testing::Return(exported_object.get()));
+  int signal_count = 0;
+  ON_CALL(*exported_object, SendSignal(testing::_))
+      .WillByDefault([&signal_count](dbus::Signal*) { ++signal_count; });
+  badge_manager->SetDelegate(
+      std::make_unique<badging::BadgeManagerDelegateLinux>(
+          browser()->profile(), badge_manager, bus));
+  ukm::TestUkmRecorder ukm_recorder;
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kBadgeUpdateCount; ++i) {
+    badge_manager->SetBadgeForTesting(
+        kAppId + base::NumberToString(i % kAppCount), i + 1, &ukm_recorder);
+  }
+  badge_manager->FlushBadgeUpdatesForTesting();
+  radium_perf::ReportResult(
+      "BadgeUpdateBurst", "10000_updates_100_apps_dbus",
+      (base::TimeTicks::Now() - start).InMillisecondsF(), "ms");
+
+  EXPECT_EQ(kAppCount, signal_count);
+  // Unregisters the exported object while the fake bus is alive.
+  badge_manager->SetDelegate(nullptr);
+}
+#endif  // defined(USE_DBUS)
@@ -0,0 +1,114 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <optional>
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "radium/browser/prefs/binary_pref_store.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kSectionCount = 100;
+
+// Preferences split into sections like the ones of a real profile, with
+// integer and string values.
+base::Value::Dict CreatePrefs(int key_count) {
+  base::Value::Dict prefs;
+  for (int i = 0; i < key_count; ++i) {
+    const std::string path =
+        base::StrCat({"section", base::NumberToString(i % kSectionCount),
+                      ".pref", base::NumberToString(i)});
+    if (i % 2) {
+      prefs.SetByDottedPath(path, i);
+    } else {
+      prefs.SetByDottedPath(path, "https://www.example.com/" + path);
+    }
+  }
+  return prefs;
+}
+
+}  // namespace
+
+// Compares the encodings of BinaryPrefStore and JsonPrefStore, without the
+// file IO that both stores do on a background sequence. Loading parses the
+// whole file in both cases. A commit of one change appends one record to the
+// binary log, while the JSON file is serialized in full.
+class BinaryPrefStorePerfTest : public testing::TestWithParam<int> {
+ protected:
+  std::string story(const char* store) const {
+    return base::StrCat(
+        {store, "_", base::NumberToString(GetParam()), "_keys"});
+  }
+};
+
+TEST_P(BinaryPrefStorePerfTest, Load) {
+  const base::Value::Dict prefs = CreatePrefs(GetParam());
+  const std::string binary = BinaryPrefStore::SerializeSnapshot(prefs);
+  std::string json;
+  ASSERT_TRUE(base::JSONWriter::Write(prefs, &json));
+  radium_perf::ReportResult("PrefFileSize", story("binary"), binary.size(),
+                            "bytes");
+  radium_perf::ReportResult("PrefFileSize", story("json"), json.size(),
+                            "bytes");
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  std::optional<BinaryPrefStore::ReadResult> result =
+      BinaryPrefStore::ParseFile(base::as_byte_span(binary));
+  radium_perf::ReportResult("PrefLoad", story("binary"),
+                            (base::TimeTicks::Now() - start).InMillisecondsF(),
+                            "ms");
+  ASSERT_TRUE(result);
+  EXPECT_EQ(prefs, result->prefs);
+
+  start = base::TimeTicks::Now();
+  std::optional<base::Value::Dict> parsed = base::JSONReader::ReadDict(json);
+  radium_perf::ReportResult("PrefLoad", story("json"),
+                            (base::TimeTicks::Now() - start).InMillisecondsF(),
+                            "ms");
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(prefs, *parsed);
+}
+
+TEST_P(BinaryPrefStorePerfTest, CommitOneChange) {
+  constexpr int kCommitCount = 100;
+  base::Value::Dict prefs = CreatePrefs(GetParam());
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kCommitCount; ++i) {
+    const base::Value value(i);
+    std::string record;
+    BinaryPrefStore::AppendRecord(BinaryPrefStore::RecordOp::kSet,
+                                  "section1.pref1", &value, &record);
+    ASSERT_FALSE(record.empty());
+  }
+  radium_perf::ReportResult(
+      "PrefCommit", story("binary"),
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kCommitCount, "us");
+
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kCommitCount; ++i) {
+    prefs.SetByDottedPath("section1.pref1", i);
+    std::string json;
+    ASSERT_TRUE(base::JSONWriter::Write(prefs, &json));
+  }
+  radium_perf::ReportResult(
+      "PrefCommit", story("json"),
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kCommitCount, "us");
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         BinaryPrefStorePerfTest,
+                         testing::Values(1000, 10000, 100000),
+                         [](const testing::TestParamInfo<int>& info) {
+                           return base::NumberToString(info.param) + "Keys";
+                         });
@@ -0,0 +1,111 @@
+// Copyright 2025 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_window.h"
+#include "radium/browser/ui/gallery/gallery_window_factory.h"
+#include "radium/browser/ui/views/dragging/cached_window_finder.h"
+#include "radium/browser/ui/window_finder.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/views/widget/widget.h"
+
+namespace {
+
+constexpr int kWindowCount = 50;
+constexpr int kMoveCount = 100000;
+
+// Stands in for the platform, which on X11 makes a round trip to the server
+// for each query. Windows are stacked in the order they were added, the last
+// one on top.
+class FakePlatformFinder : public WindowFinder {
+ public:
+  FakePlatformFinder(const std::vector<raw_ptr<views::Widget>>* stack,
+                     int* query_count)
+      : stack_(stack), query_count_(query_count) {}
+
+  // WindowFinder:
+  gfx::NativeWindow GetLocalProcessWindowAtPoint(
+      const gfx::Point& screen_point,
+      const std::set<gfx::NativeWindow>& ignore) override {
+    ++*query_count_;
+    for (auto it = stack_->rbegin(); it != stack_->rend(); ++it) {
+      if ((*it)->GetWindowBoundsInScreen().Contains(screen_point) &&
+          !ignore.contains((*it)->GetNativeWindow())) {
+        return (*it)->GetNativeWindow();
+      }
+    }
+    return gfx::NativeWindow();
+  }
+
+ private:
+  raw_ptr<const std::vector<raw_ptr<views::Widget>>> stack_;
+  raw_ptr<int> query_count_;
+};
+
+}  // namespace
+
+using CachedWindowFinderPerfTest = RadiumBrowserTest;
+
+// Reports the time to find the window under the pointer for each move of a
+// drag over cascaded windows, and how many of the moves reached the platform.
+IN_PROC_BROWSER_TEST_F(CachedWindowFinderPerfTest, DragOverCascadedWindows) {
+  std::vector<raw_ptr<views::Widget>> stack;
+  for (int i = 0; i < kWindowCount; ++i) {
+    views::Widget* widget =
+        CreateGalleryBrowser(browser()->profile())->window()->GetWidget();
+    widget->SetBounds(gfx::Rect(i * 20, i * 10, 400, 300));
+    stack.push_back(widget);
+  }
+  const std::set<gfx::NativeWindow> ignore = {
+      browser()->window()->GetWidget()->GetNativeWindow()};
+
+  // A path that sweeps over all the windows, back and forth.
+  std::vector<gfx::Point> moves;
+  moves.reserve(kMoveCount);
+  for (int i = 0; i < kMoveCount; ++i) {
+    moves.emplace_back((i * 7) % 1400, (i * 3) % 800);
+  }
+
+  int uncached_query_count = 0;
+  FakePlatformFinder platform_finder(&stack, &uncached_query_count);
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (const gfx::Point& point : moves) {
+    platform_finder.GetLocalProcessWindowAtPoint(point, ignore);
+  }
+  radium_perf::ReportResult(
+      "WindowAtPoint", "uncached",
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kMoveCount, "us");
+
+  int cached_query_count = 0;
+  CachedWindowFinder cached_finder(
+      std::make_unique<FakePlatformFinder>(&stack, &cached_query_count));
+  for (const gfx::Point& point : moves) {
+    // The cache must agree with the platform.
+    ASSERT_EQ(platform_finder.GetLocalProcessWindowAtPoint(point, ignore),
+              cached_finder.GetLocalProcessWindowAtPoint(point, ignore));
+  }
+  radium_perf::ReportResult("PlatformQueries", "uncached",
+                            uncached_query_count, "count");
+  radium_perf::ReportResult("PlatformQueries", "cached", cached_query_count,
+                            "count");
+
+  start = base::TimeTicks::Now();
+  for (const gfx::Point& point : moves) {
+    cached_finder.GetLocalProcessWindowAtPoint(point, ignore);
+  }
+  radium_perf::ReportResult(
+      "WindowAtPoint", "cached",
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kMoveCount, "us");
+}
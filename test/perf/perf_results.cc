@@ -0,0 +1,85 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/test/perf/perf_results.h"
+
+#include <optional>
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/values.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace radium_perf {
+
+namespace {
+
+constexpr char kBenchmarkName[] = "radium_perftests";
+
+base::Value::Dict ReadResults(const base::FilePath& path) {
+  std::string contents;
+  if (base::ReadFileToString(path, &contents)) {
+    std::optional<base::Value::Dict> results =
+        base::JSONReader::ReadDict(contents);
+    if (results) {
+      return std::move(*results);
+    }
+    LOG(WARNING) << "Replacing invalid perf results in " << path;
+  }
+
+  base::Value::Dict results;
+  results.Set("format_version", "1.0");
+  results.Set("benchmark_name", kBenchmarkName);
+  results.Set("charts", base::Value::Dict());
+  return results;
+}
+
+void AddResultToFile(const base::FilePath& path,
+                     const std::string& metric,
+                     const std::string& story,
+                     double value,
+                     const std::string& units) {
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  base::Value::Dict results = ReadResults(path);
+
+  base::Value::Dict* chart =
+      results.EnsureDict("charts")->EnsureDict(metric)->EnsureDict(story);
+  chart->Set("type", "list_of_scalar_values");
+  chart->Set("units", units);
+  base::Value::List* values = chart->EnsureList("values");
+  values->Append(value);
+
+  std::string json;
+  CHECK(base::JSONWriter::WriteWithOptions(
+      results, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json));
+  if (!base::WriteFile(path, json)) {
+    LOG(ERROR) << "Failed to write perf results to " << path;
+  }
+}
+
+}  // namespace
+
+void ReportResult(const std::string& metric,
+                  const std::string& story,
+                  double value,
+                  const std::string& units) {
+  perf_test::PerfResultReporter reporter(metric, story);
+  reporter.RegisterImportantMetric("", units);
+  reporter.AddResult("", value);
+
+  const base::FilePath path =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+          kPerfJsonOutputSwitch);
+  if (!path.empty()) {
+    AddResultToFile(path, metric, story, value, units);
+  }
+}
+
+}  // namespace radium_perf
@@ -0,0 +1,30 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RADIUM_TEST_PERF_PERF_RESULTS_H_
+#define RADIUM_TEST_PERF_PERF_RESULTS_H_
+
+#include <string>
+
+namespace radium_perf {
+
+// Name of the switch with the path of the JSON file that results are added
+// to. The file is in the chartjson format the perf dashboard reads:
+//   {"format_version": "1.0", "benchmark_name": "radium_perftests",
+//    "charts": {<metric>: {<story>: {"type": "list_of_scalar_values",
+//                                    "units": <units>, "values": [...]}}}}
+// Every test runs in its own process, so each result is merged into what is
+// already in the file.
+inline constexpr char kPerfJsonOutputSwitch[] = "perf-json-output";
+
+// Prints a result in the format of //testing/perf, and adds it to the JSON
+// file if kPerfJsonOutputSwitch was passed.
+void ReportResult(const std::string& metric,
+                  const std::string& story,
+                  double value,
+                  const std::string& units);
+
+}  // namespace radium_perf
+
+#endif  // RADIUM_TEST_PERF_PERF_RESULTS_H_
@@ -0,0 +1,83 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "radium/browser/process_singleton_message_posix.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace internal {
+
+namespace {
+
+constexpr int kIterations = 10000;
+
+// A command line like the ones a second instance forwards when the user opens
+// a batch of files.
+std::vector<std::string> CreateArgv() {
+  std::vector<std::string> argv = {"/opt/radium/radium"};
+  for (int i = 0; i < 64; ++i) {
+    argv.push_back("/home/user/Documents/file" + base::NumberToString(i) +
+                   ".html");
+  }
+  return argv;
+}
+
+TEST(ProcessSingletonMessagePerfTest, Binary) {
+  const std::vector<std::string> argv = CreateArgv();
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  std::string message;
+  for (int i = 0; i < kIterations; ++i) {
+    message = EncodeBinaryProcessSingletonMessage("/home/user", argv);
+  }
+  radium_perf::ReportResult(
+      "ProcessSingletonEncode", "binary",
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kIterations, "us");
+
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    std::optional<ProcessSingletonMessage> decoded =
+        DecodeBinaryProcessSingletonMessage(base::as_byte_span(message));
+    ASSERT_TRUE(decoded);
+    ASSERT_EQ(argv.size(), decoded->argv.size());
+  }
+  radium_perf::ReportResult(
+      "ProcessSingletonDecode", "binary",
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kIterations, "us");
+}
+
+TEST(ProcessSingletonMessagePerfTest, Text) {
+  const std::vector<std::string> argv = CreateArgv();
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  std::string message;
+  for (int i = 0; i < kIterations; ++i) {
+    message = EncodeTextProcessSingletonMessage("/home/user", argv);
+  }
+  radium_perf::ReportResult(
+      "ProcessSingletonEncode", "text",
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kIterations, "us");
+
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    std::optional<ProcessSingletonMessage> decoded =
+        DecodeTextProcessSingletonMessage(message);
+    ASSERT_TRUE(decoded);
+    ASSERT_EQ(argv.size(), decoded->argv.size());
+  }
+  radium_perf::ReportResult(
+      "ProcessSingletonDecode", "text",
+      (base::TimeTicks::Now() - start).InMicrosecondsF() / kIterations, "us");
+}
+
+}  // namespace
+
+}  // namespace internal
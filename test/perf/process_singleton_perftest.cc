@@ -0,0 +1,100 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "radium/browser/process_singleton.h"
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/test_timeouts.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "content/public/test/browser_task_environment.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kRelaunchCount = 10000;
+
+class TestProcessSingleton : public ProcessSingleton {
+ public:
+  using ProcessSingleton::NotifyOtherProcessWithTimeout;
+  using ProcessSingleton::ProcessSingleton;
+};
+
+// A second instance opening a batch of files, with a command line longer than
+// the 32KB that the text format allows.
+base::CommandLine CreateCommandLine() {
+  base::CommandLine command_line(
+      base::FilePath(FILE_PATH_LITERAL("/opt/radium/radium")));
+  for (int i = 0; i < 1024; ++i) {
+    command_line.AppendArgPath(base::FilePath(base::StrCat(
+        {"/home/user/Documents/file", base::NumberToString(i), ".html"})));
+  }
+  return command_line;
+}
+
+}  // namespace
+
+// Measures how long a second instance waits for the browser to take its
+// command line, from connecting to the socket to reading the ACK. The browser
+// side is the LinuxWatcher of a ProcessSingleton, which reads the message on
+// the IO thread and hands it to the UI thread.
+TEST(ProcessSingletonPerfTest, Relaunch) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::REAL_IO_THREAD);
+  base::ScopedTempDir user_data_dir;
+  ASSERT_TRUE(user_data_dir.CreateUniqueTempDir());
+  const base::CommandLine command_line = CreateCommandLine();
+
+  int received_count = 0;
+  TestProcessSingleton browser(
+      user_data_dir.GetPath(),
+      base::BindLambdaForTesting([&](base::CommandLine received,
+                                     const base::FilePath& current_dir) {
+        ++received_count;
+        EXPECT_EQ(command_line.argv(), received.argv());
+        return true;
+      }));
+  ASSERT_TRUE(browser.Create());
+  browser.StartWatching();
+
+  // The second instance blocks until it reads the ACK, so it runs on its own
+  // thread while the main thread runs the UI side.
+  TestProcessSingleton relauncher(user_data_dir.GetPath(),
+                                  ProcessSingleton::NotificationCallback());
+  base::Thread relauncher_thread("Relauncher");
+  ASSERT_TRUE(relauncher_thread.Start());
+  int notified_count = 0;
+  base::TimeDelta elapsed;
+  base::RunLoop run_loop;
+  relauncher_thread.task_runner()->PostTaskAndReply(
+      FROM_HERE, base::BindLambdaForTesting([&] {
+        const base::TimeTicks start = base::TimeTicks::Now();
+        for (int i = 0; i < kRelaunchCount; ++i) {
+          if (relauncher.NotifyOtherProcessWithTimeout(
+                  command_line, /*retry_attempts=*/1,
+                  TestTimeouts::action_timeout(),
+                  /*kill_unresponsive=*/false) ==
+              ProcessSingleton::PROCESS_NOTIFIED) {
+            ++notified_count;
+          }
+        }
+        elapsed = base::TimeTicks::Now() - start;
+      }),
+      run_loop.QuitClosure());
+  run_loop.Run();
+  relauncher_thread.Stop();
+
+  EXPECT_EQ(kRelaunchCount, notified_count);
+  EXPECT_EQ(kRelaunchCount, received_count);
+  radium_perf::ReportResult("ProcessSingletonRelaunch", "1024_args",
+                            elapsed.InMicrosecondsF() / kRelaunchCount, "us");
+  browser.Cleanup();
+}
@@ -0,0 +1,128 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/files/file_path.h"
+#include "base/process/process_handle.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/time/time.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/devtools/devtools_browser_context_manager.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kBrowserContextCount = 100;
+
+// Returns the private memory footprint of the browser process, in KiB.
+int64_t GetBrowserPrivateFootprintKb() {
+  int64_t footprint_kb = 0;
+  base::RunLoop run_loop;
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestPrivateMemoryFootprint(
+          base::GetCurrentProcId(),
+          base::BindLambdaForTesting(
+              [&](bool success,
+                  std::unique_ptr<memory_instrumentation::GlobalMemoryDump>
+                      dump) {
+                EXPECT_TRUE(success);
+                if (success) {
+                  for (const auto& process_dump : dump->process_dumps()) {
+                    footprint_kb = process_dump.os_dump().private_footprint_kb;
+                  }
+                }
+                run_loop.Quit();
+              }));
+  run_loop.Run();
+  return footprint_kb;
+}
+
+}  // namespace
+
+using ProfilePerfTest = RadiumBrowserTest;
+
+// Reports the time to create and initialize a new profile, and how much of it
+// is spent creating its keyed services.
+IN_PROC_BROWSER_TEST_F(ProfilePerfTest, CreateProfile) {
+  ProfileManager* profile_manager =
+      BrowserProcess::Get()->GetFeatures()->profile_manager();
+  const base::FilePath path =
+      profile_manager->user_data_dir().AppendASCII("PerfTestProfile");
+
+  Profile* profile = nullptr;
+  base::RunLoop run_loop;
+  const base::TimeTicks start = base::TimeTicks::Now();
+  profile_manager->CreateProfileAsync(
+      path, base::BindLambdaForTesting([&](Profile* created) {
+        profile = created;
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+  const base::TimeDelta creation_time = base::TimeTicks::Now() - start;
+
+  ASSERT_TRUE(profile);
+  radium_perf::ReportResult("ProfileCreation", "new_profile",
+                            creation_time.InMillisecondsF(), "ms");
+  radium_perf::ReportResult(
+      "ProfileServicesCreation", "new_profile",
+      profile->services_creation_time().InMillisecondsF(), "ms");
+}
+
+// Reports the time to create and dispose of the in-memory browser contexts
+// that DevTools clients use to run isolated sessions, and the memory that each
+// of them adds to the browser process before it opens any page.
+IN_PROC_BROWSER_TEST_F(ProfilePerfTest, DevToolsBrowserContexts) {
+  DevToolsBrowserContextManager& manager =
+      DevToolsBrowserContextManager::GetInstance();
+  ASSERT_TRUE(memory_instrumentation::MemoryInstrumentation::GetInstance());
+  const int64_t footprint_before_kb = GetBrowserPrivateFootprintKb();
+
+  std::vector<content::BrowserContext*> contexts;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kBrowserContextCount; ++i) {
+    contexts.push_back(manager.CreateBrowserContext());
+    ASSERT_TRUE(contexts.back());
+  }
+  radium_perf::ReportResult(
+      "DevToolsBrowserContextCreation", "100_contexts",
+      (base::TimeTicks::Now() - start).InMillisecondsF(), "ms");
+  radium_perf::ReportResult(
+      "DevToolsBrowserContextMemory", "per_context",
+      static_cast<double>(GetBrowserPrivateFootprintKb() -
+                          footprint_before_kb) /
+          kBrowserContextCount,
+      "KiB");
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(kBrowserContextCount, run_loop.QuitClosure());
+  start = base::TimeTicks::Now();
+  for (content::BrowserContext* context : contexts) {
+    manager.DisposeBrowserContext(
+        context,
+        base::BindLambdaForTesting([&](bool success, const std::string&) {
+          EXPECT_TRUE(success);
+          barrier.Run();
+        }));
+  }
+  run_loop.Run();
+  radium_perf::ReportResult(
+      "DevToolsBrowserContextDisposal", "100_contexts",
+      (base::TimeTicks::Now() - start).InMillisecondsF(), "ms");
+}
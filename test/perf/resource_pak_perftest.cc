@@ -0,0 +1,237 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/base_switches.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/process/process_handle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/common/content_switches.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "radium/browser/radium_resource_bundle_helper.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/common/radium_features.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "sandbox/policy/switches.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr int kRendererCount = 50;
+
+constexpr char kChildResourceBundleInitTimeHistogram[] =
+    "Radium.ChildProcess.ResourceBundleInitTime";
+constexpr char kBrowserResourceBundleInitTimeHistogram[] =
+    "Radium.Startup.ResourceBundleInitTime";
+
+struct MappedMemory {
+  // Resident and proportional set sizes of the .pak mappings.
+  int64_t pak_rss_kb = 0;
+  int64_t pak_pss_kb = 0;
+  // Resident set size of all mappings.
+  int64_t rss_kb = 0;
+};
+
+// Adds the memory of the mappings of |pid| to |memory|. The pages of the paks
+// are backed by the page cache, so their PSS summed over all processes is
+// what the paks cost there. Returns false if the mappings of |pid| can't be
+// read.
+bool AddMappedMemory(base::ProcessId pid, MappedMemory* memory) {
+  std::string smaps;
+  if (!base::ReadFileToString(
+          base::FilePath(base::StringPrintf("/proc/%d/smaps", pid)),
+          &smaps)) {
+    return false;
+  }
+  bool in_pak = false;
+  for (std::string_view line : base::SplitStringPiece(
+           smaps, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<std::string_view> fields = base::SplitStringPiece(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    // Mappings start with their address range, followed by their fields.
+    if (!base::EndsWith(fields[0], ":")) {
+      in_pak = base::EndsWith(fields.back(), ".pak");
+      continue;
+    }
+    int64_t kb;
+    if (fields.size() < 2 || !base::StringToInt64(fields[1], &kb)) {
+      continue;
+    }
+    if (fields[0] == "Rss:") {
+      memory->rss_kb += kb;
+      if (in_pak) {
+        memory->pak_rss_kb += kb;
+      }
+    } else if (fields[0] == "Pss:" && in_pak) {
+      memory->pak_pss_kb += kb;
+    }
+  }
+  return true;
+}
+
+// Returns the mean of the samples of the histogram |name| recorded so far, or
+// nullopt if there are none.
+std::optional<double> GetHistogramMean(const char* name) {
+  base::HistogramBase* histogram =
+      base::StatisticsRecorder::FindHistogram(name);
+  if (!histogram) {
+    return std::nullopt;
+  }
+  std::unique_ptr<base::HistogramSamples> samples =
+      histogram->SnapshotSamples();
+  if (samples->TotalCount() == 0) {
+    return std::nullopt;
+  }
+  return static_cast<double>(samples->sum()) / samples->TotalCount();
+}
+
+std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
+    const net::test_server::HttpRequest& request) {
+  auto response = std::make_unique<net::test_server::BasicHttpResponse>();
+  response->set_content_type("text/html");
+  response->set_content("<p>radium</p>");
+  return response;
+}
+
+}  // namespace
+
+// Launches renderers for distinct sites, either forked by the zygote or
+// started directly, in which case they load the paks the browser passes them.
+class ResourcePakPerfTest : public RadiumBrowserTest,
+                            public testing::WithParamInterface<bool> {
+ protected:
+  bool use_zygote() const { return GetParam(); }
+  std::string story() const { return use_zygote() ? "zygote" : "no_zygote"; }
+
+  // content::BrowserTestBase:
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    command_line->AppendSwitch(switches::kSitePerProcess);
+    // Unsandboxed renderers let the test read their mappings.
+    command_line->AppendSwitch(sandbox::policy::switches::kNoSandbox);
+    if (!use_zygote()) {
+      command_line->AppendSwitch(switches::kNoZygote);
+    }
+  }
+};
+
+// Reports the time to launch kRendererCount renderers, the time they spend
+// initializing the ResourceBundle, and the memory of their pak mappings.
+IN_PROC_BROWSER_TEST_P(ResourcePakPerfTest, Renderers) {
+  host_resolver()->AddRule("*", "127.0.0.1");
+  embedded_test_server()->RegisterRequestHandler(
+      base::BindRepeating(&HandleRequest));
+  ASSERT_TRUE(embedded_test_server()->Start());
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kRendererCount; ++i) {
+    content::WebContents* web_contents = browser()->CreateWebContents();
+    ASSERT_TRUE(content::NavigateToURL(
+        web_contents, embedded_test_server()->GetURL(
+                          base::StringPrintf("site%d.test", i), "/")));
+  }
+  radium_perf::ReportResult("RendererLaunch", story(),
+                            (base::TimeTicks::Now() - start).InMillisecondsF(),
+                            "ms");
+
+  // Zygote children don't initialize the ResourceBundle themselves.
+  content::FetchHistogramsFromChildProcesses();
+  if (std::optional<double> init_time =
+          GetHistogramMean(kChildResourceBundleInitTimeHistogram)) {
+    radium_perf::ReportResult("ChildResourceBundleInit", story(), *init_time,
+                              "us");
+  }
+
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  MappedMemory memory;
+  ASSERT_TRUE(AddMappedMemory(base::GetCurrentProcId(), &memory));
+  int renderer_count = 0;
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    const base::Process& process = it.GetCurrentValue()->GetProcess();
+    if (process.IsValid() && AddMappedMemory(process.Pid(), &memory)) {
+      ++renderer_count;
+    }
+  }
+  EXPECT_GE(renderer_count, kRendererCount);
+  radium_perf::ReportResult("PakResidentSetSize", story(),
+                            static_cast<double>(memory.pak_rss_kb), "KB");
+  radium_perf::ReportResult("PakProportionalSetSize", story(),
+                            static_cast<double>(memory.pak_pss_kb), "KB");
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         ResourcePakPerfTest,
+                         testing::Bool(),
+                         [](const testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Zygote" : "NoZygote";
+                         });
+
+// Starts the browser with the 2x pak deferred or loaded at startup, on the 1x
+// headless display.
+class HighDpiResourcePakPerfTest : public RadiumBrowserTest,
+                                   public testing::WithParamInterface<bool> {
+ protected:
+  bool deferred() const { return GetParam(); }
+  std::string story() const { return deferred() ? "deferred" : "eager"; }
+
+  // content::BrowserTestBase:
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    command_line->AppendSwitchASCII(deferred() ? switches::kEnableFeatures
+                                               : switches::kDisableFeatures,
+                                    features::kDeferHighDpiResourcePak.name);
+  }
+};
+
+// Reports the time the browser spends loading the ResourceBundle at startup,
+// and its memory once the first window is shown.
+IN_PROC_BROWSER_TEST_P(HighDpiResourcePakPerfTest, Startup) {
+  EXPECT_NE(deferred(), IsHighDpiResourcePakLoaded());
+  if (std::optional<double> init_time =
+          GetHistogramMean(kBrowserResourceBundleInitTimeHistogram)) {
+    radium_perf::ReportResult("BrowserResourceBundleInit", story(), *init_time,
+                              "us");
+  }
+
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  MappedMemory memory;
+  ASSERT_TRUE(AddMappedMemory(base::GetCurrentProcId(), &memory));
+  radium_perf::ReportResult("BrowserResidentSetSize", story(),
+                            static_cast<double>(memory.rss_kb), "KB");
+  radium_perf::ReportResult("BrowserPakResidentSetSize", story(),
+                            static_cast<double>(memory.pak_rss_kb), "KB");
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         HighDpiResourcePakPerfTest,
+                         testing::Bool(),
+                         [](const testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Deferred" : "Eager";
+                         });
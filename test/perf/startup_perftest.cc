@@ -0,0 +1,150 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/process/process.h"
+#include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/run_until.h"
+#include "base/test/test_future.h"
+#include "base/test/test_timeouts.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "components/startup_metric_utils/common/startup_metric_utils.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/browser_process.h"
+#include "radium/browser/global_features.h"
+#include "radium/browser/metrics/startup_milestones.h"
+#include "radium/browser/process_singleton.h"
+#include "radium/browser/profiles/profile_manager.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/browser_list.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kStory[] = "cold_start";
+
+class TestProcessSingleton : public ProcessSingleton {
+ public:
+  using ProcessSingleton::NotifyOtherProcessWithTimeout;
+  using ProcessSingleton::ProcessSingleton;
+};
+
+}  // namespace
+
+using StartupPerfTest = RadiumBrowserTest;
+
+// Reports the time from the browser's entry point to each startup milestone,
+// which includes PreMainMessageLoopRun and the first gallery window being
+// shown. The sign-in window that comes before it for users is skipped.
+IN_PROC_BROWSER_TEST_F(StartupPerfTest, Milestones) {
+  const base::TimeTicks main_entry =
+      startup_metric_utils::GetCommon().MainEntryPointTicks();
+  ASSERT_FALSE(main_entry.is_null());
+
+  // The process creation time is only available as wall clock time.
+  const base::Time creation_time = base::Process::Current().CreationTime();
+  if (!creation_time.is_null()) {
+    const base::TimeDelta since_creation = base::Time::Now() - creation_time;
+    const base::TimeDelta since_main_entry =
+        base::TimeTicks::Now() - main_entry;
+    radium_perf::ReportResult(
+        "ProcessCreationToMainEntry", kStory,
+        (since_creation - since_main_entry).InMillisecondsF(), "ms");
+  }
+
+  bool first_window_shown = false;
+  for (const startup_milestones::Milestone& milestone :
+       startup_milestones::Get()) {
+    radium_perf::ReportResult("MainEntryTo" + milestone.name, kStory,
+                              (milestone.time - main_entry).InMillisecondsF(),
+                              "ms");
+    first_window_shown |= milestone.name == "FirstWindowShown";
+  }
+  EXPECT_TRUE(first_window_shown);
+}
+
+// Reports the time from closing the last window to the browser's main
+// function returning.
+class ShutdownPerfTest : public RadiumBrowserTest {
+ public:
+  void SetUp() override {
+    RadiumBrowserTest::SetUp();
+    // The browser has shut down by the time SetUp() returns.
+    ASSERT_FALSE(shutdown_start_.is_null());
+    radium_perf::ReportResult(
+        "Shutdown", kStory,
+        (base::TimeTicks::Now() - shutdown_start_).InMillisecondsF(), "ms");
+  }
+
+  void PostRunTestOnMainThread() override {
+    shutdown_start_ = base::TimeTicks::Now();
+    RadiumBrowserTest::PostRunTestOnMainThread();
+  }
+
+ private:
+  base::TimeTicks shutdown_start_;
+};
+
+IN_PROC_BROWSER_TEST_F(ShutdownPerfTest, CloseAllWindows) {}
+
+using RelaunchPerfTest = RadiumBrowserTest;
+
+// Reports the time from a second instance connecting to the ProcessSingleton
+// socket of the running browser to the window for its command line being
+// shown. The second instance runs on its own thread, as it blocks until the
+// browser acknowledges the message. The first relaunch opens a window for its
+// URL, the following ones find it.
+IN_PROC_BROWSER_TEST_F(RelaunchPerfTest, OpenURL) {
+  constexpr int kRelaunchCount = 20;
+  constexpr char kHistogram[] = "Radium.ProcessSingleton.RelaunchToWindow";
+  const GURL url(radium::kRadiumUIExampleURL);
+  base::CommandLine cmd_line(base::FilePath(FILE_PATH_LITERAL("radium")));
+  cmd_line.AppendArg(url.spec());
+  base::HistogramTester histogram_tester;
+
+  TestProcessSingleton relauncher(
+      BrowserProcess::Get()->GetFeatures()->profile_manager()->user_data_dir(),
+      ProcessSingleton::NotificationCallback());
+  base::Thread relauncher_thread("Relauncher");
+  ASSERT_TRUE(relauncher_thread.Start());
+
+  for (int i = 0; i < kRelaunchCount; ++i) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    base::test::TestFuture<ProcessSingleton::NotifyResult> notify_result;
+    relauncher_thread.task_runner()->PostTaskAndReplyWithResult(
+        FROM_HERE, base::BindLambdaForTesting([&] {
+          return relauncher.NotifyOtherProcessWithTimeout(
+              cmd_line, /*retry_attempts=*/1, TestTimeouts::action_timeout(),
+              /*kill_unresponsive=*/false);
+        }),
+        notify_result.GetCallback());
+    ASSERT_EQ(ProcessSingleton::PROCESS_NOTIFIED, notify_result.Get());
+
+    // The browser acknowledges the message before it handles the command
+    // line, which records the histogram once the window is shown.
+    ASSERT_TRUE(base::test::RunUntil([&] {
+      return histogram_tester.GetHistogramSamplesSinceCreation(kHistogram)
+                 ->TotalCount() == i + 1;
+    }));
+    radium_perf::ReportResult(
+        "RelaunchToWindow", i == 0 ? "new_window" : "existing_window",
+        (base::TimeTicks::Now() - start).InMillisecondsF(), "ms");
+  }
+  relauncher_thread.Stop();
+
+  // Only the first relaunch opened a window, next to the one of startup.
+  ASSERT_EQ(2u, BrowserList::GetInstance()->size());
+  Browser* browser = *BrowserList::GetInstance()->rbegin();
+  ASSERT_EQ(1u, browser->tabs().size());
+  EXPECT_EQ(url, browser->tabs().begin()->get()->GetVisibleURL());
+}
@@ -0,0 +1,148 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "base/compiler_specific.h"
+#include "base/functional/callback_helpers.h"
+#include "base/profiler/module_cache.h"
+#include "base/profiler/stack_sampling_profiler.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "radium/common/profiler/call_tree.h"
+#include "radium/common/profiler/thread_profiler.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr base::TimeDelta kCollectionDuration = base::Milliseconds(500);
+
+// Keeps the thread busy for |duration|, the way a long task would.
+NOINLINE uint64_t BusyLoop(base::TimeDelta duration) {
+  uint64_t result = 0;
+  const base::TimeTicks end = base::TimeTicks::Now() + duration;
+  while (base::TimeTicks::Now() < end) {
+    for (int i = 0; i < 1000; ++i) {
+      result = result * 6364136223846793005u + 1442695040888963407u;
+    }
+  }
+  return result;
+}
+
+// Runs a fixed amount of work and returns how long it took.
+NOINLINE base::TimeDelta RunFixedWork() {
+  const base::TimeTicks start = base::TimeTicks::Now();
+  uint64_t result = 0;
+  for (int i = 0; i < 200'000'000; ++i) {
+    result = result * 6364136223846793005u + 1442695040888963407u;
+  }
+  // Keeps the loop from being optimized away.
+  EXPECT_NE(0u, result);
+  return base::TimeTicks::Now() - start;
+}
+
+class ThreadProfilerPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (!base::StackSamplingProfiler::IsSupportedForCurrentPlatform()) {
+      GTEST_SKIP() << "Stack sampling is not supported on this platform";
+    }
+  }
+
+  // Samples the current thread every |sampling_interval| while |work| runs,
+  // and returns the collection.
+  CallTree CollectWhileRunning(base::TimeDelta sampling_interval,
+                               base::OnceClosure work) {
+    std::optional<CallTree> call_tree;
+    base::RunLoop run_loop;
+    ThreadProfiler profiler(
+        "Test",
+        {.sampling_interval = sampling_interval,
+         .collection_duration = kCollectionDuration,
+         .collection_period = base::Days(1)},
+        base::BindLambdaForTesting([&](CallTree collected) {
+          call_tree = std::move(collected);
+          run_loop.Quit();
+        }));
+    profiler.Start();
+    std::move(work).Run();
+    run_loop.Run();
+    return std::move(*call_tree);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+};
+
+// Profiles a busy loop and checks that the samples are attributed to it.
+TEST_F(ThreadProfilerPerfTest, BusyLoop) {
+  // The sampling thread starts the collection some time after Start(). The
+  // loop runs for twice the collection so that the collection ends before it
+  // does, unless its start is delayed by more than the collection itself.
+  CallTree call_tree = CollectWhileRunning(
+      base::Milliseconds(10), base::BindLambdaForTesting([] {
+        EXPECT_NE(0u, BusyLoop(2 * kCollectionDuration));
+      }));
+  ASSERT_GT(call_tree.sample_count(), 0u);
+
+  base::ModuleCache module_cache;
+  const uintptr_t busy_loop_address = reinterpret_cast<uintptr_t>(&BusyLoop);
+  const base::ModuleCache::Module* module =
+      module_cache.GetModuleForAddress(busy_loop_address);
+  ASSERT_TRUE(module);
+  const uint64_t busy_loop_offset =
+      busy_loop_address - module->GetBaseAddress();
+
+  // Return addresses in BusyLoop() are a little after its start.
+  constexpr uint64_t kMaxFunctionSize = 512;
+  uint32_t busy_loop_samples = 0;
+  for (const CallTree::Node& node : call_tree.nodes()) {
+    if (node.module != CallTree::kUnknownModule &&
+        call_tree.modules()[node.module].id == module->GetId() &&
+        node.offset >= busy_loop_offset &&
+        node.offset < busy_loop_offset + kMaxFunctionSize) {
+      busy_loop_samples += node.total_count;
+    }
+  }
+  // The loop runs for the whole collection. Only the first samples may be
+  // taken before it starts.
+  EXPECT_GE(busy_loop_samples * 10, call_tree.sample_count() * 8);
+
+  radium_perf::ReportResult("ThreadProfilerSamples", "busy_loop",
+                            call_tree.sample_count(), "count");
+  radium_perf::ReportResult("ThreadProfilerCallTreeNodes", "busy_loop",
+                            call_tree.nodes().size(), "count");
+  radium_perf::ReportResult("ThreadProfilerSerializedSize", "busy_loop",
+                            call_tree.Serialize().size(), "bytes");
+}
+
+// Reports how much slower a thread runs while it is sampled at the default
+// rate and at a high rate.
+TEST_F(ThreadProfilerPerfTest, Overhead) {
+  const base::TimeDelta baseline = RunFixedWork();
+
+  for (const base::TimeDelta sampling_interval :
+       {base::Milliseconds(100), base::Milliseconds(1)}) {
+    // The collection outlasts the work, and is stopped when the profiler is
+    // destroyed.
+    ThreadProfiler profiler("Test",
+                            {.sampling_interval = sampling_interval,
+                             .collection_duration = base::Minutes(1),
+                             .collection_period = base::Days(1)},
+                            base::DoNothing());
+    profiler.Start();
+    const base::TimeDelta profiled = RunFixedWork();
+    radium_perf::ReportResult(
+        "ThreadProfilerOverhead",
+        sampling_interval == base::Milliseconds(1) ? "1ms_interval"
+                                                   : "100ms_interval",
+        (profiled - baseline) * 100 / baseline, "%");
+  }
+}
+
+}  // namespace
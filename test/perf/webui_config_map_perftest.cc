@@ -0,0 +1,116 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "content/public/browser/web_ui_controller.h"
+#include "content/public/test/browser_test.h"
+#include "radium/browser/profiles/profile.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/webui/radium_webui_config.h"
+#include "radium/browser/ui/webui/radium_webui_config_map.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/url_constants.h"
+
+namespace {
+
+constexpr int kLookupCount = 1000000;
+// Configs registered while measuring, like a browser with hundreds of
+// internal WebUIs.
+constexpr size_t kConfigCount = 200;
+
+class FillerUI : public content::WebUIController {
+ public:
+  explicit FillerUI(content::WebUI* web_ui) : WebUIController(web_ui) {}
+
+  static std::string GetWebUIName() { return "Filler"; }
+};
+
+class FillerUIConfig : public DefaultRadiumWebUIConfig<FillerUI> {
+ public:
+  explicit FillerUIConfig(const std::string& host)
+      : DefaultRadiumWebUIConfig(radium::kRadiumUIScheme, host) {}
+};
+
+struct ConfigLookup {
+  const char* story;
+  const char* url;
+  bool has_config;
+};
+
+}  // namespace
+
+class WebUIConfigMapPerfTest
+    : public RadiumBrowserTest,
+      public testing::WithParamInterface<ConfigLookup> {
+ protected:
+  // Registers filler configs until the map holds kConfigCount of them.
+  void SetUpOnMainThread() override {
+    RadiumBrowserTest::SetUpOnMainThread();
+    RadiumWebUIConfigMap& config_map = RadiumWebUIConfigMap::GetInstance();
+    const size_t registered_count =
+        config_map.GetWebUIConfigList(nullptr).size();
+    for (size_t i = registered_count; i < kConfigCount; ++i) {
+      const std::string host =
+          base::StrCat({"perf-filler-", base::NumberToString(i)});
+      config_map.AddWebUIConfig(std::make_unique<FillerUIConfig>(host));
+      filler_urls_.emplace_back(base::StrCat(
+          {radium::kRadiumUIScheme, url::kStandardSchemeSeparator, host}));
+    }
+    ASSERT_EQ(kConfigCount, config_map.GetWebUIConfigList(nullptr).size());
+  }
+
+  void TearDownOnMainThread() override {
+    for (const GURL& url : filler_urls_) {
+      RadiumWebUIConfigMap::GetInstance().RemoveConfig(url);
+    }
+    RadiumBrowserTest::TearDownOnMainThread();
+  }
+
+ private:
+  std::vector<GURL> filler_urls_;
+};
+
+// Reports the time RadiumWebUIConfigMap::GetConfig() takes for one URL, with
+// kConfigCount configs registered. The WebUI infrastructure does three of
+// these for every navigation.
+IN_PROC_BROWSER_TEST_P(WebUIConfigMapPerfTest, GetConfig) {
+  RadiumWebUIConfigMap& config_map = RadiumWebUIConfigMap::GetInstance();
+  Profile* profile = browser()->profile();
+  const GURL url(GetParam().url);
+  ASSERT_EQ(GetParam().has_config, !!config_map.GetConfig(profile, url));
+
+  int found = 0;
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kLookupCount; ++i) {
+    found += !!config_map.GetConfig(profile, url);
+  }
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  EXPECT_EQ(GetParam().has_config ? kLookupCount : 0, found);
+  radium_perf::ReportResult("WebUIConfigLookup", GetParam().story,
+                            elapsed.InNanosecondsF() / kLookupCount, "ns");
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    WebUIConfigMapPerfTest,
+    testing::Values(
+        ConfigLookup{"root", "radium://webui-gallery/", true},
+        ConfigLookup{"sub_page", "radium://webui-gallery/path/to?query",
+                     true},
+        ConfigLookup{"unknown_host", "radium://unknown/", false},
+        ConfigLookup{"other_scheme", "https://webui-gallery/", false}),
+    [](const testing::TestParamInfo<ConfigLookup>& info) {
+      return std::string(info.param.story);
+    });
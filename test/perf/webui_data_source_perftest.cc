@@ -0,0 +1,99 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/time/time.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_ui_controller.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/test_web_ui.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/browser/ui/webui/example/example_ui.h"
+#include "radium/browser/ui/webui/histograms/histograms_ui.h"
+#include "radium/browser/ui/webui/webui_data_source_registry.h"
+#include "radium/browser/ui/webui/webui_data_source_registry_factory.h"
+#include "radium/browser/ui/webui/webui_gallery/webui_gallery_ui.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kControllerCount = 1000;
+
+struct WebUIControllerType {
+  const char* story;
+  std::unique_ptr<content::WebUIController> (*create)(content::WebUI* web_ui);
+};
+
+template <typename Controller>
+std::unique_ptr<content::WebUIController> CreateController(
+    content::WebUI* web_ui) {
+  return std::make_unique<Controller>(web_ui);
+}
+
+}  // namespace
+
+class WebUIDataSourcePerfTest
+    : public RadiumBrowserTest,
+      public testing::WithParamInterface<WebUIControllerType> {
+ protected:
+  // Creates and destroys kControllerCount controllers, and reports the time
+  // per controller and the URLDataManager updates they made. Without
+  // |cached|, the registry is invalidated before each controller, the way
+  // every controller built its data sources before.
+  void CreateControllers(bool cached) {
+    content::WebContents* web_contents = browser()->CreateWebContents();
+    content::TestWebUI web_ui;
+    web_ui.set_web_contents(web_contents);
+
+    WebUIDataSourceRegistry* registry =
+        WebUIDataSourceRegistryFactory::GetForProfile(browser()->profile());
+    ASSERT_TRUE(registry);
+    registry->Invalidate();
+    const size_t initial_run_count = registry->recipe_run_count();
+
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kControllerCount; ++i) {
+      if (!cached) {
+        registry->Invalidate();
+      }
+      GetParam().create(&web_ui);
+    }
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    const size_t updates = registry->recipe_run_count() - initial_run_count;
+    EXPECT_EQ(cached ? 1u : static_cast<size_t>(kControllerCount), updates);
+    const std::string story =
+        std::string(GetParam().story) + (cached ? "_cached" : "_uncached");
+    radium_perf::ReportResult("WebUIControllerCreation", story,
+                              elapsed.InMicrosecondsF() / kControllerCount,
+                              "us");
+    radium_perf::ReportResult("URLDataManagerUpdates", story,
+                              static_cast<double>(updates), "count");
+  }
+};
+
+IN_PROC_BROWSER_TEST_P(WebUIDataSourcePerfTest, Cached) {
+  CreateControllers(/*cached=*/true);
+}
+
+IN_PROC_BROWSER_TEST_P(WebUIDataSourcePerfTest, Uncached) {
+  CreateControllers(/*cached=*/false);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    WebUIDataSourcePerfTest,
+    testing::Values(
+        WebUIControllerType{"gallery", &CreateController<WebuiGalleryUI>},
+        WebUIControllerType{"example", &CreateController<ExampleUI>},
+        WebUIControllerType{"histograms", &CreateController<HistogramsUI>}),
+    [](const testing::TestParamInfo<WebUIControllerType>& info) {
+      return std::string(info.param.story);
+    });
@@ -0,0 +1,185 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "base/base_switches.h"
+#include "base/command_line.h"
+#include "base/containers/contains.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "radium/browser/ui/browser.h"
+#include "radium/common/radium_features.h"
+#include "radium/common/webui_url_constants.h"
+#include "radium/test/base/radium_browser_test.h"
+#include "radium/test/perf/perf_results.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+struct WebUIPage {
+  const char* story;
+  const char* url;
+};
+
+// Resolves with the time from the start of the navigation to the first
+// contentful paint, once there has been one.
+constexpr char kFirstContentfulPaintScript[] = R"(
+  new Promise(resolve => {
+    new PerformanceObserver(list => {
+      for (const entry of list.getEntries()) {
+        if (entry.name === 'first-contentful-paint') {
+          resolve(entry.startTime);
+        }
+      }
+    }).observe({type: 'paint', buffered: true});
+  });
+)";
+
+// Returns the time V8 spent compiling in all processes so far, as recorded by
+// its V8.Compile*MicroSeconds* histograms.
+base::TimeDelta GetV8CompileTime() {
+  content::FetchHistogramsFromChildProcesses();
+  int64_t microseconds = 0;
+  for (base::HistogramBase* histogram :
+       base::StatisticsRecorder::GetHistograms()) {
+    std::string_view name = histogram->histogram_name();
+    if (base::StartsWith(name, "V8.Compile") &&
+        base::Contains(name, "MicroSeconds")) {
+      microseconds += histogram->SnapshotSamples()->sum();
+    }
+  }
+  return base::Microseconds(microseconds);
+}
+
+// Returns how many samples the histogram |name| has in all processes so far.
+base::HistogramBase::Count GetHistogramCount(const char* name) {
+  content::FetchHistogramsFromChildProcesses();
+  base::HistogramBase* histogram =
+      base::StatisticsRecorder::FindHistogram(name);
+  return histogram ? histogram->SnapshotSamples()->TotalCount() : 0;
+}
+
+// V8 records one sample each time it deserializes a code cache, and one each
+// time it rejects a code cache, e.g. because its flags or version differ from
+// the ones the cache was produced with.
+constexpr char kCodeCacheConsumedHistogram[] =
+    "V8.CompileDeserializeMicroSeconds";
+constexpr char kCodeCacheRejectedHistogram[] = "V8.CodeCacheRejectReason";
+
+}  // namespace
+
+class WebUIPerfTest : public RadiumBrowserTest,
+                      public testing::WithParamInterface<WebUIPage> {
+ protected:
+  content::WebContents* GetWebContents() {
+    if (browser()->tabs().empty()) {
+      return browser()->CreateWebContents();
+    }
+    return browser()->tabs().begin()->get();
+  }
+};
+
+// Reports the first contentful paint of a WebUI loaded in a new renderer.
+IN_PROC_BROWSER_TEST_P(WebUIPerfTest, FirstContentfulPaint) {
+  content::WebContents* web_contents = GetWebContents();
+  ASSERT_TRUE(content::NavigateToURL(web_contents, GURL(GetParam().url)));
+
+  content::EvalJsResult result =
+      content::EvalJs(web_contents, kFirstContentfulPaintScript);
+  ASSERT_TRUE(result.error.empty()) << result.error;
+  radium_perf::ReportResult("WebUIFirstContentfulPaint", GetParam().story,
+                            result.ExtractDouble(), "ms");
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    WebUIPerfTest,
+    testing::Values(WebUIPage{"gallery", radium::kRadiumUIWebuiGalleryURL},
+                    WebUIPage{"example", radium::kRadiumUIExampleURL}),
+    [](const testing::TestParamInfo<WebUIPage>& info) {
+      return std::string(info.param.story);
+    });
+
+// Loads a WebUI with and without the code cache generated at build time.
+class WebUICodeCachePerfTest
+    : public RadiumBrowserTest,
+      public testing::WithParamInterface<std::tuple<WebUIPage, bool>> {
+ protected:
+  const WebUIPage& page() const { return std::get<0>(GetParam()); }
+  bool code_cache() const { return std::get<1>(GetParam()); }
+  std::string story() const {
+    return base::StrCat(
+        {page().story, code_cache() ? "_code_cache" : "_no_code_cache"});
+  }
+
+  // content::BrowserTestBase:
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    command_line->AppendSwitchASCII(code_cache() ? switches::kEnableFeatures
+                                                 : switches::kDisableFeatures,
+                                    features::kWebUICodeCache.name);
+  }
+};
+
+// Reports the first contentful paint of a WebUI loaded in a new renderer, and
+// the time V8 spent compiling for it. With the code cache, also checks that
+// the renderer consumed it rather than compiling the modules again.
+IN_PROC_BROWSER_TEST_P(WebUICodeCachePerfTest, FirstLoad) {
+  // The startup window already shows the gallery. A new WebContents is in a
+  // new browsing instance, so the page loads in a renderer that has not
+  // compiled its modules yet.
+  std::unique_ptr<content::WebContents> web_contents =
+      content::WebContents::Create(
+          content::WebContents::CreateParams(browser()->profile()));
+  const base::TimeDelta compile_time_before = GetV8CompileTime();
+  const base::HistogramBase::Count consumed_before =
+      GetHistogramCount(kCodeCacheConsumedHistogram);
+  const base::HistogramBase::Count rejected_before =
+      GetHistogramCount(kCodeCacheRejectedHistogram);
+  ASSERT_TRUE(content::NavigateToURL(web_contents.get(), GURL(page().url)));
+
+  content::EvalJsResult result =
+      content::EvalJs(web_contents.get(), kFirstContentfulPaintScript);
+  ASSERT_TRUE(result.error.empty()) << result.error;
+  radium_perf::ReportResult("WebUIFirstContentfulPaint", story(),
+                            result.ExtractDouble(), "ms");
+  radium_perf::ReportResult(
+      "WebUICompileTime", story(),
+      (GetV8CompileTime() - compile_time_before).InMillisecondsF(), "ms");
+
+  if (code_cache()) {
+    // The cache is produced at build time by a V8 set up outside of the
+    // renderer, so a difference in flags would have V8 reject it silently.
+    EXPECT_GT(GetHistogramCount(kCodeCacheConsumedHistogram), consumed_before);
+    EXPECT_EQ(rejected_before, GetHistogramCount(kCodeCacheRejectedHistogram));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    WebUICodeCachePerfTest,
+    testing::Combine(
+        testing::Values(
+            WebUIPage{"gallery", radium::kRadiumUIWebuiGalleryURL},
+            WebUIPage{"example", radium::kRadiumUIExampleURL},
+            WebUIPage{"histograms", radium::kRadiumUIHistogramsURL}),
+        testing::Bool()),
+    [](const testing::TestParamInfo<std::tuple<WebUIPage, bool>>& info) {
+      return base::StrCat({std::get<0>(info.param).story,
+                           std::get<1>(info.param) ? "_CodeCache"
+                                                   : "_NoCodeCache"});
+    });
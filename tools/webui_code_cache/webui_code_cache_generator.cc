@@ -0,0 +1,151 @@
+// Copyright 2024 The Radium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compiles JavaScript modules eagerly and writes out their V8 code cache, so
+// that WebUIs don't have to compile them from scratch on their first load.
+//
+// Usage: webui_code_cache_generator --in-folder=<dir> --out-folder=<dir>
+//            --out-manifest=<file> <module>...
+//
+// The code cache of <in-folder>/<module> is written to <out-folder>/<module>.
+// The manifest lists them in the format expected by generate_grd().
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/i18n/icu_util.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/task/single_thread_task_executor.h"
+#include "base/values.h"
+#include "gin/array_buffer.h"
+#include "gin/public/isolate_holder.h"
+#include "gin/v8_initializer.h"
+#include "v8/include/v8.h"
+
+namespace {
+
+constexpr char kInFolderSwitch[] = "in-folder";
+constexpr char kOutFolderSwitch[] = "out-folder";
+constexpr char kOutManifestSwitch[] = "out-manifest";
+
+// Returns the code cache of |code| compiled as a module, or nullopt if it
+// does not compile.
+std::optional<std::string> CreateModuleCodeCache(v8::Isolate* isolate,
+                                                 const std::string& name,
+                                                 const std::string& code) {
+  v8::Local<v8::String> source_string;
+  v8::Local<v8::String> name_string;
+  if (!v8::String::NewFromUtf8(isolate, code.data(),
+                               v8::NewStringType::kNormal, code.size())
+           .ToLocal(&source_string) ||
+      !v8::String::NewFromUtf8(isolate, name.c_str()).ToLocal(&name_string)) {
+    return std::nullopt;
+  }
+
+  v8::ScriptOrigin origin(name_string, /*resource_line_offset=*/0,
+                          /*resource_column_offset=*/0,
+                          /*resource_is_shared_cross_origin=*/false,
+                          /*script_id=*/-1,
+                          /*source_map_url=*/v8::Local<v8::Value>(),
+                          /*resource_is_opaque=*/false, /*is_wasm=*/false,
+                          /*is_module=*/true);
+  v8::ScriptCompiler::Source source(source_string, origin);
+  v8::TryCatch try_catch(isolate);
+  v8::Local<v8::Module> module;
+  // Eager compilation puts every function in the cache, not only the ones
+  // that run when the module is evaluated.
+  if (!v8::ScriptCompiler::CompileModule(isolate, &source,
+                                         v8::ScriptCompiler::kEagerCompile)
+           .ToLocal(&module)) {
+    v8::String::Utf8Value message(isolate, try_catch.Message()->Get());
+    LOG(ERROR) << name << ": " << *message;
+    return std::nullopt;
+  }
+
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cache(
+      v8::ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+  return std::string(reinterpret_cast<const char*>(cache->data),
+                     cache->length);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  const base::FilePath in_folder =
+      command_line.GetSwitchValuePath(kInFolderSwitch);
+  const base::FilePath out_folder =
+      command_line.GetSwitchValuePath(kOutFolderSwitch);
+  const base::FilePath out_manifest =
+      command_line.GetSwitchValuePath(kOutManifestSwitch);
+  if (in_folder.empty() || out_folder.empty() || out_manifest.empty()) {
+    LOG(ERROR) << "Usage: " << argv[0] << " --" << kInFolderSwitch
+               << "=<dir> --" << kOutFolderSwitch << "=<dir> --"
+               << kOutManifestSwitch << "=<file> <module>...";
+    return 1;
+  }
+
+  // Initialize V8 through gin as the renderer does, with an isolate of the
+  // renderer main thread. The cache is tagged with a hash of the V8 flags,
+  // and V8 rejects it if the renderer runs with other flags, e.g. from
+  // --js-flags. WebUICodeCachePerfTest checks that the cache is consumed.
+  base::FeatureList::InitInstance(std::string(), std::string());
+  base::SingleThreadTaskExecutor task_executor;
+  CHECK(base::i18n::InitializeICU());
+  gin::V8Initializer::LoadV8Snapshot();
+  gin::IsolateHolder::Initialize(gin::IsolateHolder::kStrictMode,
+                                 gin::ArrayBufferAllocator::SharedInstance());
+  gin::IsolateHolder isolate_holder(
+      task_executor.task_runner(),
+      gin::IsolateHolder::IsolateType::kBlinkMainThread);
+  v8::Isolate* isolate = isolate_holder.isolate();
+  v8::Isolate::Scope isolate_scope(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  base::Value::List files;
+  for (const base::CommandLine::StringType& file : command_line.GetArgs()) {
+    const base::FilePath relative_path(file);
+    std::string code;
+    if (!base::ReadFileToString(in_folder.Append(relative_path), &code)) {
+      LOG(ERROR) << "Failed to read " << relative_path;
+      return 1;
+    }
+    std::optional<std::string> cache = CreateModuleCodeCache(
+        isolate, relative_path.AsUTF8Unsafe(), code);
+    if (!cache) {
+      return 1;
+    }
+    const base::FilePath out_path = out_folder.Append(relative_path);
+    if (!base::CreateDirectory(out_path.DirName()) ||
+        !base::WriteFile(out_path, *cache)) {
+      LOG(ERROR) << "Failed to write " << out_path;
+      return 1;
+    }
+    files.Append(relative_path.AsUTF8Unsafe());
+  }
+
+  base::Value::Dict manifest;
+  manifest.Set("base_dir", out_folder.AsUTF8Unsafe());
+  manifest.Set("files", std::move(files));
+  std::optional<std::string> json = base::WriteJson(manifest);
+  if (!json || !base::WriteFile(out_manifest, *json)) {
+    LOG(ERROR) << "Failed to write " << out_manifest;
+    return 1;
+  }
+  return 0;
+}